@@ -0,0 +1,648 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include <simdparse/base64url.hpp>
+#include <simdparse/datetime.hpp>
+#include <simdparse/decimal.hpp>
+#include <simdparse/dispatch.hpp>
+#include <simdparse/epoch.hpp>
+#include <simdparse/floating_point.hpp>
+#include <simdparse/format.hpp>
+#include <simdparse/hexadecimal.hpp>
+#include <simdparse/http_date.hpp>
+#include <simdparse/ipaddr.hpp>
+#include <simdparse/uuid.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SIMDPARSE_BENCH_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define SIMDPARSE_BENCH_RDTSC
+#endif
+
+/**
+ * Throughput benchmarks with generated corpora.
+ *
+ * Each workload is a list of strings of the same shape (e.g. decimal integers of the same length), generated with
+ * a fixed seed such that runs are reproducible. Workloads are parsed with every instruction set path available on
+ * the processor (selected with `dispatch_features()`), and with a baseline from the standard library where one
+ * exists. Pass a substring as the first argument to run only matching workloads.
+ */
+
+namespace
+{
+    using namespace simdparse;
+
+    /** Minimum duration of a measurement. */
+    constexpr std::chrono::milliseconds min_duration(200);
+
+    /** Number of strings in each workload (except for long base64url blobs). */
+    constexpr std::size_t item_count = 10'000;
+
+    struct workload
+    {
+        std::string type;
+        std::string shape;
+        std::vector<std::string> items;
+
+        std::size_t bytes() const
+        {
+            std::size_t n = 0;
+            for (const std::string& item : items) {
+                n += item.size();
+            }
+            return n;
+        }
+    };
+
+    struct measurement
+    {
+        double seconds = 0;
+        double cycles = 0;
+        std::size_t repetitions = 0;
+    };
+
+    /** Prevents the compiler from discarding the result of a parse. */
+    volatile std::uint64_t sink;
+
+    std::uint64_t read_cycle_counter()
+    {
+#if defined(SIMDPARSE_BENCH_RDTSC)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /** Repeatedly invokes a function on all items of a workload until a minimum duration has elapsed. */
+    template<typename F>
+    measurement measure(const workload& w, F&& fn)
+    {
+        // warm up caches and branch predictors
+        std::uint64_t acc = 0;
+        for (const std::string& item : w.items) {
+            acc += fn(std::string_view(item));
+        }
+
+        measurement m;
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t start_cycles = read_cycle_counter();
+        std::chrono::steady_clock::duration elapsed;
+        do {
+            for (const std::string& item : w.items) {
+                acc += fn(std::string_view(item));
+            }
+            ++m.repetitions;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < min_duration);
+        m.cycles = static_cast<double>(read_cycle_counter() - start_cycles);
+        m.seconds = std::chrono::duration<double>(elapsed).count();
+        sink = acc;
+        return m;
+    }
+
+    void report(const workload& w, const char* path, const measurement& m)
+    {
+        const double items = static_cast<double>(w.items.size() * m.repetitions);
+        const double bytes = static_cast<double>(w.bytes() * m.repetitions);
+        std::printf("%-20s %-28s %-22s %9.3f GB/s %10.2f ns/item", w.type.c_str(), w.shape.c_str(), path, bytes / m.seconds / 1e9, m.seconds * 1e9 / items);
+#if defined(SIMDPARSE_BENCH_RDTSC)
+        std::printf(" %10.1f cycles/item", m.cycles / items);
+#endif
+        std::printf("\n");
+    }
+
+    /** An instruction set path selected by lowering the detected processor features. */
+    struct path
+    {
+        const char* name;
+        cpu_features features;
+    };
+
+    /** Instruction set paths that the processor supports, from the most capable to the portable implementation. */
+    std::vector<path> available_paths()
+    {
+        const cpu_features detected = cpu_features::detect();
+        cpu_features avx2 = detected;
+        avx2.avx512bw = avx2.avx512vl = avx2.avx512vbmi = false;
+
+        std::vector<path> paths;
+        std::vector<std::pair<bool, bool>> seen;
+        for (const cpu_features& features : { detected, avx2, cpu_features() }) {
+            dispatch_features() = features;
+
+            // skip paths that cannot be selected at run time, e.g. when compiled for a fixed target
+            const std::pair<bool, bool> selection(detail::use_avx512(), detail::use_simd());
+            if (std::find(seen.begin(), seen.end(), selection) != seen.end()) {
+                continue;
+            }
+            seen.push_back(selection);
+
+            const char* name = selection.first ? "avx512" : !selection.second ? "scalar" : detail::use_neon() ? "neon" : "avx2";
+            paths.push_back(path{ name, features });
+        }
+        dispatch_features() = detected;
+        return paths;
+    }
+
+    std::mt19937_64 rng(20240101);
+
+    std::string random_digits(std::size_t count)
+    {
+        std::string str;
+        for (std::size_t k = 0; k < count; ++k) {
+            str.push_back(static_cast<char>('0' + rng() % 10));
+        }
+        return str;
+    }
+
+    std::vector<workload> decimal_workloads()
+    {
+        std::vector<workload> workloads;
+        for (std::size_t len = 1; len <= 20; ++len) {
+            workload w{ "decimal_integer", std::to_string(len) + " digits", {} };
+            for (std::size_t k = 0; k < item_count; ++k) {
+                std::string str;
+                if (len == 20) {
+                    // the largest 64-bit integers, between 10^19 and 2^64 - 1
+                    str = std::to_string(10'000'000'000'000'000'000ull + rng() % 8'446'744'073'709'551'615ull);
+                } else {
+                    str = std::to_string(1 + rng() % 9) + random_digits(len - 1);
+                }
+                w.items.push_back(str);
+            }
+            workloads.push_back(std::move(w));
+        }
+        return workloads;
+    }
+
+    /** A date-time string with the given number of fractional digits and offset form, and a random separator if none given. */
+    std::string random_datetime(std::size_t fraction, const char* offset, char separator = 0)
+    {
+        char buf[64];
+        int n = std::snprintf(buf, sizeof(buf), "%04u-%02u-%02u%c%02u:%02u:%02u",
+            static_cast<unsigned>(1970 + rng() % 100), static_cast<unsigned>(1 + rng() % 12), static_cast<unsigned>(1 + rng() % 28),
+            separator ? separator : rng() % 2 ? 'T' : ' ', static_cast<unsigned>(rng() % 24), static_cast<unsigned>(rng() % 60), static_cast<unsigned>(rng() % 60));
+        std::string str(buf, n);
+        if (fraction > 0) {
+            str += "." + random_digits(fraction);
+        }
+        if (std::strcmp(offset, "+hh:mm") == 0) {
+            n = std::snprintf(buf, sizeof(buf), "%c%02u:%02u", rng() % 2 ? '+' : '-', static_cast<unsigned>(rng() % 15), static_cast<unsigned>(15 * (rng() % 4)));
+            str.append(buf, n);
+        } else {
+            str += offset;
+        }
+        return str;
+    }
+
+    std::vector<workload> datetime_workloads()
+    {
+        std::vector<workload> workloads;
+        const char* offsets[] = { "", "Z", "+hh:mm", " UTC" };
+        for (const char* offset : offsets) {
+            for (std::size_t fraction = 0; fraction <= 9; ++fraction) {
+                if (fraction == 0 || fraction == 3 || fraction == 6 || fraction == 9 || std::strcmp(offset, "Z") == 0) {
+                    workload w{ "datetime", "frac=" + std::to_string(fraction) + " tz=" + (*offset ? offset : "naive"), {} };
+                    for (std::size_t k = 0; k < item_count; ++k) {
+                        w.items.push_back(random_datetime(fraction, offset));
+                    }
+                    workloads.push_back(std::move(w));
+                }
+            }
+        }
+        return workloads;
+    }
+
+    /** Date-time strings in a single layout, parsed with and without the layout known at compile time. */
+    template<typename Format>
+    workload datetime_format_workload(const char* offset)
+    {
+        workload w{ "datetime", std::string("layout ") + Format::separator + " frac=" + std::to_string(Format::fractional_digits) + " tz=" + (*offset ? offset : "naive"), {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            w.items.push_back(random_datetime(Format::fractional_digits, offset, Format::separator));
+        }
+        return w;
+    }
+
+    std::vector<workload> http_date_workloads()
+    {
+        const char* weekdays[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+        const char* months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+        workload gmt{ "http_date", "GMT", {} };
+        workload offset{ "http_date", "+hhmm", {} };
+        workload clf{ "clf_datetime", "+hhmm", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            char buf[64];
+            const unsigned year = static_cast<unsigned>(1970 + rng() % 100);
+            const char* month = months[rng() % 12];
+            const unsigned day = static_cast<unsigned>(1 + rng() % 28);
+            const unsigned hour = static_cast<unsigned>(rng() % 24);
+            const unsigned minute = static_cast<unsigned>(rng() % 60);
+            const unsigned second = static_cast<unsigned>(rng() % 60);
+            const char sign = rng() % 2 ? '+' : '-';
+            const unsigned zone = static_cast<unsigned>(100 * (rng() % 15) + 15 * (rng() % 4));
+
+            int n = std::snprintf(buf, sizeof(buf), "%s, %02u %s %04u %02u:%02u:%02u GMT", weekdays[rng() % 7], day, month, year, hour, minute, second);
+            gmt.items.emplace_back(buf, n);
+            n = std::snprintf(buf, sizeof(buf), "%s, %02u %s %04u %02u:%02u:%02u %c%04u", weekdays[rng() % 7], day, month, year, hour, minute, second, sign, zone);
+            offset.items.emplace_back(buf, n);
+            n = std::snprintf(buf, sizeof(buf), "%02u/%s/%04u:%02u:%02u:%02u %c%04u", day, month, year, hour, minute, second, sign, zone);
+            clf.items.emplace_back(buf, n);
+        }
+        return { gmt, offset, clf };
+    }
+
+    std::vector<workload> epoch_workloads()
+    {
+        workload seconds{ "epoch_time", "seconds", {} };
+        workload milliseconds{ "epoch_time", "milliseconds", {} };
+        workload nanoseconds{ "epoch_time", "nanoseconds", {} };
+        workload fractional{ "epoch_time", "seconds.microseconds", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            // timestamps between 2001 and 2286, which have 10 digits in seconds
+            const std::uint64_t t = 1'000'000'000 + rng() % 9'000'000'000;
+            const std::uint64_t ns = rng() % 1'000'000'000;
+            seconds.items.push_back(std::to_string(t));
+            milliseconds.items.push_back(std::to_string(1'000 * t + ns / 1'000'000));
+            nanoseconds.items.push_back(std::to_string(1'000'000'000 * t + ns));
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%llu.%06llu", static_cast<unsigned long long>(t), static_cast<unsigned long long>(ns / 1'000));
+            fractional.items.push_back(buf);
+        }
+        return { seconds, milliseconds, nanoseconds, fractional };
+    }
+
+    std::vector<workload> decimal_number_workloads()
+    {
+        workload price{ "fixed_decimal<6>", "amount with 2 decimals", {} };
+        workload signed_amount{ "fixed_decimal<6>", "signed with 6 decimals", {} };
+        workload fixed{ "floating_point", "fixed notation", {} };
+        workload scientific{ "floating_point", "scientific notation", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            price.items.push_back(std::to_string(rng() % 100'000) + "." + random_digits(2));
+            signed_amount.items.push_back((rng() % 2 ? "-" : "") + std::to_string(rng() % 10'000) + "." + random_digits(6));
+            fixed.items.push_back(std::to_string(rng() % 1'000'000) + "." + random_digits(1 + rng() % 12));
+            char buf[32];
+            const int n = std::snprintf(buf, sizeof(buf), "%.*e", static_cast<int>(rng() % 17), std::ldexp(static_cast<double>(rng() % 1'000'000 + 1), static_cast<int>(rng() % 400) - 200));
+            scientific.items.emplace_back(buf, n);
+        }
+        return { price, signed_amount, fixed, scientific };
+    }
+
+    std::vector<workload> uuid_workloads()
+    {
+        workload rfc_4122{ "uuid", "8-4-4-4-12", {} };
+        workload braced{ "uuid", "{8-4-4-4-12}", {} };
+        workload compact{ "uuid", "32 hex digits", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            char buf[40];
+            const std::uint64_t hi = rng();
+            const std::uint64_t lo = rng();
+            std::snprintf(buf, sizeof(buf), "%08x-%04x-%04x-%04x-%012llx",
+                static_cast<unsigned>(hi >> 32), static_cast<unsigned>((hi >> 16) & 0xffff), static_cast<unsigned>(hi & 0xffff),
+                static_cast<unsigned>(lo >> 48), static_cast<unsigned long long>(lo & 0xffffffffffffull));
+            std::string str(buf);
+            rfc_4122.items.push_back(str);
+            braced.items.push_back("{" + str + "}");
+            str.erase(std::remove(str.begin(), str.end(), '-'), str.end());
+            compact.items.push_back(str);
+        }
+        return { rfc_4122, braced, compact };
+    }
+
+    std::vector<workload> hex_workloads()
+    {
+        workload trace_id{ "uint128", "32 hex digits", {} };
+        workload digest{ "hex", "SHA-256 digest", {} };
+        workload payload{ "hex", "10000 bytes", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            std::basic_string<std::byte> bytes(32, std::byte{});
+            for (std::byte& b : bytes) {
+                b = static_cast<std::byte>(rng());
+            }
+            digest.items.push_back(hex::encode(bytes));
+            trace_id.items.push_back(digest.items.back().substr(0, 32));
+        }
+        for (std::size_t k = 0; k < 100; ++k) {
+            std::basic_string<std::byte> bytes(10'000, std::byte{});
+            for (std::byte& b : bytes) {
+                b = static_cast<std::byte>(rng());
+            }
+            payload.items.push_back(hex::encode(bytes));
+        }
+        return { trace_id, digest, payload };
+    }
+
+    std::vector<workload> ip_workloads()
+    {
+        workload ipv4{ "ipv4_addr", "dotted quad", {} };
+        workload ipv6_full{ "ipv6_addr", "full", {} };
+        workload ipv6_compressed{ "ipv6_addr", "compressed", {} };
+        for (std::size_t k = 0; k < item_count; ++k) {
+            char buf[64];
+            const std::uint32_t v4 = static_cast<std::uint32_t>(rng());
+            std::snprintf(buf, sizeof(buf), "%u.%u.%u.%u", v4 >> 24, (v4 >> 16) & 0xff, (v4 >> 8) & 0xff, v4 & 0xff);
+            ipv4.items.push_back(buf);
+
+            std::uint16_t groups[8];
+            for (std::uint16_t& group : groups) {
+                group = static_cast<std::uint16_t>(rng());
+            }
+            std::snprintf(buf, sizeof(buf), "%x:%x:%x:%x:%x:%x:%x:%x", groups[0], groups[1], groups[2], groups[3], groups[4], groups[5], groups[6], groups[7]);
+            ipv6_full.items.push_back(buf);
+            std::snprintf(buf, sizeof(buf), "%x:%x::%x:%x", groups[0], groups[1], groups[6], groups[7]);
+            ipv6_compressed.items.push_back(buf);
+        }
+        return { ipv4, ipv6_full, ipv6_compressed };
+    }
+
+    std::vector<workload> base64url_workloads()
+    {
+        std::vector<workload> workloads;
+        for (std::size_t size : { 10, 1'000, 100'000, 10'000'000 }) {
+            workload w{ "base64url", std::to_string(size) + " bytes", {} };
+            const std::size_t count = std::max<std::size_t>(1, 10'000'000 / size / 10);
+            for (std::size_t k = 0; k < std::min(count, item_count); ++k) {
+                std::basic_string<std::byte> bytes(size, std::byte{});
+                for (std::byte& b : bytes) {
+                    b = static_cast<std::byte>(rng());
+                }
+                w.items.push_back(base64url::encode(bytes));
+            }
+            workloads.push_back(std::move(w));
+        }
+        return workloads;
+    }
+
+    /** Benchmarks a type with each available instruction set path. */
+    bool selected(const workload& w, const char* filter)
+    {
+        return filter == nullptr || (w.type + " " + w.shape).find(filter) != std::string::npos;
+    }
+
+    template<typename T>
+    void run_paths(const workload& w, const std::vector<path>& paths)
+    {
+        for (const path& p : paths) {
+            dispatch_features() = p.features;
+            const measurement m = measure(w, [](const std::string_view& str) -> std::uint64_t {
+                T obj;
+                return obj.parse(str);
+            });
+            report(w, p.name, m);
+        }
+    }
+
+    template<typename Format>
+    void run_datetime_format(const workload& w, const std::vector<path>& paths)
+    {
+        for (const path& p : paths) {
+            dispatch_features() = p.features;
+            const measurement m = measure(w, [](const std::string_view& str) -> std::uint64_t {
+                datetime obj;
+                return obj.parse(str, Format());
+            });
+            report(w, (std::string(p.name) + " (fixed layout)").c_str(), m);
+        }
+    }
+
+    /** Compares parsing a date-time string of unknown layout with parsing it in the layout known at compile time. */
+    template<typename Format>
+    void run_datetime_layout(const char* offset, const std::vector<path>& paths, const char* filter)
+    {
+        const workload w = datetime_format_workload<Format>(offset);
+        if (selected(w, filter)) {
+            run_paths<datetime>(w, paths);
+            run_datetime_format<Format>(w, paths);
+        }
+    }
+
+    void run_base64url(const workload& w, const std::vector<path>& paths)
+    {
+        std::basic_string<std::byte> bytes;
+        for (const path& p : paths) {
+            dispatch_features() = p.features;
+            const measurement m = measure(w, [&bytes](const std::string_view& str) -> std::uint64_t {
+                return base64url::decode(str, bytes);
+            });
+            report(w, p.name, m);
+        }
+    }
+
+    void run_hex(const workload& w, const std::vector<path>& paths)
+    {
+        std::basic_string<std::byte> bytes;
+        for (const path& p : paths) {
+            dispatch_features() = p.features;
+            const measurement m = measure(w, [&bytes](const std::string_view& str) -> std::uint64_t {
+                return hex::decode(str, bytes);
+            });
+            report(w, p.name, m);
+        }
+    }
+
+    std::uint64_t baseline_decimal(const std::string_view& str)
+    {
+        unsigned long long value;
+        const std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), value);
+        return result.ec == std::errc{} ? value : 0;
+    }
+
+    std::uint64_t baseline_double(const std::string_view& str)
+    {
+        double value;
+        const std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), value);
+        return result.ec == std::errc{} && value != 0;
+    }
+
+    /** Parses the integer and the fractional part of a numeric timestamp separately, and scales by digit count. */
+    std::uint64_t baseline_epoch(const std::string_view& str)
+    {
+        const std::size_t dot = std::min(str.find('.'), str.size());
+        decimal_integer integer;
+        if (!integer.parse(str.substr(0, dot))) {
+            return 0;
+        }
+        std::uint64_t fraction = 0;
+        if (dot < str.size()) {
+            decimal_integer digits;
+            if (!digits.parse(str.substr(dot + 1))) {
+                return 0;
+            }
+            fraction = digits.value;
+            for (std::size_t k = str.size() - dot - 1; k < 6; ++k) {
+                fraction *= 10;
+            }
+        }
+        switch (dot) {
+            case 10: return integer.value * 1'000'000 + fraction;
+            case 13: return integer.value * 1'000;
+            case 16: return integer.value;
+            default: return integer.value / 1'000;
+        }
+    }
+
+    std::uint64_t baseline_datetime(const std::string_view& str)
+    {
+        // C library functions need a null-terminated string
+        char buf[64];
+        const std::size_t len = std::min(str.size(), sizeof(buf) - 1);
+        std::memcpy(buf, str.data(), len);
+        buf[len] = 0;
+
+        std::tm tm = {};
+        char sep;
+        if (std::sscanf(buf, "%4d-%2d-%2d%c%2d:%2d:%2d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &sep, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 7) {
+            return 0;
+        }
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+#if defined(_WIN32) || defined(_WIN64)
+        return static_cast<std::uint64_t>(_mkgmtime(&tm));
+#else
+        return static_cast<std::uint64_t>(timegm(&tm));
+#endif
+    }
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    std::uint64_t baseline_strptime(const std::string_view& str, const char* format)
+    {
+        char buf[64];
+        const std::size_t len = std::min(str.size(), sizeof(buf) - 1);
+        std::memcpy(buf, str.data(), len);
+        buf[len] = 0;
+
+        std::tm tm = {};
+        if (strptime(buf, format, &tm) == nullptr) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>(timegm(&tm));
+    }
+#endif
+
+    std::uint64_t baseline_ip(const std::string_view& str, int family)
+    {
+        char buf[64];
+        const std::size_t len = std::min(str.size(), sizeof(buf) - 1);
+        std::memcpy(buf, str.data(), len);
+        buf[len] = 0;
+
+        unsigned char addr[16];
+        return inet_pton(family, buf, addr) == 1 ? addr[0] : 0;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    const std::vector<path> paths = available_paths();
+
+    std::printf("%-20s %-28s %-22s %14s %15s", "type", "shape", "path", "throughput", "latency");
+#if defined(SIMDPARSE_BENCH_RDTSC)
+    std::printf(" %22s", "reference cycles");
+#endif
+    std::printf("\n");
+
+    for (const workload& w : decimal_workloads()) {
+        if (selected(w, filter)) {
+            run_paths<decimal_integer>(w, paths);
+            report(w, "baseline (from_chars)", measure(w, baseline_decimal));
+        }
+    }
+    for (const workload& w : datetime_workloads()) {
+        if (selected(w, filter)) {
+            run_paths<datetime>(w, paths);
+            report(w, "baseline (timegm)", measure(w, baseline_datetime));
+        }
+    }
+    run_datetime_layout<datetime_format<'T', 0, tz_designator::zulu>>("Z", paths, filter);
+    run_datetime_layout<datetime_format<'T', 3, tz_designator::zulu>>("Z", paths, filter);
+    run_datetime_layout<datetime_format<'T', 6, tz_designator::offset>>("+hh:mm", paths, filter);
+    run_datetime_layout<datetime_format<' ', 6, tz_designator::none>>("", paths, filter);
+    for (const workload& w : http_date_workloads()) {
+        if (selected(w, filter)) {
+            if (w.type == "http_date") {
+                run_paths<http_date>(w, paths);
+#if !defined(_WIN32) && !defined(_WIN64)
+                report(w, "baseline (strptime)", measure(w, [](const std::string_view& str) { return baseline_strptime(str, "%a, %d %b %Y %H:%M:%S"); }));
+#endif
+            } else {
+                run_paths<clf_datetime>(w, paths);
+#if !defined(_WIN32) && !defined(_WIN64)
+                report(w, "baseline (strptime)", measure(w, [](const std::string_view& str) { return baseline_strptime(str, "%d/%b/%Y:%H:%M:%S %z"); }));
+#endif
+            }
+        }
+    }
+    for (const workload& w : epoch_workloads()) {
+        if (selected(w, filter)) {
+            run_paths<epoch_time>(w, paths);
+            report(w, "baseline (decimal)", measure(w, baseline_epoch));
+        }
+    }
+    for (const workload& w : decimal_number_workloads()) {
+        if (selected(w, filter)) {
+            if (w.type == "floating_point") {
+                run_paths<floating_point>(w, paths);
+            } else {
+                run_paths<fixed_decimal<6>>(w, paths);
+            }
+            report(w, "baseline (from_chars)", measure(w, baseline_double));
+        }
+    }
+    for (const workload& w : uuid_workloads()) {
+        if (selected(w, filter)) {
+            run_paths<uuid>(w, paths);
+        }
+    }
+    for (const workload& w : hex_workloads()) {
+        if (selected(w, filter)) {
+            if (w.type == "uint128") {
+                run_paths<uint128>(w, paths);
+            } else {
+                run_hex(w, paths);
+            }
+        }
+    }
+    for (const workload& w : ip_workloads()) {
+        if (selected(w, filter)) {
+            if (w.type == "ipv4_addr") {
+                run_paths<ipv4_addr>(w, paths);
+                report(w, "baseline (inet_pton)", measure(w, [](const std::string_view& str) { return baseline_ip(str, AF_INET); }));
+            } else {
+                run_paths<ipv6_addr>(w, paths);
+                report(w, "baseline (inet_pton)", measure(w, [](const std::string_view& str) { return baseline_ip(str, AF_INET6); }));
+            }
+        }
+    }
+    for (const workload& w : base64url_workloads()) {
+        if (selected(w, filter)) {
+            run_base64url(w, paths);
+        }
+    }
+    return 0;
+}
@@ -15,10 +15,424 @@
 #include <array>
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include "dispatch.hpp"
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#endif
 
 namespace simdparse
 {
+    /** Base64 with the standard alphabet and `=` padding, as defined in RFC 4648 section 4. */
+    struct base64
+    {
+        constexpr static std::string_view name = "Base64";
+
+        /** Tag type to request that whitespace characters (e.g. MIME line breaks) are ignored when decoding. */
+        struct skip_whitespace_t {};
+        constexpr inline static skip_whitespace_t skip_whitespace = skip_whitespace_t();
+
+        /** Returned by functions that write into a caller-provided buffer when the input is invalid or the buffer is too small. */
+        constexpr static std::size_t npos = static_cast<std::size_t>(-1);
+
+        /** Number of characters (including padding) that encode the given number of bytes. */
+        constexpr static std::size_t encoded_size(std::size_t byte_count)
+        {
+            return detail::base64_encoded_size<true>(byte_count);
+        }
+
+        /** Maximum number of bytes that a string of the given length decodes into; padding reduces the actual size. */
+        constexpr static std::size_t decoded_size(std::size_t char_count)
+        {
+            return 3 * (char_count / 4);
+        }
+
+        /**
+         * Encodes bytes into a caller-provided buffer.
+         *
+         * @returns Number of characters written, or `npos` if the buffer is smaller than `encoded_size(input.size())`.
+         */
+        static std::size_t encode(const std::basic_string_view<std::byte>& input, char* output, std::size_t capacity)
+        {
+            if (capacity < encoded_size(input.size())) {
+                return npos;
+            }
+            return detail::base64_encode<'+', '/', true>(input, output);
+        }
+
+        static bool encode(const std::basic_string_view<std::byte>& input, std::string& output)
+        {
+            output.resize(encoded_size(input.size()));
+            detail::base64_encode<'+', '/', true>(input, output.data());
+            return true;
+        }
+
+        static bool encode(const std::basic_string<std::byte>& input, std::string& output)
+        {
+            return encode(std::basic_string_view<std::byte>(input.data(), input.size()), output);
+        }
+
+        static std::string encode(const std::basic_string_view<std::byte>& input)
+        {
+            std::string output;
+            encode(input, output);
+            return output;
+        }
+
+        static std::string encode(const std::basic_string<std::byte>& input)
+        {
+            return encode(std::basic_string_view<std::byte>(input.data(), input.size()));
+        }
+
+        /**
+         * Decodes a padded Base64 string into a caller-provided buffer.
+         *
+         * The input length must be a multiple of 4, and `=` may only occur as one or two padding characters at the end.
+         *
+         * @returns Number of bytes written, or `npos` if the input is invalid or the buffer is too small.
+         */
+        static std::size_t decode(const std::string_view& input, std::byte* output, std::size_t capacity)
+        {
+            static constexpr std::array<unsigned char, 256> decoding_table = detail::make_base64_decoding_table("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+            SIMDPARSE_COUNT(base64_decode_calls);
+
+            if (input.size() % 4 != 0) {
+                SIMDPARSE_COUNT(base64_decode_failures);
+                return npos;
+            }
+
+            std::size_t padding = 0;
+            if (!input.empty() && input[input.size() - 1] == '=') {
+                padding = input[input.size() - 2] == '=' ? 2 : 1;
+            }
+
+            // quadruplets without padding
+            std::size_t quadruplets = input.size() / 4 - (padding > 0 ? 1 : 0);
+            if (capacity < 3 * quadruplets + (padding > 0 ? 3 - padding : 0)) {
+                SIMDPARSE_COUNT(base64_decode_failures);
+                return npos;
+            }
+            std::byte* p = output;
+
+            std::size_t i = 0;
+            std::size_t j = 0;
+
+#if defined(SIMDPARSE_AVX512) || defined(SIMDPARSE_NEON)
+            if (detail::use_avx512() || detail::use_neon()) {
+                std::size_t blocks = quadruplets / 16;
+                if (!detail::base64_decode_blocks64(input.data(), blocks, p, decoding_table.data())) {
+                    SIMDPARSE_COUNT(base64_decode_failures);
+                    return npos;
+                }
+                SIMDPARSE_COUNT_N(base64_blocks64, blocks);
+                i = 64 * blocks;
+                j = 16 * blocks;
+                p += 48 * blocks;
+            }
+#endif
+#if defined(SIMDPARSE_AVX2)
+            if (detail::use_avx2()) {
+                std::size_t blocks = (quadruplets - j) / 8;
+                if (!decode_blocks(input.data() + i, blocks, p)) {
+                    SIMDPARSE_COUNT(base64_decode_failures);
+                    return npos;
+                }
+                SIMDPARSE_COUNT_N(base64_blocks32, blocks);
+                i += 32 * blocks;
+                j += 8 * blocks;
+                p += 24 * blocks;
+            }
+#endif
+
+            SIMDPARSE_COUNT_N(base64_scalar, input.size() - i);
+            for (; j < quadruplets; i += 4, ++j) {
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
+                unsigned int c = decoding_table[static_cast<unsigned char>(input[i + 2])];
+                unsigned int d = decoding_table[static_cast<unsigned char>(input[i + 3])];
+                if (((a | b | c | d) & 64) != 0) {
+                    SIMDPARSE_COUNT(base64_decode_failures);
+                    return npos;
+                }
+
+                unsigned int triplet = (a << 3 * 6) | (b << 2 * 6) | (c << 6) | d;
+                *p++ = static_cast<std::byte>((triplet >> 2 * 8) & 0xff);
+                *p++ = static_cast<std::byte>((triplet >> 1 * 8) & 0xff);
+                *p++ = static_cast<std::byte>(triplet & 0xff);
+            }
+
+            if (padding == 1) {
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
+                unsigned int c = decoding_table[static_cast<unsigned char>(input[i + 2])];
+                if (((a | b | c) & 64) != 0) {
+                    SIMDPARSE_COUNT(base64_decode_failures);
+                    return npos;
+                }
+
+                unsigned int triplet = (a << 2 * 6) | (b << 6) | c;
+                *p++ = static_cast<std::byte>((triplet >> 10) & 0xff);
+                *p++ = static_cast<std::byte>((triplet >> 2) & 0xff);
+            } else if (padding == 2) {
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
+                if (((a | b) & 64) != 0) {
+                    SIMDPARSE_COUNT(base64_decode_failures);
+                    return npos;
+                }
+
+                unsigned int triplet = (a << 6) | b;
+                *p++ = static_cast<std::byte>((triplet >> 4) & 0xff);
+            }
+
+            return static_cast<std::size_t>(p - output);
+        }
+
+        /**
+         * Decodes a padded Base64 string.
+         *
+         * The input length must be a multiple of 4, and `=` may only occur as one or two padding characters at the end.
+         */
+        static bool decode(const std::string_view& input, std::basic_string<std::byte>& output)
+        {
+            output.resize(decoded_size(input.size()));
+            std::size_t len = decode(input, output.data(), output.size());
+            if (len == npos) {
+                return false;
+            }
+            output.resize(len);
+            return true;
+        }
+
+        static bool decode(const std::string& input, std::basic_string<std::byte>& output)
+        {
+            return decode(std::string_view(input.data(), input.size()), output);
+        }
+
+        /**
+         * Decodes a padded Base64 string, ignoring space, tab, carriage return and line feed characters.
+         *
+         * Whitespace is removed in blocks of 32 characters before the string is decoded.
+         */
+        static bool decode(const std::string_view& input, std::basic_string<std::byte>& output, skip_whitespace_t)
+        {
+            std::string compact;
+            compact.reserve(input.size());
+
+            std::size_t i = 0;
+
+#if defined(SIMDPARSE_AVX2)
+            if (detail::use_avx2()) {
+                i = remove_whitespace_blocks(input, compact);
+            }
+#endif
+
+            for (; i < input.size(); ++i) {
+                char c = input[i];
+                if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                    compact.push_back(c);
+                }
+            }
+
+            return decode(compact, output);
+        }
+
+        /**
+         * Locates the first error in a padded Base64 string that has failed to decode.
+         *
+         * Decoding does not track the position of an error, so the string is inspected again one character at a time.
+         *
+         * @returns `parse_errc::success` if the string is valid, e.g. if decoding has failed due to a small buffer.
+         */
+        static parse_result validate(const std::string_view& input)
+        {
+            static constexpr std::array<unsigned char, 256> decoding_table = detail::make_base64_decoding_table("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                if (input[i] == '=') {
+                    // padding is one or two characters at the end
+                    const bool is_padding = i + 2 >= input.size() && (i + 1 == input.size() || input[i + 1] == '=');
+                    if (!is_padding) {
+                        return { parse_errc::invalid_character, i };
+                    }
+                } else if ((decoding_table[static_cast<unsigned char>(input[i])] & 64) != 0) {
+                    return { parse_errc::invalid_character, i };
+                }
+            }
+            if (input.size() % 4 != 0) {
+                return { parse_errc::invalid_length, input.size() };
+            }
+            return parse_result();
+        }
+
+    private:
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Appends characters other than whitespace in blocks of 32 characters, copying blocks without whitespace as-is.
+         *
+         * @returns Number of characters consumed, a multiple of 32.
+         */
+        SIMDPARSE_TARGET_AVX2 static std::size_t remove_whitespace_blocks(const std::string_view& input, std::string& compact)
+        {
+            std::size_t i = 0;
+            for (; i + 32 <= input.size(); i += 32) {
+                const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + i));
+                const __m256i is_whitespace = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('\t'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('\n')))
+                );
+                if (_mm256_testz_si256(is_whitespace, is_whitespace)) {
+                    compact.append(input.data() + i, 32);
+                    continue;
+                }
+                for (std::size_t k = i; k < i + 32; ++k) {
+                    char c = input[k];
+                    if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                        compact.push_back(c);
+                    }
+                }
+            }
+            return i;
+        }
+
+        /** Decodes the given number of blocks of 32 characters into 24 bytes each. */
+        SIMDPARSE_TARGET_AVX2 static bool decode_blocks(const char* input, std::size_t count, std::byte* output)
+        {
+            for (std::size_t k = 0; k < count; ++k) {
+                if (!decode32(input + 32 * k, output + 24 * k)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        SIMDPARSE_TARGET_AVX2 static bool decode32(const char* input, std::byte* output)
+        {
+            const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+
+            // upper 4 bits of each character
+            const __m256i groups = _mm256_and_si256(_mm256_srli_epi32(characters, 4), _mm256_set1_epi8(0x0f));
+
+            // maps lower 4 bits of each character to a mask representing character group membership
+            const __m256i valid_mask = _mm256_setr_epi8(
+                // first 16 bytes
+                0b00010101,
+                0b00011111,  // digits, uppercase and lowercase letters
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00001111,  // uppercase and lowercase letters only
+                0b00101010,  // character '+' in group index 2
+                0b00001010,
+                0b00001010,
+                0b00001010,
+                0b00101010,  // character '/' in group index 2
+
+                // second 16 bytes (copy of first)
+                0b00010101,
+                0b00011111,  // digits, uppercase and lowercase letters
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00011111,
+                0b00001111,  // uppercase and lowercase letters only
+                0b00101010,  // character '+' in group index 2
+                0b00001010,
+                0b00001010,
+                0b00001010,
+                0b00101010   // character '/' in group index 2
+            );
+            const __m256i membership = _mm256_shuffle_epi8(valid_mask, characters);
+
+            // maps character group identifier value (upper 4 bits) to a character group bit (1 if member, 0 if not)
+            const __m256i group_mask = _mm256_setr_epi8(
+                // first 16 bytes
+                static_cast<char>(0b10000000u),
+                0b01000000u,
+                0b00100000u,
+                0b00010000u,
+                0b00001000u,
+                0b00000100u,
+                0b00000010u,
+                0b00000001u,
+                -1, -1, -1, -1, -1, -1, -1, -1,  // will match anything
+
+                // second 16 bytes (copy of first)
+                static_cast<char>(0b10000000u),
+                0b01000000u,
+                0b00100000u,
+                0b00010000u,
+                0b00001000u,
+                0b00000100u,
+                0b00000010u,
+                0b00000001u,
+                -1, -1, -1, -1, -1, -1, -1, -1
+            );
+            const __m256i one_hot = _mm256_shuffle_epi8(group_mask, groups);
+
+            // check if any character is out of range for its character class
+            if (!_mm256_testc_si256(membership, one_hot)) {
+                return false;
+            }
+
+            // find the appropriate offset for each character
+            const __m256i offset_lookup = _mm256_setr_epi8(
+                // first 16 bytes
+                64, 64,
+                62 - '+',  // '+' maps to index 62 (and '/' maps to 63)
+                52 - '0',  // '0'..'9' map to index offset 52
+                0 - 'A',   // 'A'..'Z' map to index offset 0
+                0 - 'A',
+                26 - 'a',  // 'a'..'z' map to index offset 26
+                26 - 'a',
+                0, 0, 0, 0, 0, 0, 0, 0,
+
+                // second 16 bytes
+                64, 64,
+                62 - '+',  // '+' maps to index 62 (and '/' maps to 63)
+                52 - '0',  // '0'..'9' map to index offset 52
+                0 - 'A',   // 'A'..'Z' map to index offset 0
+                0 - 'A',
+                26 - 'a',  // 'a'..'z' map to index offset 26
+                26 - 'a',
+                0, 0, 0, 0, 0, 0, 0, 0
+            );
+
+            const __m256i offset = _mm256_shuffle_epi8(offset_lookup, groups);
+            const __m256i is_slash = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('/'));
+            const __m256i shift = _mm256_blendv_epi8(offset, _mm256_set1_epi8(63 - '/'), is_slash);
+            const __m256i values = _mm256_add_epi8(characters, shift);
+
+            // merge 6-bit values into packed bytes (see `base64url::decode32`)
+            const __m256i merge_ab_and_cd = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            const __m256i merge_abcd = _mm256_madd_epi16(merge_ab_and_cd, _mm256_set1_epi32(0x00011000));
+            const __m256i order = _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+            );
+            const __m256i packed_bytes = _mm256_shuffle_epi8(merge_abcd, order);
+
+            alignas(__m256i) std::array<std::uint32_t, 8> result;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), packed_bytes);
+
+            std::memcpy(output, result.data(), 12);
+            std::memcpy(output + 12, result.data() + 4, 12);
+
+            return true;
+        }
+#endif
+    };
+
     inline void check_base64url(const std::string_view& str, const std::string_view& ref)
     {
         std::basic_string<std::byte> in;
@@ -50,4 +464,36 @@ namespace simdparse
             throw std::runtime_error(std::string(buf.data(), n));
         }
     }
+
+    inline void check_base64(const std::string_view& str, const std::string_view& ref)
+    {
+        std::basic_string<std::byte> in;
+        in.resize(str.size());
+        std::memcpy(in.data(), str.data(), str.size());
+        std::string enc;
+        if (!base64::encode(in, enc)) {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %.32s (len = %zu); got encode error", ref.data(), ref.size());
+            throw std::runtime_error(std::string(buf.data(), n));
+        }
+        if (enc != ref) {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %.32s (len = %zu); got: %.32s (len = %zu)", ref.data(), ref.size(), enc.data(), enc.size());
+            throw std::runtime_error(std::string(buf.data(), n));
+        }
+        std::basic_string<std::byte> dec;
+        if (!base64::decode(ref, dec)) {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %.32s (len = %zu); got decode error", ref.data(), ref.size());
+            throw std::runtime_error(std::string(buf.data(), n));
+        }
+        std::string out;
+        out.resize(dec.size());
+        std::memcpy(out.data(), dec.data(), dec.size());
+        if (out != str) {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %.32s (len = %zu); got: %.32s (len = %zu)", str.data(), str.size(), out.data(), out.size());
+            throw std::runtime_error(std::string(buf.data(), n));
+        }
+    }
 }
@@ -9,47 +9,283 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
 #include <string>
 #include <string_view>
 #include <cstddef>
 #include <cstdint>
-
-#if defined(__AVX2__)
-#include <array>
 #include <cstring>
+#include "dispatch.hpp"
+#include "result.hpp"
+#include "stats.hpp"
+
+#if defined(SIMDPARSE_AVX2) || defined(SIMDPARSE_AVX512)
 #include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace simdparse
 {
-    struct base64url
+    namespace detail
     {
-        constexpr static std::string_view name = "modified Base64 for URL";
+        /** Maps each character to its 6-bit value, or 64 if the character is not in the alphabet. */
+        constexpr std::array<unsigned char, 256> make_base64_decoding_table(const std::string_view& alphabet)
+        {
+            std::array<unsigned char, 256> table = {};
+            for (unsigned char& value : table) {
+                value = 64;
+            }
+            for (std::size_t k = 0; k < alphabet.size(); ++k) {
+                table[static_cast<unsigned char>(alphabet[k])] = static_cast<unsigned char>(k);
+            }
+            return table;
+        }
 
-        static bool encode(const std::basic_string_view<std::byte>& input, std::string& output)
+#if defined(SIMDPARSE_AVX512)
+        /**
+         * Decodes the given number of blocks of 64 characters into 48 bytes each.
+         *
+         * Characters are translated with a single two-register byte permutation that indexes the first 128 entries
+         * of the decoding table, and sextets are merged with multiply-add instructions.
+         *
+         * @param table Decoding table that maps characters not in the alphabet to 64.
+         * @see Wojciech Muła, Daniel Lemire: Base64 encoding and decoding at almost the speed of a memory copy.
+         */
+        SIMDPARSE_TARGET_AVX512 inline bool base64_decode_blocks64(const char* input, std::size_t count, std::byte* output, const unsigned char* table)
         {
-            static constexpr char encoding_table[] = {
+            // `vpermi2b` uses the lower 7 bits of each character as an index into a table of 128 entries
+            const __m512i lookup_lo = _mm512_loadu_si512(table);
+            const __m512i lookup_hi = _mm512_loadu_si512(table + 64);
+
+            // byte order of the 24-bit value in each 32-bit integer is reversed
+            alignas(64) static constexpr std::uint8_t pack_indices[64] = {
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 18, 17, 16, 22,
+                21, 20, 26, 25, 24, 30, 29, 28, 34, 33, 32, 38, 37, 36, 42, 41,
+                40, 46, 45, 44, 50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60,
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+            };
+            const __m512i pack = _mm512_load_si512(pack_indices);
+
+            for (std::size_t k = 0; k < count; ++k) {
+                const __m512i characters = _mm512_loadu_si512(input + 64 * k);
+                const __m512i values = _mm512_permutex2var_epi8(lookup_lo, characters, lookup_hi);
+
+                // characters not in the alphabet map to 64, non-ASCII characters have their highest bit set
+                if (_mm512_test_epi8_mask(values, _mm512_set1_epi8(0x40)) | _mm512_movepi8_mask(characters)) {
+                    return false;
+                }
+
+                // 00aaaaaa 00bbbbbb 00cccccc 00dddddd --> 0000aaaa aabbbbbb 0000cccc ccdddddd
+                const __m512i merge_ab_and_cd = _mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140));
+                // --> 00000000 aaaaaabb bbbbcccc ccdddddd
+                const __m512i merge_abcd = _mm512_madd_epi16(merge_ab_and_cd, _mm512_set1_epi32(0x00011000));
+
+                constexpr __mmask64 output_mask = 0x0000'ffff'ffff'ffffull;
+                const __m512i packed_bytes = _mm512_maskz_permutexvar_epi8(output_mask, pack, merge_abcd);
+                _mm512_mask_storeu_epi8(output + 48 * k, output_mask, packed_bytes);
+            }
+            return true;
+        }
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Decodes the given number of blocks of 64 characters into 48 bytes each.
+         *
+         * Characters are de-interleaved into four registers with a structured load, translated with table lookups
+         * that index the first 128 entries of the decoding table, and re-interleaved with a structured store.
+         *
+         * @param table Decoding table that maps characters not in the alphabet to 64.
+         */
+        inline bool base64_decode_blocks64(const char* input, std::size_t count, std::byte* output, const unsigned char* table)
+        {
+            const uint8x16x4_t lookup_lo = vld1q_u8_x4(table);
+            const uint8x16x4_t lookup_hi = vld1q_u8_x4(table + 64);
+
+            for (std::size_t k = 0; k < count; ++k) {
+                // each register holds every 4th character
+                const uint8x16x4_t characters = vld4q_u8(reinterpret_cast<const std::uint8_t*>(input + 64 * k));
+
+                uint8x16x4_t values;
+                uint8x16_t invalid = vdupq_n_u8(0);
+                for (int n = 0; n < 4; ++n) {
+                    // characters 0 to 63 index the first half of the table, 64 to 127 the second half;
+                    // a lookup with an index out of range yields zero, or leaves the value unchanged
+                    const uint8x16_t c = characters.val[n];
+                    const uint8x16_t v = vqtbx4q_u8(vqtbl4q_u8(lookup_lo, c), lookup_hi, vsubq_u8(c, vdupq_n_u8(64)));
+
+                    // characters not in the alphabet map to 64, non-ASCII characters (shifted right) are at least 64
+                    invalid = vorrq_u8(invalid, vorrq_u8(v, vshrq_n_u8(c, 1)));
+                    values.val[n] = v;
+                }
+                if (vmaxvq_u8(vandq_u8(invalid, vdupq_n_u8(0x40))) != 0) {
+                    return false;
+                }
+
+                // 00aaaaaa 00bbbbbb 00cccccc 00dddddd --> aaaaaabb bbbbcccc ccdddddd
+                uint8x16x3_t bytes;
+                bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+                bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+                bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+                vst3q_u8(reinterpret_cast<std::uint8_t*>(output + 48 * k), bytes);
+            }
+            return true;
+        }
+#endif
+
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Encodes 24 bytes into 32 characters.
+         *
+         * Reads 28 bytes of input; the last 4 bytes are ignored.
+         *
+         * @tparam Char62 Character that encodes the value 62.
+         * @tparam Char63 Character that encodes the value 63.
+         *
+         * @see Wojciech Muła, Daniel Lemire: Faster Base64 Encoding and Decoding Using AVX2 Instructions.
+         */
+        template<char Char62, char Char63>
+        SIMDPARSE_TARGET_AVX2 void base64_encode24(const std::byte* input, char* output)
+        {
+            // load 12 bytes into each 128-bit lane
+            const __m256i bytes = _mm256_setr_m128i(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 12))
+            );
+
+            // duplicate bytes such that each 32-bit word holds a triplet
+            // bytes:  aaaaaabb | bbbbcccc | ccdddddd
+            // result: bbbbcccc   aaaaaabb   ccdddddd   bbbbcccc   (little endian)
+            const __m256i triplets = _mm256_shuffle_epi8(bytes, _mm256_setr_epi8(
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+            ));
+
+            // move each 6-bit value into a separate byte
+            // extract `a` and `c`, and shift them right with a high multiply into the 1st and 3rd byte
+            // extract `b` and `d`, and shift them left with a low multiply into the 2nd and 4th byte
+            const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(triplets, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+            const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(triplets, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(ac, bd);
+
+            // map index ranges to a lookup entry that holds an offset
+            // 0..25 -> 13 ('A'..'Z'), 26..51 -> 0 ('a'..'z'), 52..61 -> 1..10 ('0'..'9'), 62 -> 11, 63 -> 12
+            __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            const __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+            range = _mm256_or_si256(range, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+            const __m256i offset_lookup = _mm256_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, Char62 - 62, Char63 - 63, 'A', 0, 0,
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, Char62 - 62, Char63 - 63, 'A', 0, 0
+            );
+            const __m256i characters = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offset_lookup, range));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), characters);
+        }
+
+        /**
+         * Encodes blocks of 24 bytes into 32 characters each while at least 28 bytes of input remain.
+         *
+         * @returns Number of bytes consumed, a multiple of 24.
+         */
+        template<char Char62, char Char63>
+        SIMDPARSE_TARGET_AVX2 std::size_t base64_encode_blocks(const std::byte* input, std::size_t in_len, char* output)
+        {
+            // each iteration reads 28 bytes but consumes only 24
+            std::size_t i = 0;
+            for (; i + 28 <= in_len; i += 24) {
+                base64_encode24<Char62, Char63>(input + i, output);
+                output += 32;
+            }
+            return i;
+        }
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Encodes blocks of 48 bytes into 64 characters each.
+         *
+         * Bytes are de-interleaved into three registers with a structured load, split into four registers of 6-bit
+         * values, translated with a table lookup, and re-interleaved with a structured store.
+         *
+         * @returns Number of bytes consumed, a multiple of 48.
+         */
+        template<char Char62, char Char63>
+        std::size_t base64_encode_blocks(const std::byte* input, std::size_t in_len, char* output)
+        {
+            static constexpr std::uint8_t encoding_table[64] = {
                 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
                 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
                 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
                 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
-                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_' };
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', Char62, Char63 };
+            const uint8x16x4_t lookup = vld1q_u8_x4(encoding_table);
+            const uint8x16_t mask = vdupq_n_u8(0x3f);
 
-            std::size_t in_len = input.size();
+            std::size_t i = 0;
+            for (; i + 48 <= in_len; i += 48) {
+                // aaaaaabb bbbbcccc ccdddddd --> 00aaaaaa 00bbbbbb 00cccccc 00dddddd
+                const uint8x16x3_t bytes = vld3q_u8(reinterpret_cast<const std::uint8_t*>(input + i));
+                uint8x16x4_t indices;
+                indices.val[0] = vshrq_n_u8(bytes.val[0], 2);
+                indices.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask);
+                indices.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask);
+                indices.val[3] = vandq_u8(bytes.val[2], mask);
+
+                uint8x16x4_t characters;
+                for (int n = 0; n < 4; ++n) {
+                    characters.val[n] = vqtbl4q_u8(lookup, indices.val[n]);
+                }
+                vst4q_u8(reinterpret_cast<std::uint8_t*>(output), characters);
+                output += 64;
+            }
+            return i;
+        }
+#endif
+
+        /** Number of Base64 characters that encode the given number of bytes. */
+        template<bool Padding>
+        constexpr std::size_t base64_encoded_size(std::size_t in_len)
+        {
             std::size_t triplets = in_len / 3;
             std::size_t spare = in_len % 3;
-            std::size_t out_len = (4 * triplets) + (spare > 0 ? spare + 1 : 0);
+            return (4 * triplets) + (spare > 0 ? (Padding ? 4 : spare + 1) : 0);
+        }
 
-            output.clear();
-            output.resize(out_len);
+        /**
+         * Encodes bytes into Base64 characters.
+         *
+         * @param output Buffer with space for at least `base64_encoded_size(input.size())` characters.
+         * @tparam Char62 Character that encodes the value 62.
+         * @tparam Char63 Character that encodes the value 63.
+         * @tparam Padding Whether to append `=` characters such that the output length is a multiple of 4.
+         * @returns Number of characters written.
+         */
+        template<char Char62, char Char63, bool Padding>
+        std::size_t base64_encode(const std::basic_string_view<std::byte>& input, char* output)
+        {
+            static constexpr char encoding_table[] = {
+                'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+                'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+                'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+                'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', Char62, Char63 };
+
+            std::size_t in_len = input.size();
+            std::size_t spare = in_len % 3;
 
-            char* p = output.data();
+            char* p = output;
             unsigned a;
             unsigned b;
             unsigned c;
 
             std::size_t i = 0;
-            for (std::size_t k = 0; k < triplets; i += 3, ++k) {
+
+#if defined(SIMDPARSE_SIMD)
+            if (use_simd()) {
+                i = base64_encode_blocks<Char62, Char63>(input.data(), in_len, p);
+                p += i / 3 * 4;
+            }
+#endif
+
+            for (; i + 3 <= in_len; i += 3) {
                 a = static_cast<unsigned>(input[i]);
                 b = static_cast<unsigned>(input[i + 1]);
                 c = static_cast<unsigned>(input[i + 2]);
@@ -63,6 +299,10 @@ namespace simdparse
                 a = static_cast<unsigned>(input[i]);
                 *p++ = encoding_table[(a >> 2) & 0x3f];
                 *p++ = encoding_table[(a & 0x3) << 4];
+                if constexpr (Padding) {
+                    *p++ = '=';
+                    *p++ = '=';
+                }
                 break;
             case 2:
                 a = static_cast<unsigned>(input[i]);
@@ -70,11 +310,54 @@ namespace simdparse
                 *p++ = encoding_table[(a >> 2) & 0x3f];
                 *p++ = encoding_table[((a & 0x3) << 4) | ((b >> 4) & 0xf)];
                 *p++ = encoding_table[((b & 0xf) << 2)];
+                if constexpr (Padding) {
+                    *p++ = '=';
+                }
                 break;
             default:  // case 0:
                 break;
             }
 
+            return static_cast<std::size_t>(p - output);
+        }
+    }
+
+    struct base64url
+    {
+        constexpr static std::string_view name = "modified Base64 for URL";
+
+        /** Returned by functions that write into a caller-provided buffer when the input is invalid or the buffer is too small. */
+        constexpr static std::size_t npos = static_cast<std::size_t>(-1);
+
+        /** Number of characters that encode the given number of bytes. */
+        constexpr static std::size_t encoded_size(std::size_t byte_count)
+        {
+            return detail::base64_encoded_size<false>(byte_count);
+        }
+
+        /** Number of bytes that a string of the given length decodes into, if the length is valid. */
+        constexpr static std::size_t decoded_size(std::size_t char_count)
+        {
+            return 3 * (char_count / 4) + (char_count % 4 > 1 ? char_count % 4 - 1 : 0);
+        }
+
+        /**
+         * Encodes bytes into a caller-provided buffer.
+         *
+         * @returns Number of characters written, or `npos` if the buffer is smaller than `encoded_size(input.size())`.
+         */
+        static std::size_t encode(const std::basic_string_view<std::byte>& input, char* output, std::size_t capacity)
+        {
+            if (capacity < encoded_size(input.size())) {
+                return npos;
+            }
+            return detail::base64_encode<'-', '_', false>(input, output);
+        }
+
+        static bool encode(const std::basic_string_view<std::byte>& input, std::string& output)
+        {
+            output.resize(encoded_size(input.size()));
+            detail::base64_encode<'-', '_', false>(input, output.data());
             return true;
         }
 
@@ -95,24 +378,15 @@ namespace simdparse
             return encode(std::basic_string_view<std::byte>(input.data(), input.size()));
         }
 
-        static bool decode(const std::string_view& input, std::basic_string<std::byte>& output)
+        /**
+         * Decodes a string into a caller-provided buffer.
+         *
+         * @returns Number of bytes written, or `npos` if the input is invalid or the buffer is smaller than `decoded_size(input.size())`.
+         */
+        static std::size_t decode(const std::string_view& input, std::byte* output, std::size_t capacity)
         {
-            static constexpr unsigned char decoding_table[] = {
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 62, 64, 64, 52, 53, 54, 55, 56, 57,
-                58, 59, 60, 61, 64, 64, 64, 64, 64, 64, 64,  0,  1,  2,  3,  4,  5,  6,
-                 7,  8,  9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
-                25, 64, 64, 64, 64, 63, 64, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
-                37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-                64, 64, 64, 64 };
+            static constexpr std::array<unsigned char, 256> decoding_table = detail::make_base64_decoding_table("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+            SIMDPARSE_COUNT(base64url_decode_calls);
 
             std::size_t quadruplets = input.size() / 4;
             std::size_t spare = 0;
@@ -121,32 +395,55 @@ namespace simdparse
             } else if (input.size() % 4 == 2) {
                 spare = 1;
             } else if (input.size() % 4 == 1) {
-                return false;
+                SIMDPARSE_COUNT(base64url_decode_failures);
+                return npos;
             }
 
-            output.resize(3 * quadruplets + spare);
-            std::byte* p = output.data();
+            if (capacity < 3 * quadruplets + spare) {
+                SIMDPARSE_COUNT(base64url_decode_failures);
+                return npos;
+            }
+            std::byte* p = output;
 
             std::size_t i = 0;
             std::size_t j = 0;
 
-#if defined(__AVX2__)
-            std::size_t xmms = quadruplets / 8;
-            for (std::size_t k = 0; k < xmms; i += 32, j += 8, ++k) {
-                if (!decode32(input.data() + i, p)) {
-                    return false;
+#if defined(SIMDPARSE_AVX512) || defined(SIMDPARSE_NEON)
+            if (detail::use_avx512() || detail::use_neon()) {
+                std::size_t blocks = quadruplets / 16;
+                if (!detail::base64_decode_blocks64(input.data(), blocks, p, decoding_table.data())) {
+                    SIMDPARSE_COUNT(base64url_decode_failures);
+                    return npos;
+                }
+                SIMDPARSE_COUNT_N(base64url_blocks64, blocks);
+                i = 64 * blocks;
+                j = 16 * blocks;
+                p += 48 * blocks;
+            }
+#endif
+#if defined(SIMDPARSE_AVX2)
+            if (detail::use_avx2()) {
+                std::size_t blocks = (quadruplets - j) / 8;
+                if (!decode_blocks(input.data() + i, blocks, p)) {
+                    SIMDPARSE_COUNT(base64url_decode_failures);
+                    return npos;
                 }
-                p += 24;
+                SIMDPARSE_COUNT_N(base64url_blocks32, blocks);
+                i += 32 * blocks;
+                j += 8 * blocks;
+                p += 24 * blocks;
             }
 #endif
 
+            SIMDPARSE_COUNT_N(base64url_scalar, input.size() - i);
             for (; j < quadruplets; i += 4, ++j) {
-                unsigned int a = decoding_table[static_cast<int>(input[i])];
-                unsigned int b = decoding_table[static_cast<int>(input[i + 1])];
-                unsigned int c = decoding_table[static_cast<int>(input[i + 2])];
-                unsigned int d = decoding_table[static_cast<int>(input[i + 3])];
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
+                unsigned int c = decoding_table[static_cast<unsigned char>(input[i + 2])];
+                unsigned int d = decoding_table[static_cast<unsigned char>(input[i + 3])];
                 if (((a | b | c | d) & 64) != 0) {
-                    return false;
+                    SIMDPARSE_COUNT(base64url_decode_failures);
+                    return npos;
                 }
 
                 unsigned int triplet = (a << 3 * 6) | (b << 2 * 6) | (c << 6) | d;
@@ -156,28 +453,36 @@ namespace simdparse
             }
 
             if (input.size() % 4 == 3) {
-                unsigned int a = decoding_table[static_cast<int>(input[i])];
-                unsigned int b = decoding_table[static_cast<int>(input[i + 1])];
-                unsigned int c = decoding_table[static_cast<int>(input[i + 2])];
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
+                unsigned int c = decoding_table[static_cast<unsigned char>(input[i + 2])];
                 if (((a | b | c) & 64) != 0) {
-                    return false;
+                    SIMDPARSE_COUNT(base64url_decode_failures);
+                    return npos;
                 }
 
                 unsigned int triplet = (a << 2 * 6) | (b << 6) | c;
                 *p++ = static_cast<std::byte>((triplet >> 10) & 0xff);
                 *p++ = static_cast<std::byte>((triplet >> 2) & 0xff);
             } else if (input.size() % 4 == 2) {
-                unsigned int a = decoding_table[static_cast<int>(input[i])];
-                unsigned int b = decoding_table[static_cast<int>(input[i + 1])];
+                unsigned int a = decoding_table[static_cast<unsigned char>(input[i])];
+                unsigned int b = decoding_table[static_cast<unsigned char>(input[i + 1])];
                 if (((a | b) & 64) != 0) {
-                    return false;
+                    SIMDPARSE_COUNT(base64url_decode_failures);
+                    return npos;
                 }
 
                 unsigned int triplet = (a << 6) | b;
                 *p++ = static_cast<std::byte>((triplet >> 4) & 0xff);
             }
 
-            return true;
+            return static_cast<std::size_t>(p - output);
+        }
+
+        static bool decode(const std::string_view& input, std::basic_string<std::byte>& output)
+        {
+            output.resize(decoded_size(input.size()));
+            return decode(input, output.data(), output.size()) != npos;
         }
 
         static bool decode(const std::string& input, std::basic_string<std::byte>& output)
@@ -185,8 +490,40 @@ namespace simdparse
             return decode(std::string_view(input.data(), input.size()), output);
         }
 
-#if defined(__AVX2__)
-        static bool decode32(const char* input, std::byte* output)
+        /**
+         * Locates the first error in a string that has failed to decode.
+         *
+         * Decoding does not track the position of an error, so the string is inspected again one character at a time.
+         *
+         * @returns `parse_errc::success` if the string is valid, e.g. if decoding has failed due to a small buffer.
+         */
+        static parse_result validate(const std::string_view& input)
+        {
+            static constexpr std::array<unsigned char, 256> decoding_table = detail::make_base64_decoding_table("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                if ((decoding_table[static_cast<unsigned char>(input[i])] & 64) != 0) {
+                    return { parse_errc::invalid_character, i };
+                }
+            }
+            if (input.size() % 4 == 1) {
+                return { parse_errc::invalid_length, input.size() };
+            }
+            return parse_result();
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Decodes the given number of blocks of 32 characters into 24 bytes each. */
+        SIMDPARSE_TARGET_AVX2 static bool decode_blocks(const char* input, std::size_t count, std::byte* output)
+        {
+            for (std::size_t k = 0; k < count; ++k) {
+                if (!decode32(input + 32 * k, output + 24 * k)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        SIMDPARSE_TARGET_AVX2 static bool decode32(const char* input, std::byte* output)
         {
             const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
 
@@ -236,7 +573,7 @@ namespace simdparse
             // maps character group identifier value (upper 4 bits) to a character group bit (1 if member, 0 if not)
             const __m256i group_mask = _mm256_setr_epi8(
                 // first 16 bytes
-                0b10000000u,
+                static_cast<char>(0b10000000u),
                 0b01000000u,
                 0b00100000u,
                 0b00010000u,
@@ -244,10 +581,10 @@ namespace simdparse
                 0b00000100u,
                 0b00000010u,
                 0b00000001u,
-                0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu,  // will match anything
+                -1, -1, -1, -1, -1, -1, -1, -1,  // will match anything
 
                 // second 16 bytes (copy of first)
-                0b10000000u,
+                static_cast<char>(0b10000000u),
                 0b01000000u,
                 0b00100000u,
                 0b00010000u,
@@ -255,7 +592,7 @@ namespace simdparse
                 0b00000100u,
                 0b00000010u,
                 0b00000001u,
-                0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu
+                -1, -1, -1, -1, -1, -1, -1, -1
             );
             const __m256i one_hot = _mm256_shuffle_epi8(group_mask, groups);
 
@@ -318,5 +655,110 @@ namespace simdparse
             return true;
         }
 #endif
+
+        /**
+         * Decodes a string that arrives in chunks of arbitrary size, using memory of constant size.
+         *
+         * Characters that do not form a complete quadruplet at the end of a chunk (at most 3) are carried over to the
+         * next chunk. Decoded bytes are passed to a sink callable with the signature `void(const std::byte*, std::size_t)`
+         * in blocks of at most `block_size` bytes.
+         */
+        struct decoder
+        {
+            constexpr static std::size_t block_size = 768;
+
+            /**
+             * Decodes the next chunk of the input string.
+             *
+             * @returns False if the input is invalid. Once an error occurs, all subsequent calls fail.
+             */
+            template<typename Sink>
+            bool update(const std::string_view& chunk, Sink&& sink)
+            {
+                if (_failed) {
+                    return false;
+                }
+
+                std::size_t i = 0;
+                std::size_t out = 0;
+
+                // complete a quadruplet with characters carried over from the previous chunk
+                if (_carry_size > 0) {
+                    while (_carry_size < 4 && i < chunk.size()) {
+                        _carry[_carry_size++] = chunk[i++];
+                    }
+                    if (_carry_size < 4) {
+                        return true;
+                    }
+                    if (base64url::decode(std::string_view(_carry.data(), 4), _buffer.data(), _buffer.size()) == npos) {
+                        _failed = true;
+                        return false;
+                    }
+                    _carry_size = 0;
+                    out = 3;
+                }
+
+                // decode complete quadruplets in blocks that fill the buffer
+                const std::size_t end = i + (chunk.size() - i) / 4 * 4;
+                while (i < end) {
+                    const std::size_t len = std::min(end - i, (_buffer.size() - out) / 3 * 4);
+                    if (base64url::decode(chunk.substr(i, len), _buffer.data() + out, _buffer.size() - out) == npos) {
+                        _failed = true;
+                        return false;
+                    }
+                    out += len / 4 * 3;
+                    i += len;
+                    if (out + 3 > _buffer.size()) {
+                        sink(static_cast<const std::byte*>(_buffer.data()), out);
+                        out = 0;
+                    }
+                }
+                if (out > 0) {
+                    sink(static_cast<const std::byte*>(_buffer.data()), out);
+                }
+
+                std::memcpy(_carry.data(), chunk.data() + end, chunk.size() - end);
+                _carry_size = chunk.size() - end;
+                return true;
+            }
+
+            /**
+             * Decodes characters carried over from the last chunk, and resets the decoder.
+             *
+             * @returns False if the input is invalid, including when the total number of characters leaves a remainder of 1 when divided by 4.
+             */
+            template<typename Sink>
+            bool finish(Sink&& sink)
+            {
+                bool failed = _failed;
+                std::size_t carry_size = _carry_size;
+                reset();
+                if (failed) {
+                    return false;
+                }
+
+                if (carry_size > 0) {
+                    std::size_t len = base64url::decode(std::string_view(_carry.data(), carry_size), _buffer.data(), _buffer.size());
+                    if (len == npos) {
+                        return false;
+                    }
+                    sink(static_cast<const std::byte*>(_buffer.data()), len);
+                }
+                return true;
+            }
+
+            /** Discards any carried over characters and clears the error state. */
+            void reset()
+            {
+                _carry_size = 0;
+                _failed = false;
+            }
+
+        private:
+            std::array<char, 4> _carry = {};
+            std::size_t _carry_size = 0;
+            bool _failed = false;
+            std::array<std::byte, block_size> _buffer;
+        };
     };
 }
@@ -0,0 +1,679 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "datetime.hpp"
+#include "dispatch.hpp"
+#include "stats.hpp"
+#include "uuid.hpp"
+#include <array>
+#include <bitset>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(SIMDPARSE_AVX2) || defined(SIMDPARSE_AVX512)
+#include <immintrin.h>
+#endif
+
+namespace simdparse
+{
+    /** A sequence of bits that indicates which items in a batch have been parsed successfully. */
+    struct bitmask
+    {
+        bitmask()
+        {
+        }
+
+        explicit bitmask(std::size_t count)
+        {
+            resize(count);
+        }
+
+        /** Sets the number of bits, and clears all bits. */
+        void resize(std::size_t count)
+        {
+            _size = count;
+            _words.assign((count + 63) / 64, 0);
+        }
+
+        /** Appends a bit to the end of the mask. */
+        void push_back(bool value)
+        {
+            if (_size % 64 == 0) {
+                _words.push_back(0);
+            }
+            _words.back() |= std::uint64_t(value) << (_size % 64);
+            ++_size;
+        }
+
+        /** Removes all bits. */
+        void clear()
+        {
+            _size = 0;
+            _words.clear();
+        }
+
+        /** Number of bits in the mask. */
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+        bool test(std::size_t index) const
+        {
+            return (_words[index / 64] >> (index % 64)) & 1;
+        }
+
+        void set(std::size_t index)
+        {
+            _words[index / 64] |= std::uint64_t(1) << (index % 64);
+        }
+
+        void reset(std::size_t index)
+        {
+            _words[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+        }
+
+        /** Number of bits set. */
+        std::size_t count() const
+        {
+            std::size_t n = 0;
+            for (std::uint64_t word : _words) {
+                n += std::bitset<64>(word).count();
+            }
+            return n;
+        }
+
+        /** True if all bits are set. */
+        bool all() const
+        {
+            return count() == _size;
+        }
+
+        /** Number of 64-bit words that hold the bits, with bit `k` of word `i` standing for item `64 * i + k`. */
+        std::size_t words() const
+        {
+            return _words.size();
+        }
+
+        const std::uint64_t* data() const
+        {
+            return _words.data();
+        }
+
+        std::uint64_t* data()
+        {
+            return _words.data();
+        }
+
+    private:
+        std::vector<std::uint64_t> _words;
+        std::size_t _size = 0;
+    };
+
+    namespace detail
+    {
+        /** Longest string that is grouped by length in a batch; all longer strings share a single group. */
+        constexpr static std::size_t batch_max_length = 63;
+
+        /**
+         * Parses a block of at most 64 strings, visiting strings of the same length one after the other.
+         *
+         * Strings are grouped with a counting sort on their length such that each group takes the same path through
+         * the parser, e.g. the same fractional-part branch for date-time strings, which keeps branches predictable.
+         * Each string is still parsed with a separate call to `T::parse`.
+         *
+         * @returns A word with bit `k` set if the `k`-th string has been parsed successfully.
+         */
+        template<typename T>
+        std::uint64_t parse_block(const std::string_view* input, std::size_t count, T* output)
+        {
+            std::array<std::uint8_t, batch_max_length + 2> offsets = {};
+            for (std::size_t k = 0; k < count; ++k) {
+                std::size_t len = input[k].size();
+                ++offsets[(len < batch_max_length ? len : batch_max_length) + 1];
+            }
+            for (std::size_t n = 1; n < offsets.size(); ++n) {
+                offsets[n] += offsets[n - 1];
+            }
+
+            std::array<std::uint8_t, 64> order;
+            for (std::size_t k = 0; k < count; ++k) {
+                std::size_t len = input[k].size();
+                order[offsets[len < batch_max_length ? len : batch_max_length]++] = static_cast<std::uint8_t>(k);
+            }
+
+            std::uint64_t valid = 0;
+            for (std::size_t n = 0; n < count; ++n) {
+                std::size_t k = order[n];
+                if (output[k].parse(input[k])) {
+                    valid |= std::uint64_t(1) << k;
+                } else {
+                    output[k] = T();
+                }
+            }
+            return valid;
+        }
+    }
+
+    /**
+     * Parses a sequence of strings into a contiguous array of objects.
+     *
+     * As opposed to calling `parse` for each string, parsing does not stop at the first failure. Objects that fail
+     * to parse are default-constructed, and their corresponding bit in the validity mask is cleared.
+     *
+     * @param input Strings to parse.
+     * @param count Number of strings to parse.
+     * @param output Array of (at least) `count` objects to hold the results.
+     * @param valid Validity mask with bit `k` set if the `k`-th string has been parsed successfully.
+     * @returns Number of strings parsed successfully.
+     */
+    template<typename T>
+    std::size_t parse_many(const std::string_view* input, std::size_t count, T* output, bitmask& valid)
+    {
+        valid.resize(count);
+        std::uint64_t* words = valid.data();
+        std::size_t success = 0;
+        for (std::size_t i = 0; i < count; i += 64) {
+            std::size_t block = count - i < 64 ? count - i : 64;
+            std::uint64_t word = detail::parse_block(input + i, block, output + i);
+            words[i / 64] = word;
+            success += std::bitset<64>(word).count();
+        }
+        return success;
+    }
+
+    /** Parses a sequence of strings into a contiguous array of objects. */
+    template<typename T>
+    std::size_t parse_many(const std::vector<std::string_view>& input, std::vector<T>& output, bitmask& valid)
+    {
+        output.resize(input.size());
+        return parse_many(input.data(), input.size(), output.data(), valid);
+    }
+
+    namespace detail
+    {
+#if defined(SIMDPARSE_AVX512)
+        /**
+         * Parses two UUID strings in the 8-4-4-4-12 format with a single 512-bit register.
+         *
+         * Both strings are loaded with a masked load that reads exactly 36 characters, and a two-register byte
+         * permutation removes the dashes such that the 32 digits of the first string occupy the lower half and the
+         * 32 digits of the second string the upper half of the register. Pairs of nibbles are merged with a
+         * multiply-add instruction, and 16-bit integers are narrowed to bytes.
+         *
+         * @returns A 2-bit mask with bit `k` set if the `k`-th string has been parsed successfully.
+         */
+        SIMDPARSE_TARGET_AVX512 inline unsigned int parse_uuid_pair(const char* first, const char* second, uuid& first_value, uuid& second_value)
+        {
+            constexpr __mmask64 length_mask = (std::uint64_t{ 1 } << 36) - 1;
+            const __m512i a = _mm512_maskz_loadu_epi8(length_mask, first);
+            const __m512i b = _mm512_maskz_loadu_epi8(length_mask, second);
+
+            constexpr __mmask64 dash_mask = (std::uint64_t{ 1 } << 8) | (std::uint64_t{ 1 } << 13) | (std::uint64_t{ 1 } << 18) | (std::uint64_t{ 1 } << 23);
+            const __m512i dash = _mm512_set1_epi8('-');
+            const bool first_dashes = _mm512_mask_cmpeq_epi8_mask(dash_mask, a, dash) == dash_mask;
+            const bool second_dashes = _mm512_mask_cmpeq_epi8_mask(dash_mask, b, dash) == dash_mask;
+
+            // positions of digits in `xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx`, with bit 6 selecting the second string
+            alignas(64) static constexpr std::uint8_t digit_indices[64] = {
+                0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, 16, 17,
+                19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
+                64, 65, 66, 67, 68, 69, 70, 71, 73, 74, 75, 76, 78, 79, 80, 81,
+                83, 84, 85, 86, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99
+            };
+            const __m512i characters = _mm512_permutex2var_epi8(a, _mm512_load_si512(digit_indices), b);
+
+            // offset from `0` for digits, and offset from `a` for (lowercase) letters, wrapping around if below
+            const __m512i digits = _mm512_sub_epi8(characters, _mm512_set1_epi8('0'));
+            const __m512i alphas = _mm512_sub_epi8(_mm512_or_si512(characters, _mm512_set1_epi8(0b00100000)), _mm512_set1_epi8('a'));
+            const __mmask64 is_digit = _mm512_cmple_epu8_mask(digits, _mm512_set1_epi8(9));
+            const __mmask64 is_alpha = _mm512_cmple_epu8_mask(alphas, _mm512_set1_epi8(5));
+            const std::uint64_t is_hex = is_digit | is_alpha;
+            const __m512i nibbles = _mm512_mask_blend_epi8(is_digit, _mm512_add_epi8(alphas, _mm512_set1_epi8(10)), digits);
+
+            // 16 * high nibble + low nibble in each 16-bit integer, narrowed to bytes (the zero-masking form avoids a
+            // spurious uninitialized warning with some compilers)
+            const __m256i bytes = _mm512_maskz_cvtepi16_epi8(0xffffffff, _mm512_maddubs_epi16(nibbles, _mm512_set1_epi16(0x0110)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&first_value), _mm256_castsi256_si128(bytes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&second_value), _mm256_extracti128_si256(bytes, 1));
+
+            const bool first_valid = first_dashes && static_cast<std::uint32_t>(is_hex) == 0xffffffff;
+            const bool second_valid = second_dashes && static_cast<std::uint32_t>(is_hex >> 32) == 0xffffffff;
+            return static_cast<unsigned int>(first_valid) | (static_cast<unsigned int>(second_valid) << 1);
+        }
+#endif
+    }
+
+    /**
+     * Parses a sequence of UUID strings into a contiguous array of `uuid` objects.
+     *
+     * Behaves like `parse_many<uuid>`. On processors with AVX-512, strings in the 8-4-4-4-12 format are parsed two
+     * at a time, pairing each such string with the next one in the sequence; strings in other layouts are parsed
+     * one by one.
+     *
+     * @returns Number of strings parsed successfully.
+     */
+    inline std::size_t parse_uuids(const std::string_view* input, std::size_t count, uuid* output, bitmask& valid)
+    {
+#if defined(SIMDPARSE_AVX512)
+        static_assert(sizeof(uuid) == 16 && std::is_trivially_copyable_v<uuid>, "expected: uuid stored as 16 bytes");
+        if (detail::use_avx512()) {
+            valid.resize(count);
+            auto parse_one = [&](std::size_t k) {
+                if (output[k].parse(input[k])) {
+                    valid.set(k);
+                } else {
+                    output[k] = uuid();
+                }
+            };
+
+            // index of a string in the 8-4-4-4-12 format that has yet to be paired, or `count` if none
+            std::size_t pending = count;
+            for (std::size_t k = 0; k < count; ++k) {
+                if (input[k].size() != 36) {
+                    parse_one(k);
+                } else if (pending == count) {
+                    pending = k;
+                } else {
+                    SIMDPARSE_COUNT_N(uuid_calls, 2);
+                    SIMDPARSE_COUNT(uuid_pairs);
+                    const unsigned int result = detail::parse_uuid_pair(input[pending].data(), input[k].data(), output[pending], output[k]);
+                    for (std::size_t n : { pending, k }) {
+                        if (result & (n == pending ? 1 : 2)) {
+                            valid.set(n);
+                        } else {
+                            SIMDPARSE_COUNT(uuid_failures);
+                            output[n] = uuid();
+                        }
+                    }
+                    pending = count;
+                }
+            }
+            if (pending != count) {
+                parse_one(pending);
+            }
+            return valid.count();
+        }
+#endif
+        return parse_many(input, count, output, valid);
+    }
+
+    /** Parses a sequence of UUID strings into a contiguous array of `uuid` objects. */
+    inline std::size_t parse_uuids(const std::vector<std::string_view>& input, std::vector<uuid>& output, bitmask& valid)
+    {
+        output.resize(input.size());
+        return parse_uuids(input.data(), input.size(), output.data(), valid);
+    }
+
+    namespace detail
+    {
+#if defined(SIMDPARSE_AVX2)
+        /** Extracts a pair of 16-bit fields from each of eight rows of fused date-time digits. */
+        SIMDPARSE_TARGET_AVX2 inline __m256i gather_fields(const std::int16_t* rows, int index)
+        {
+            // each row consists of 16 16-bit integers, i.e. 8 32-bit integers
+            const __m256i row_offsets = _mm256_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56);
+            return _mm256_i32gather_epi32(reinterpret_cast<const int*>(rows) + index, row_offsets, 4);
+        }
+
+        /**
+         * Converts eight rows of fused date-time digits into microseconds before/after epoch.
+         *
+         * @param rows Output of `fuse_date_time_fractional` for eight date-time strings.
+         * @param offsets Time zone offset (in minutes) of each date-time string.
+         * @param output Array of eight integers to receive microseconds before/after epoch.
+         */
+        SIMDPARSE_TARGET_AVX2 inline void fields_to_microtime(const std::int16_t* rows, const std::int32_t* offsets, std::int64_t* output)
+        {
+            const __m256i lower_half = _mm256_set1_epi32(0xffff);
+
+            // YY YY | MM DD | hh mm | -- -- | ss ms | ms us | us ns
+            const __m256i year_fields = gather_fields(rows, 0);
+            const __m256i date_fields = gather_fields(rows, 1);
+            const __m256i time_fields = gather_fields(rows, 2);
+            const __m256i second_fields = gather_fields(rows, 4);
+            const __m256i milli_fields = gather_fields(rows, 5);
+            const __m256i micro_fields = gather_fields(rows, 6);
+
+            const __m256i year = _mm256_madd_epi16(year_fields, _mm256_set1_epi32(0x00010064));  // 100 * YY + YY
+            const __m256i month = _mm256_and_si256(date_fields, lower_half);
+            const __m256i day = _mm256_srli_epi32(date_fields, 16);
+            const __m256i days = days_from_civil(year, month, day);
+
+            // seconds since midnight, adjusted with time zone offset
+            const __m256i hour_minute = _mm256_madd_epi16(time_fields, _mm256_set1_epi32(0x003c0e10));  // 3600 * hh + 60 * mm
+            const __m256i second = _mm256_and_si256(second_fields, lower_half);
+            const __m256i offset = _mm256_mullo_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)),
+                _mm256_set1_epi32(60)
+            );
+            const __m256i time_of_day = _mm256_sub_epi32(_mm256_add_epi32(hour_minute, second), offset);
+
+            // microsecond fractional part, combined from partial sums of digits
+            const __m256i milli = _mm256_add_epi32(_mm256_srli_epi32(second_fields, 16), _mm256_and_si256(milli_fields, lower_half));
+            const __m256i micro = _mm256_add_epi32(_mm256_srli_epi32(milli_fields, 16), _mm256_and_si256(micro_fields, lower_half));
+            const __m256i fraction = _mm256_add_epi32(_mm256_mullo_epi32(milli, _mm256_set1_epi32(1000)), micro);
+
+            for (int k = 0; k < 2; ++k) {
+                const __m128i days_half = k == 0 ? _mm256_castsi256_si128(days) : _mm256_extracti128_si256(days, 1);
+                const __m128i time_half = k == 0 ? _mm256_castsi256_si128(time_of_day) : _mm256_extracti128_si256(time_of_day, 1);
+                const __m128i fraction_half = k == 0 ? _mm256_castsi256_si128(fraction) : _mm256_extracti128_si256(fraction, 1);
+
+                // seconds since epoch need 64 bits
+                const __m256i seconds = _mm256_add_epi64(
+                    _mm256_mul_epi32(_mm256_cvtepi32_epi64(days_half), _mm256_set1_epi64x(86'400)),
+                    _mm256_cvtepi32_epi64(time_half)
+                );
+
+                // multiply 64-bit integers by splitting into 32-bit halves (two's complement arithmetic modulo 2^64)
+                const __m256i scale = _mm256_set1_epi64x(1'000'000);
+                const __m256i low = _mm256_mul_epu32(seconds, scale);
+                const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(seconds, 32), scale);
+                const __m256i micros = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+
+                // fractional part follows the sign of the timestamp, as in `microtime::assign`
+                const __m256i us = _mm256_cvtepi32_epi64(fraction_half);
+                const __m256i is_non_negative = _mm256_cmpgt_epi64(micros, _mm256_set1_epi64x(-1));
+                const __m256i signed_us = _mm256_blendv_epi8(_mm256_sub_epi64(_mm256_setzero_si256(), us), us, is_non_negative);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 4 * k), _mm256_add_epi64(micros, signed_us));
+            }
+        }
+
+        /**
+         * Parses groups of eight date-time strings of the same shape with SIMD instructions, as in
+         * `parse_microtime_column`.
+         *
+         * @returns The number of strings processed, a multiple of eight, or zero if the column has no suitable shape.
+         */
+        SIMDPARSE_TARGET_AVX2 inline std::size_t parse_microtime_column_simd(const char* input, std::size_t length, std::size_t stride, std::size_t count, std::int64_t* output, bitmask& valid)
+        {
+            // time zone designator shared by all date-time strings in the column
+            const tz_designator time_zone = length >= 19 ? detect_tz_designator(std::string_view(input, length)) : tz_designator::none;
+            const std::size_t naive_length = length - tz_designator_length(time_zone);
+            if (length < 19 || naive_length < 19 || naive_length > 29 || naive_length == 20) {
+                return 0;
+            }
+
+            alignas(__m256i) std::array<std::int16_t, 8 * 16> rows;
+            alignas(__m256i) std::array<std::int32_t, 8> offsets;
+            alignas(__m256i) std::array<char, 32> buf;
+
+            // fractional part separator and padding is the same for all rows
+            std::memset(buf.data(), '0', buf.size());
+            buf[19] = '.';
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                unsigned int lanes = 0;
+                for (std::size_t k = 0; k < 8; ++k) {
+                    const char* str = input + (i + k) * stride;
+
+                    tzoffset offset;
+                    if (detect_tz_designator(std::string_view(str, length)) != time_zone) {
+                        continue;
+                    }
+                    if (time_zone == tz_designator::offset && !offset.parse(std::string_view(str + naive_length, 6))) {
+                        continue;
+                    }
+                    offsets[k] = offset.minutes();
+
+                    std::memcpy(buf.data(), str, naive_length);
+                    const __m256i characters = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf.data()));
+                    __m256i values;
+                    if (!fuse_date_time_fractional(characters, values)) {
+                        continue;
+                    }
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(rows.data() + 16 * k), values);
+                    lanes |= 1u << k;
+                }
+
+                if (lanes != 0xff) {
+                    // clear rows that failed to parse such that they produce a well-defined result
+                    for (std::size_t k = 0; k < 8; ++k) {
+                        if (!(lanes & (1u << k))) {
+                            std::memset(rows.data() + 16 * k, 0, 16 * sizeof(std::int16_t));
+                            offsets[k] = 0;
+                        }
+                    }
+                }
+
+                fields_to_microtime(rows.data(), offsets.data(), output + i);
+
+                // parse strings one by one that have not matched the shape of the column
+                for (std::size_t k = 0; k < 8; ++k) {
+                    if (lanes & (1u << k)) {
+                        valid.set(i + k);
+                        continue;
+                    }
+                    microtime ts;
+                    if (ts.parse(std::string_view(input + (i + k) * stride, length))) {
+                        output[i + k] = ts.value();
+                        valid.set(i + k);
+                    } else {
+                        output[i + k] = microtime::UNSET;
+                    }
+                }
+            }
+            return i;
+        }
+#endif
+    }
+
+    /**
+     * Parses a column of RFC 3339 date-time strings of the same length into microseconds before/after epoch.
+     *
+     * The time zone designator (`Z`, `+hh:mm`, ` UTC` or none) and the number of fractional digits is expected to be
+     * the same for all strings in the column, as determined by the first string. Date-time strings are validated and
+     * their digits fused with SIMD instructions, and eight timestamps are converted into microseconds at once without
+     * calling `timegm`. Strings that deviate from the shape of the first string are parsed one by one.
+     *
+     * @param input Pointer to the first character of the first string.
+     * @param length Length of each string.
+     * @param stride Distance between the first characters of consecutive strings, at least `length`.
+     * @param count Number of strings.
+     * @param output Array of `count` integers to receive microseconds before/after epoch, or `microtime::UNSET`.
+     * @param valid Validity mask with bit `k` set if the `k`-th string has been parsed successfully.
+     * @returns Number of strings parsed successfully.
+     */
+    inline std::size_t parse_microtime_column(const char* input, std::size_t length, std::size_t stride, std::size_t count, std::int64_t* output, bitmask& valid)
+    {
+        valid.resize(count);
+        if (count == 0) {
+            return 0;
+        }
+
+        std::size_t i = 0;
+
+#if defined(SIMDPARSE_AVX2)
+        if (detail::use_avx2()) {
+            i = detail::parse_microtime_column_simd(input, length, stride, count, output, valid);
+        }
+#endif
+
+        for (; i < count; ++i) {
+            microtime ts;
+            if (ts.parse(std::string_view(input + i * stride, length))) {
+                output[i] = ts.value();
+                valid.set(i);
+            } else {
+                output[i] = microtime::UNSET;
+            }
+        }
+
+        return valid.count();
+    }
+
+#if defined(SIMDPARSE_AVX2)
+    namespace detail
+    {
+        /**
+         * Splits eight timestamps into days since epoch and seconds since midnight.
+         *
+         * @returns A mask with bit `k` set if the `k`-th timestamp is within the range of the vectorized conversion.
+         */
+        inline unsigned int split_microtime_block(const std::int64_t* input, std::int32_t* days, std::int32_t* seconds)
+        {
+            constexpr std::int64_t min_days = -(719'468 + 146'097 * civil_from_days_eras);
+            constexpr std::int64_t max_days = 0x7fffffff + min_days;
+
+            unsigned int lanes = 0;
+            for (std::size_t k = 0; k < 8; ++k) {
+                const microtime ts(input[k]);
+                std::int64_t d = 0;
+                unsigned int s = 0;
+                ts.as_days(d, s);
+                bool in_range = !ts.undefined() && d >= min_days && d < max_days;
+                days[k] = in_range ? static_cast<std::int32_t>(d) : 0;
+                seconds[k] = static_cast<std::int32_t>(s);
+                lanes |= static_cast<unsigned int>(in_range) << k;
+            }
+            return lanes;
+        }
+
+        /**
+         * Converts groups of eight timestamps into dates with SIMD instructions, as in `as_date_column`.
+         *
+         * @returns The number of timestamps converted, a multiple of eight.
+         */
+        SIMDPARSE_TARGET_AVX2 inline std::size_t as_date_column_simd(const std::int64_t* input, std::size_t count, date* output)
+        {
+            alignas(__m256i) std::array<std::int32_t, 8> days;
+            alignas(__m256i) std::array<std::int32_t, 8> seconds;
+            alignas(__m256i) std::array<std::int32_t, 8> years;
+            alignas(__m256i) std::array<std::int32_t, 8> months;
+            alignas(__m256i) std::array<std::int32_t, 8> month_days;
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                unsigned int lanes = split_microtime_block(input + i, days.data(), seconds.data());
+
+                __m256i year;
+                __m256i month;
+                __m256i day;
+                civil_from_days(_mm256_load_si256(reinterpret_cast<const __m256i*>(days.data())), year, month, day);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(years.data()), year);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(months.data()), month);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(month_days.data()), day);
+
+                for (std::size_t k = 0; k < 8; ++k) {
+                    if (lanes & (1u << k)) {
+                        output[i + k] = date(years[k], static_cast<unsigned int>(months[k]), static_cast<unsigned int>(month_days[k]));
+                    } else {
+                        output[i + k] = microtime(input[i + k]).as_date();
+                    }
+                }
+            }
+            return i;
+        }
+
+        /**
+         * Converts groups of eight timestamps into date-time values with SIMD instructions, as in `as_datetime_column`.
+         *
+         * @returns The number of timestamps converted, a multiple of eight.
+         */
+        SIMDPARSE_TARGET_AVX2 inline std::size_t as_datetime_column_simd(const std::int64_t* input, std::size_t count, datetime* output)
+        {
+            alignas(__m256i) std::array<std::int32_t, 8> days;
+            alignas(__m256i) std::array<std::int32_t, 8> seconds;
+            alignas(__m256i) std::array<std::int32_t, 8> years;
+            alignas(__m256i) std::array<std::int32_t, 8> months;
+            alignas(__m256i) std::array<std::int32_t, 8> month_days;
+            alignas(__m256i) std::array<std::int32_t, 8> hours;
+            alignas(__m256i) std::array<std::int32_t, 8> minutes;
+            alignas(__m256i) std::array<std::int32_t, 8> secs;
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                unsigned int lanes = split_microtime_block(input + i, days.data(), seconds.data());
+
+                __m256i year;
+                __m256i month;
+                __m256i day;
+                civil_from_days(_mm256_load_si256(reinterpret_cast<const __m256i*>(days.data())), year, month, day);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(years.data()), year);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(months.data()), month);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(month_days.data()), day);
+
+                // split seconds since midnight into hours, minutes and seconds
+                const __m256i time_of_day = _mm256_load_si256(reinterpret_cast<const __m256i*>(seconds.data()));
+                const __m256i hour = divide_epu32<3'600>(time_of_day);
+                const __m256i minute_second = _mm256_sub_epi32(time_of_day, _mm256_mullo_epi32(hour, _mm256_set1_epi32(3'600)));
+                const __m256i minute = divide_epu32<60>(minute_second);
+                const __m256i second = _mm256_sub_epi32(minute_second, _mm256_mullo_epi32(minute, _mm256_set1_epi32(60)));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(hours.data()), hour);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(minutes.data()), minute);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(secs.data()), second);
+
+                for (std::size_t k = 0; k < 8; ++k) {
+                    if (lanes & (1u << k)) {
+                        output[i + k] = datetime(
+                            years[k],
+                            static_cast<unsigned int>(months[k]),
+                            static_cast<unsigned int>(month_days[k]),
+                            static_cast<unsigned int>(hours[k]),
+                            static_cast<unsigned int>(minutes[k]),
+                            static_cast<unsigned int>(secs[k]),
+                            1000 * microtime(input[i + k]).microseconds()
+                        );
+                    } else {
+                        output[i + k] = microtime(input[i + k]).as_datetime();
+                    }
+                }
+            }
+            return i;
+        }
+    }
+#endif
+
+    /**
+     * Converts a column of timestamps (in microseconds before/after epoch) into Gregorian calendar dates.
+     *
+     * Equivalent to calling `microtime::as_date` for each timestamp, with eight dates calculated at once.
+     */
+    inline void as_date_column(const std::int64_t* input, std::size_t count, date* output)
+    {
+        std::size_t i = 0;
+
+#if defined(SIMDPARSE_AVX2)
+        if (detail::use_avx2()) {
+            i = detail::as_date_column_simd(input, count, output);
+        }
+#endif
+
+        for (; i < count; ++i) {
+            output[i] = microtime(input[i]).as_date();
+        }
+    }
+
+    /**
+     * Converts a column of timestamps (in microseconds before/after epoch) into Gregorian calendar dates and UTC time.
+     *
+     * Equivalent to calling `microtime::as_datetime` for each timestamp, with eight date-time values calculated at once.
+     */
+    inline void as_datetime_column(const std::int64_t* input, std::size_t count, datetime* output)
+    {
+        std::size_t i = 0;
+
+#if defined(SIMDPARSE_AVX2)
+        if (detail::use_avx2()) {
+            i = detail::as_datetime_column_simd(input, count, output);
+        }
+#endif
+
+        for (; i < count; ++i) {
+            output[i] = microtime(input[i]).as_datetime();
+        }
+    }
+}
@@ -0,0 +1,510 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "batch.hpp"
+#include "datetime.hpp"
+#include "dispatch.hpp"
+#include "network.hpp"
+#include "uuid.hpp"
+#include <array>
+#include <bitset>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace simdparse
+{
+    namespace detail
+    {
+        /** Sets bit `k` of a word if value `k` of a block falls into a closed range, starting at value `from`. */
+        inline std::uint64_t select_range_bits(const std::int64_t* values, std::size_t from, std::size_t block, std::int64_t lower, std::int64_t upper, std::uint64_t word)
+        {
+            for (std::size_t k = from; k < block; ++k) {
+                const std::int64_t v = values[k];
+                word |= std::uint64_t(lower <= v && v <= upper) << k;
+            }
+            return word;
+        }
+
+        /** Sets bit `k` of a word if 16-byte value `k` of a block matches a key in the bits of a mask, starting at value `from`. */
+        inline std::uint64_t select_masked_equal_bits(const std::uint8_t* items, std::size_t from, std::size_t block, const std::uint8_t* masked_key, const std::uint8_t* mask, std::uint64_t word)
+        {
+            for (std::size_t k = from; k < block; ++k) {
+                const std::uint8_t* item = items + 16 * k;
+                bool match = true;
+                for (std::size_t b = 0; b < 16; ++b) {
+                    match &= (item[b] & mask[b]) == masked_key[b];
+                }
+                word |= std::uint64_t(match) << k;
+            }
+            return word;
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Selects the values that fall into a closed range, four values at a time. */
+        SIMDPARSE_TARGET_AVX2 inline void select_range_simd(const std::int64_t* values, std::size_t count, std::int64_t lower, std::int64_t upper, const std::uint64_t* valid, std::uint64_t* words)
+        {
+            const __m256i lower_bound = _mm256_set1_epi64x(lower);
+            const __m256i upper_bound = _mm256_set1_epi64x(upper);
+
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                std::uint64_t word = 0;
+                std::size_t k = 0;
+                for (; k + 4 <= block; k += 4) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + k));
+                    const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(lower_bound, v), _mm256_cmpgt_epi64(v, upper_bound));
+                    const unsigned int inside = ~static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(outside))) & 0xf;
+                    word |= std::uint64_t(inside) << k;
+                }
+                words[i / 64] = select_range_bits(values + i, k, block, lower, upper, word) & valid[i / 64];
+            }
+        }
+
+        /** Selects the 16-byte values that match a key in the bits given by a mask, two values at a time. */
+        SIMDPARSE_TARGET_AVX2 inline void select_masked_equal_simd(const std::uint8_t* items, std::size_t count, const std::uint8_t* masked_key, const std::uint8_t* mask, const std::uint64_t* valid, std::uint64_t* words)
+        {
+            // two values per 256-bit register
+            const __m256i key_pair = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masked_key)));
+            const __m256i mask_pair = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask)));
+
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                std::uint64_t word = 0;
+                std::size_t k = 0;
+                for (; k + 2 <= block; k += 2) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + 16 * (i + k)));
+                    const unsigned int equal = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(v, mask_pair), key_pair)));
+                    const unsigned int matches = static_cast<unsigned int>((equal & 0xffff) == 0xffff) | (static_cast<unsigned int>((equal >> 16) == 0xffff) << 1);
+                    word |= std::uint64_t(matches) << k;
+                }
+                words[i / 64] = select_masked_equal_bits(items + 16 * i, k, block, masked_key, mask, word) & valid[i / 64];
+            }
+        }
+#elif defined(SIMDPARSE_NEON)
+        /** Selects the values that fall into a closed range, two values at a time. */
+        inline void select_range_simd(const std::int64_t* values, std::size_t count, std::int64_t lower, std::int64_t upper, const std::uint64_t* valid, std::uint64_t* words)
+        {
+            const int64x2_t lower_bound = vdupq_n_s64(lower);
+            const int64x2_t upper_bound = vdupq_n_s64(upper);
+
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                std::uint64_t word = 0;
+                std::size_t k = 0;
+                for (; k + 2 <= block; k += 2) {
+                    const int64x2_t v = vld1q_s64(values + i + k);
+                    const uint64x2_t inside = vandq_u64(vcgeq_s64(v, lower_bound), vcleq_s64(v, upper_bound));
+                    const std::uint64_t matches = (vgetq_lane_u64(inside, 0) & 1) | (vgetq_lane_u64(inside, 1) & 2);
+                    word |= matches << k;
+                }
+                words[i / 64] = select_range_bits(values + i, k, block, lower, upper, word) & valid[i / 64];
+            }
+        }
+
+        /** Selects the 16-byte values that match a key in the bits given by a mask, one value at a time. */
+        inline void select_masked_equal_simd(const std::uint8_t* items, std::size_t count, const std::uint8_t* masked_key, const std::uint8_t* mask, const std::uint64_t* valid, std::uint64_t* words)
+        {
+            const uint8x16_t key_bits = vld1q_u8(masked_key);
+            const uint8x16_t mask_bits = vld1q_u8(mask);
+
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                std::uint64_t word = 0;
+                for (std::size_t k = 0; k < block; ++k) {
+                    const uint8x16_t v = vld1q_u8(items + 16 * (i + k));
+                    const bool match = vminvq_u8(vceqq_u8(vandq_u8(v, mask_bits), key_bits)) == 0xff;
+                    word |= std::uint64_t(match) << k;
+                }
+                words[i / 64] = word & valid[i / 64];
+            }
+        }
+#endif
+
+        /**
+         * Selects the values that fall into a closed range.
+         *
+         * @param values Array of `count` integers.
+         * @param valid Validity mask of the values; values with a cleared bit are never selected.
+         * @param words Array of `(count + 63) / 64` words to receive the selection mask.
+         */
+        inline void select_range(const std::int64_t* values, std::size_t count, std::int64_t lower, std::int64_t upper, const std::uint64_t* valid, std::uint64_t* words)
+        {
+#if defined(SIMDPARSE_SIMD)
+            if (use_simd()) {
+                select_range_simd(values, count, lower, upper, valid, words);
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                words[i / 64] = select_range_bits(values + i, 0, block, lower, upper, 0) & valid[i / 64];
+            }
+        }
+
+        /**
+         * Selects the 16-byte values that match a key in the bits given by a mask.
+         *
+         * @param items Array of `count` values of 16 bytes each, stored back to back.
+         * @param key Value to compare against, 16 bytes.
+         * @param mask Bits of the value to compare, 16 bytes.
+         * @param valid Validity mask of the values; values with a cleared bit are never selected.
+         * @param words Array of `(count + 63) / 64` words to receive the selection mask.
+         */
+        inline void select_masked_equal(const std::uint8_t* items, std::size_t count, const std::uint8_t* key, const std::uint8_t* mask, const std::uint64_t* valid, std::uint64_t* words)
+        {
+            std::array<std::uint8_t, 16> masked_key;
+            for (std::size_t b = 0; b < 16; ++b) {
+                masked_key[b] = key[b] & mask[b];
+            }
+
+#if defined(SIMDPARSE_SIMD)
+            if (use_simd()) {
+                select_masked_equal_simd(items, count, masked_key.data(), mask, valid, words);
+                return;
+            }
+#endif
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                words[i / 64] = select_masked_equal_bits(items + 16 * i, 0, block, masked_key.data(), mask, 0) & valid[i / 64];
+            }
+        }
+
+        /** Appends the first `count` bits of a mask to another mask. */
+        inline void append_bits(bitmask& target, const bitmask& source, std::size_t count)
+        {
+            for (std::size_t k = 0; k < count; ++k) {
+                target.push_back(source.test(k));
+            }
+        }
+    }
+
+    /**
+     * A column of date-time values, stored as microseconds before/after epoch and a time zone offset.
+     *
+     * Each value takes 10 bytes in two separate arrays, as opposed to the 40 bytes of a `datetime` object, such that
+     * filters only read the timestamps they compare. Precision is limited to microseconds.
+     */
+    struct datetime_column
+    {
+        /** Number of values in the column. */
+        std::size_t size() const
+        {
+            return _micros.size();
+        }
+
+        void reserve(std::size_t count)
+        {
+            _micros.reserve(count);
+            _offsets.reserve(count);
+        }
+
+        void clear()
+        {
+            _micros.clear();
+            _offsets.clear();
+            _valid.clear();
+        }
+
+        /**
+         * Parses a sequence of date-time strings, and appends the results to the end of the column.
+         *
+         * Strings are parsed in blocks of 64 like with `parse_many`, and each block is packed into the column while
+         * still in cache. Values that fail to parse are stored as `microtime::UNSET`.
+         *
+         * @returns Number of strings parsed successfully.
+         */
+        std::size_t append(const std::string_view* input, std::size_t count)
+        {
+            const std::size_t base = size();
+            _micros.resize(base + count);
+            _offsets.resize(base + count);
+
+            std::array<datetime, 64> values;
+            std::size_t success = 0;
+            for (std::size_t i = 0; i < count; i += 64) {
+                const std::size_t block = count - i < 64 ? count - i : 64;
+                const std::uint64_t word = detail::parse_block(input + i, block, values.data());
+                for (std::size_t k = 0; k < block; ++k) {
+                    const bool valid = (word >> k) & 1;
+                    const datetime& dt = values[k];
+                    _micros[base + i + k] = valid ? microtime(dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second, dt.nanosecond / 1'000, dt.offset).value() : microtime::UNSET;
+                    _offsets[base + i + k] = static_cast<std::int16_t>(dt.offset.minutes());
+                    _valid.push_back(valid);
+                }
+                success += std::bitset<64>(word).count();
+            }
+            return success;
+        }
+
+        /** Parses a sequence of date-time strings, and appends the results to the end of the column. */
+        std::size_t append(const std::vector<std::string_view>& input)
+        {
+            return append(input.data(), input.size());
+        }
+
+        /** Time instant of the `k`-th value. */
+        microtime time(std::size_t k) const
+        {
+            return microtime(_micros[k]);
+        }
+
+        /** Time zone offset of the `k`-th value. */
+        tzoffset offset(std::size_t k) const
+        {
+            tzoffset offset;
+            offset.assign(_offsets[k]);
+            return offset;
+        }
+
+        /** Reconstructs the `k`-th value in its original time zone, or a default-constructed object if not valid. */
+        datetime operator[](std::size_t k) const
+        {
+            if (!_valid.test(k)) {
+                return datetime();
+            }
+
+            // shift the seconds part to local time, and keep the fractional part with the sign of the timestamp
+            const microtime ts = time(k);
+            const std::int64_t seconds = ts.value() / 1'000'000 + 60 * static_cast<std::int64_t>(_offsets[k]);
+            const std::int64_t value = seconds * 1'000'000;
+            const std::int64_t fraction = static_cast<std::int64_t>(ts.microseconds());
+
+            datetime dt = microtime(value >= 0 ? value + fraction : value - fraction).as_datetime();
+            dt.offset = offset(k);
+            return dt;
+        }
+
+        /** Microseconds before/after epoch for each value. */
+        const std::int64_t* micros() const
+        {
+            return _micros.data();
+        }
+
+        /** Time zone offset (in minutes) for each value. */
+        const std::int16_t* offsets() const
+        {
+            return _offsets.data();
+        }
+
+        /** Validity mask with bit `k` set if the `k`-th value has been parsed successfully. */
+        const bitmask& valid() const
+        {
+            return _valid;
+        }
+
+        /** Selects valid values with a time instant in the closed range `[lower, upper]`. */
+        bitmask between(const microtime& lower, const microtime& upper) const
+        {
+            bitmask result(size());
+            detail::select_range(_micros.data(), size(), lower.value(), upper.value(), _valid.data(), result.data());
+            return result;
+        }
+
+        /** Selects valid values with a time instant strictly before the given time instant. */
+        bitmask before(const microtime& ts) const
+        {
+            if (ts.value() == std::numeric_limits<std::int64_t>::min()) {
+                return bitmask(size());
+            }
+            return between(microtime(std::numeric_limits<std::int64_t>::min()), microtime(ts.value() - 1));
+        }
+
+        /** Selects valid values with a time instant strictly after the given time instant. */
+        bitmask after(const microtime& ts) const
+        {
+            if (ts.value() == std::numeric_limits<std::int64_t>::max()) {
+                return bitmask(size());
+            }
+            return between(microtime(ts.value() + 1), microtime(std::numeric_limits<std::int64_t>::max()));
+        }
+
+    private:
+        std::vector<std::int64_t> _micros;
+        std::vector<std::int16_t> _offsets;
+        bitmask _valid;
+    };
+
+    /**
+     * A column of UUIDs, stored back to back in 16 bytes each.
+     *
+     * The default allocator of 64-bit targets aligns arrays to 16 bytes, so each value starts at a 16-byte boundary.
+     */
+    struct uuid_column
+    {
+        static_assert(sizeof(uuid) == 16 && std::is_trivially_copyable_v<uuid>, "expected: uuid stored as 16 bytes");
+
+        /** Number of values in the column. */
+        std::size_t size() const
+        {
+            return _items.size();
+        }
+
+        void reserve(std::size_t count)
+        {
+            _items.reserve(count);
+        }
+
+        void clear()
+        {
+            _items.clear();
+            _valid.clear();
+        }
+
+        /**
+         * Parses a sequence of UUID strings with `parse_uuids`, and appends the results to the end of the column.
+         *
+         * @returns Number of strings parsed successfully.
+         */
+        std::size_t append(const std::string_view* input, std::size_t count)
+        {
+            const std::size_t base = size();
+            _items.resize(base + count);
+            bitmask valid;
+            const std::size_t success = parse_uuids(input, count, _items.data() + base, valid);
+            detail::append_bits(_valid, valid, count);
+            return success;
+        }
+
+        /** Parses a sequence of UUID strings, and appends the results to the end of the column. */
+        std::size_t append(const std::vector<std::string_view>& input)
+        {
+            return append(input.data(), input.size());
+        }
+
+        const uuid& operator[](std::size_t k) const
+        {
+            return _items[k];
+        }
+
+        const uuid* data() const
+        {
+            return _items.data();
+        }
+
+        /** Validity mask with bit `k` set if the `k`-th value has been parsed successfully. */
+        const bitmask& valid() const
+        {
+            return _valid;
+        }
+
+        /** Selects valid values equal to the given UUID, comparing two values at a time. */
+        bitmask equal(const uuid& id) const
+        {
+            constexpr std::array<std::uint8_t, 16> all_bits = {
+                0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+            };
+            bitmask result(size());
+            detail::select_masked_equal(reinterpret_cast<const std::uint8_t*>(_items.data()), size(), id.data(), all_bits.data(), _valid.data(), result.data());
+            return result;
+        }
+
+    private:
+        std::vector<uuid> _items;
+        bitmask _valid;
+    };
+
+    /**
+     * A column of IPv6 addresses, stored back to back in 16 bytes each.
+     *
+     * The default allocator of 64-bit targets aligns arrays to 16 bytes, so each value starts at a 16-byte boundary.
+     */
+    struct ipv6_column
+    {
+        static_assert(sizeof(ipv6_addr) == 16 && std::is_trivially_copyable_v<ipv6_addr>, "expected: IPv6 address stored as 16 bytes");
+
+        /** Number of values in the column. */
+        std::size_t size() const
+        {
+            return _items.size();
+        }
+
+        void reserve(std::size_t count)
+        {
+            _items.reserve(count);
+        }
+
+        void clear()
+        {
+            _items.clear();
+            _valid.clear();
+        }
+
+        /**
+         * Parses a sequence of IPv6 address strings with `parse_many`, and appends the results to the end of the column.
+         *
+         * @returns Number of strings parsed successfully.
+         */
+        std::size_t append(const std::string_view* input, std::size_t count)
+        {
+            const std::size_t base = size();
+            _items.resize(base + count);
+            bitmask valid;
+            const std::size_t success = parse_many(input, count, _items.data() + base, valid);
+            detail::append_bits(_valid, valid, count);
+            return success;
+        }
+
+        /** Parses a sequence of IPv6 address strings, and appends the results to the end of the column. */
+        std::size_t append(const std::vector<std::string_view>& input)
+        {
+            return append(input.data(), input.size());
+        }
+
+        const ipv6_addr& operator[](std::size_t k) const
+        {
+            return _items[k];
+        }
+
+        const ipv6_addr* data() const
+        {
+            return _items.data();
+        }
+
+        /** Validity mask with bit `k` set if the `k`-th value has been parsed successfully. */
+        const bitmask& valid() const
+        {
+            return _valid;
+        }
+
+        /** Selects valid values equal to the given address. */
+        bitmask equal(const ipv6_addr& addr) const
+        {
+            return in_network(ipv6_network(addr, 128));
+        }
+
+        /** Selects valid values that belong to the given network, comparing two addresses at a time. */
+        bitmask in_network(const ipv6_network& network) const
+        {
+            std::array<std::uint8_t, 16> mask = {};
+            for (unsigned int b = 0; b < 16; ++b) {
+                const unsigned int bits = network.prefix_length() > 8 * b ? network.prefix_length() - 8 * b : 0;
+                mask[b] = bits >= 8 ? 0xff : static_cast<std::uint8_t>(0xff00 >> bits);
+            }
+            bitmask result(size());
+            detail::select_masked_equal(reinterpret_cast<const std::uint8_t*>(_items.data()), size(), network.address().data(), mask.data(), _valid.data(), result.data());
+            return result;
+        }
+
+    private:
+        std::vector<ipv6_addr> _items;
+        bitmask _valid;
+    };
+}
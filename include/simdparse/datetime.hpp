@@ -10,6 +10,7 @@
 
 #pragma once
 #include <array>
+#include <functional>
 #include <limits>
 #include <string_view>
 #include <charconv>
@@ -17,13 +18,14 @@
 #include <cstring>
 #include <ctime>
 #include <cassert>
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+#include "stats.hpp"
 
-#if defined(_WIN32) || defined(_WIN64)
-#define timegm _mkgmtime
-#endif
-
-#if defined(__AVX2__)
+#if defined(SIMDPARSE_AVX2)
 #include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
 #endif
 
  // check if 64-bit SSE2 instructions are available
@@ -42,8 +44,434 @@ namespace simdparse
             return result.ec == std::errc{} && result.ptr == str.data() + end;
 
         }
+
+        /**
+         * Number of days since 1970-01-01 for a date in the proleptic Gregorian calendar.
+         *
+         * Uses the 400-year periodicity of the Gregorian calendar, with years starting on March 1 such that the leap
+         * day falls on the last day of the year.
+         *
+         * @see https://howardhinnant.github.io/date_algorithms.html#days_from_civil
+         */
+        constexpr std::int64_t days_from_civil(int year, unsigned int month, unsigned int day)
+        {
+            const int y = year - (month <= 2);
+            const int era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned int yoe = static_cast<unsigned int>(y - era * 400);  // [0, 399]
+            const unsigned int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;  // [0, 365]
+            const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;  // [0, 146096]
+            return static_cast<std::int64_t>(era) * 146'097 + static_cast<std::int64_t>(doe) - 719'468;
+        }
+
+        /**
+         * Converts the number of days since 1970-01-01 into a date in the proleptic Gregorian calendar.
+         *
+         * Inverse of `days_from_civil`. Reentrant and free of time zone state, as opposed to `gmtime`.
+         *
+         * @see https://howardhinnant.github.io/date_algorithms.html#civil_from_days
+         */
+        constexpr void civil_from_days(std::int64_t days, int& year, unsigned int& month, unsigned int& day)
+        {
+            const std::int64_t z = days + 719'468;
+            const std::int64_t era = (z >= 0 ? z : z - 146'096) / 146'097;
+            const unsigned int doe = static_cast<unsigned int>(z - era * 146'097);  // [0, 146096]
+            const unsigned int yoe = (doe - doe / 1'460 + doe / 36'524 - doe / 146'096) / 365;  // [0, 399]
+            const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);  // [0, 365]
+            const unsigned int mp = (5 * doy + 2) / 153;  // [0, 11]
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<int>(static_cast<std::int64_t>(yoe) + era * 400) + (month <= 2);
+        }
+
+        /** Floor of the base 2 logarithm. */
+        constexpr unsigned int log2_floor(std::uint32_t value)
+        {
+            unsigned int n = 0;
+            while (value >>= 1) {
+                ++n;
+            }
+            return n;
+        }
     }
 
+    /** Time zone designator of a date-time string with a layout known at compile time. */
+    enum class tz_designator
+    {
+        none,  // 1984-10-24 23:59:59
+        zulu,  // 1984-10-24 23:59:59Z
+        offset,  // 1984-10-24 23:59:59+01:00
+        utc  // 1984-10-24 23:59:59 UTC
+    };
+
+    /**
+     * Layout of an RFC 3339 date-time string known at compile time.
+     *
+     * Passed as a tag to `datetime::parse` to skip detecting the layout of each string, e.g.
+     * `datetime_format<'T', 6, tz_designator::zulu>` for `1984-10-24T23:59:59.123456Z`.
+     *
+     * @tparam Separator Date and time separator, either `T` or a space.
+     * @tparam FractionalDigits Number of fractional digits between 0 and 9, where 0 means no fractional part.
+     * @tparam TimeZone Time zone designator.
+     */
+    template<char Separator, unsigned int FractionalDigits, tz_designator TimeZone>
+    struct datetime_format
+    {
+        static_assert(Separator == 'T' || Separator == ' ', "expected: date and time separator `T` or space");
+        static_assert(FractionalDigits <= 9, "expected: at most 9 fractional digits");
+
+        constexpr static char separator = Separator;
+        constexpr static unsigned int fractional_digits = FractionalDigits;
+        constexpr static tz_designator time_zone = TimeZone;
+
+        /** Position of the time zone designator. */
+        constexpr static std::size_t suffix_offset = 19 + (FractionalDigits > 0 ? FractionalDigits + 1 : 0);
+
+        /** Length of a date-time string in this format. */
+        constexpr static std::size_t size = suffix_offset
+            + (TimeZone == tz_designator::zulu ? 1 : TimeZone == tz_designator::offset ? 6 : TimeZone == tz_designator::utc ? 4 : 0);
+    };
+
+    namespace detail
+    {
+        /**
+         * Detects the time zone designator at the end of a date-time string.
+         *
+         * The string must be at least 6 characters long. Only the position of the designator is checked; its contents
+         * are validated when parsed.
+         */
+        inline tz_designator detect_tz_designator(const std::string_view& str)
+        {
+            if (str.back() == 'Z') {
+                return tz_designator::zulu;
+            }
+            const char offset_sign = str[str.size() - 6];
+            if (offset_sign == '+' || offset_sign == '-') {
+                return tz_designator::offset;
+            }
+            if (std::memcmp(" UTC", str.data() + str.size() - 4, 4) == 0) {
+                return tz_designator::utc;
+            }
+            return tz_designator::none;
+        }
+
+        /** Number of characters a time zone designator occupies at the end of a date-time string. */
+        constexpr std::size_t tz_designator_length(tz_designator time_zone)
+        {
+            switch (time_zone) {
+            case tz_designator::zulu:
+                return 1;
+            case tz_designator::offset:
+                return 6;
+            case tz_designator::utc:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * Byte-wise bounds and masks for validating a date-time string in a format known at compile time.
+         *
+         * Covers the first 32 characters of the string, with bytes past the end of the string expected to be zero.
+         */
+        template<typename Format>
+        struct datetime_format_layout
+        {
+            constexpr static std::array<char, 32> make_bounds(bool upper)
+            {
+                std::array<char, 32> bounds = {};
+                const std::string_view date_time = upper ? "9999-19-39T29:59:59" : "0000-00-00T00:00:00";
+                for (std::size_t k = 0; k < date_time.size(); ++k) {
+                    bounds[k] = date_time[k];
+                }
+                bounds[10] = Format::separator;
+
+                if (Format::fractional_digits > 0) {
+                    bounds[19] = '.';
+                    for (std::size_t k = 0; k < Format::fractional_digits; ++k) {
+                        bounds[20 + k] = upper ? '9' : '0';
+                    }
+                }
+
+                std::string_view suffix;
+                switch (Format::time_zone) {
+                case tz_designator::none:
+                    break;
+                case tz_designator::zulu:
+                    suffix = "Z";
+                    break;
+                case tz_designator::offset:
+                    // sign is checked separately as there is a character between `+` and `-`
+                    suffix = upper ? "-99:59" : "+00:00";
+                    break;
+                case tz_designator::utc:
+                    suffix = " UTC";
+                    break;
+                }
+                for (std::size_t k = 0; k < suffix.size() && Format::suffix_offset + k < bounds.size(); ++k) {
+                    bounds[Format::suffix_offset + k] = suffix[k];
+                }
+                return bounds;
+            }
+
+            constexpr static std::array<char, 32> make_digit_mask()
+            {
+                std::array<char, 32> mask = {};
+                constexpr std::size_t digits[] = { 0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, 17, 18 };
+                for (std::size_t k : digits) {
+                    mask[k] = 15;  // 15 = 0x0F
+                }
+                for (std::size_t k = 0; k < Format::fractional_digits; ++k) {
+                    mask[20 + k] = 15;
+                }
+                return mask;
+            }
+
+            constexpr static std::array<char, 32> lower_bound = make_bounds(false);
+            constexpr static std::array<char, 32> upper_bound = make_bounds(true);
+
+            /** Selects digits to be fused, masking out separators and the time zone designator. */
+            constexpr static std::array<char, 32> digit_mask = make_digit_mask();
+        };
+    }
+
+#if defined(SIMDPARSE_AVX2)
+    namespace detail
+    {
+        /**
+         * Fuses the digit values of a date-time string `YYYY-MM-DDThh:mm:ss.fffffffff` into 16-bit integers.
+         *
+         * Bytes other than digits must be zero. The output holds the 16-bit integers
+         * `YY YY MM DD hh mm -- -- ss ms ms us us ns ns --` where the year and the fractional parts have to be combined.
+         */
+        SIMDPARSE_TARGET_AVX2 inline __m256i fuse_date_time_digits(const __m256i& spread_integers)
+        {
+            // group spread digits `YYYY-MM-DD hh:mm:ss.fffffffff---` into packed digits `YYYYMMDDhhmm----ss-fff-fff-fff--`
+            const __m256i mask = _mm256_setr_epi8(
+                0, 1, 2, 3,  // year
+                5, 6,        // month
+                8, 9,        // day
+                11, 12,      // hour
+                14, 15,      // minute
+                -1, -1, -1, -1,
+                1, 2,        // second
+                -1,
+                4, 5, 6,     // millisecond range
+                -1,
+                7, 8, 9,     // microsecond range
+                -1,
+                10, 11, 12,  // nanosecond range
+                -1, -1
+            );
+            const __m256i packed_integers = _mm256_shuffle_epi8(spread_integers, mask);
+
+            // fuse neighboring digits into a single value
+            const __m256i weights = _mm256_setr_epi8(
+                10, 1, 10, 1,   // year
+                10, 1,          // month
+                10, 1,          // day
+                10, 1,          // hour
+                10, 1,          // minute
+                0, 0, 0, 0,
+                10, 1,          // second
+                0, 100, 10, 1,  // millisecond range
+                0, 100, 10, 1,  // microsecond range
+                0, 100, 10, 1,  // nanosecond range
+                0, 0
+            );
+            return _mm256_maddubs_epi16(packed_integers, weights);
+        }
+
+        /**
+         * Validates an RFC 3339 date-time string and fuses neighboring digits into 16-bit integers.
+         *
+         * The input is a date-time string of at most 29 characters `YYYY-MM-DDThh:mm:ss.fffffffff`, padded with
+         * the character `0` to 32 bytes. On success, the output holds the 16-bit integers
+         * `YY YY MM DD hh mm -- -- ss ms ms us us ns ns --` where the year and the fractional parts have to be combined.
+         */
+        SIMDPARSE_TARGET_AVX2 inline bool fuse_date_time_fractional(const __m256i& characters, __m256i& values)
+        {
+            // validate a 32-byte partial date-time string `YYYY-MM-DDThh:mm:ss.fffffffff---`
+            const __m256i lower_bound = _mm256_setr_epi8(
+                48, 48, 48, 48, // year; 48 = ASCII '0'
+                45,             // ASCII '-'
+                48, 48,         // month
+                45,             // ASCII '-'
+                48, 48,         // day
+                32,             // ASCII ' '
+                48, 48,         // hour
+                58,             // ASCII ':'
+                48, 48,         // minute
+                58,             // ASCII ':'
+                48, 48,         // second
+                46,             // ASCII '.'
+                48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48
+            );
+            const __m256i upper_bound = _mm256_setr_epi8(
+                57, 57, 57, 57, // year; 57 = ASCII '9'
+                45,             // ASCII '-'
+                49, 57,         // month
+                45,             // ASCII '-'
+                51, 57,         // day
+                84,             // ASCII 'T'
+                50, 57,         // hour
+                58,             // ASCII ':'
+                53, 57,         // minute
+                58,             // ASCII ':'
+                53, 57,         // second
+                46,             // ASCII '.'
+                57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57
+            );
+
+            const __m256i too_low = _mm256_cmpgt_epi8(lower_bound, characters);
+            const __m256i too_high = _mm256_cmpgt_epi8(characters, upper_bound);
+            const __m256i out_of_bounds = _mm256_or_si256(too_low, too_high);
+            if (_mm256_movemask_epi8(out_of_bounds)) {
+                return false;
+            }
+
+            // convert ASCII characters into digit value (offset from character `0`)
+            const __m256i ascii_digit_mask = _mm256_setr_epi8(
+                15, 15, 15, 15,  // year
+                0,
+                15, 15,          // month
+                0,
+                15, 15,          // day
+                0,
+                15, 15,          // hour
+                0,
+                15, 15,          // minute
+                0,
+                15, 15,          // second
+                0,
+                15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15
+            );
+            const __m256i spread_integers = _mm256_and_si256(characters, ascii_digit_mask);
+
+            values = fuse_date_time_digits(spread_integers);
+            return true;
+        }
+
+        /**
+         * Validates a date-time string with a layout known at compile time, and fuses neighboring digits into 16-bit
+         * integers.
+         *
+         * Unlike `fuse_date_time_fractional`, separators, the number of fractional digits and the time zone designator
+         * are checked against exact bounds, and characters that are not part of the date-time digits are masked out.
+         * The output has the same layout.
+         */
+        template<typename Format>
+        SIMDPARSE_TARGET_AVX2 inline bool fuse_date_time_format(const __m256i& characters, __m256i& values)
+        {
+            using layout = datetime_format_layout<Format>;
+
+            const __m256i lower_bound = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layout::lower_bound.data()));
+            const __m256i upper_bound = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layout::upper_bound.data()));
+            const __m256i too_low = _mm256_cmpgt_epi8(lower_bound, characters);
+            const __m256i too_high = _mm256_cmpgt_epi8(characters, upper_bound);
+            if (_mm256_movemask_epi8(_mm256_or_si256(too_low, too_high))) {
+                return false;
+            }
+
+            const __m256i ascii_digit_mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layout::digit_mask.data()));
+            values = fuse_date_time_digits(_mm256_and_si256(characters, ascii_digit_mask));
+            return true;
+        }
+
+        /**
+         * Divides eight unsigned 32-bit integers by a constant, which is not a power of 2.
+         *
+         * Multiplies with the reciprocal in 64-bit precision and shifts right. The result is exact for all inputs
+         * less than 2^31.
+         */
+        template<std::uint32_t Divisor>
+        SIMDPARSE_TARGET_AVX2 inline __m256i divide_epu32(const __m256i& x)
+        {
+            constexpr unsigned int shift = 32 + log2_floor(Divisor);
+            constexpr std::uint64_t multiplier = ((std::uint64_t(1) << shift) + Divisor - 1) / Divisor;
+            static_assert((Divisor & (Divisor - 1)) != 0, "use a shift to divide by a power of 2");
+            static_assert(multiplier < (std::uint64_t(1) << 32), "multiplier must fit into 32 bits");
+
+            const __m256i m = _mm256_set1_epi64x(static_cast<long long>(multiplier));
+            const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, m), shift);
+            const __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), m), shift);
+            return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+        }
+
+        /**
+         * Number of days since 1970-01-01 for eight dates with years 0 to 9999 in the Gregorian calendar.
+         *
+         * Vectorized variant of `days_from_civil`, with each member of the vector a 32-bit integer.
+         */
+        SIMDPARSE_TARGET_AVX2 inline __m256i days_from_civil(const __m256i& year, const __m256i& month, const __m256i& day)
+        {
+            // shift years to start on March 1, and add 400 years (one era) to keep values non-negative
+            const __m256i is_jan_feb = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), month);
+            const __m256i y = _mm256_add_epi32(_mm256_add_epi32(year, is_jan_feb), _mm256_set1_epi32(400));
+
+            // day of year, with March 1 as day 0
+            const __m256i is_mar_dec = _mm256_cmpgt_epi32(month, _mm256_set1_epi32(2));
+            const __m256i mp = _mm256_add_epi32(_mm256_add_epi32(month, _mm256_set1_epi32(9)), _mm256_and_si256(is_mar_dec, _mm256_set1_epi32(-12)));
+            const __m256i doy = _mm256_add_epi32(
+                divide_epu32<5>(_mm256_add_epi32(_mm256_mullo_epi32(mp, _mm256_set1_epi32(153)), _mm256_set1_epi32(2))),
+                _mm256_sub_epi32(day, _mm256_set1_epi32(1))
+            );
+
+            // 365 * y + y / 4 - y / 100 + y / 400 + doy
+            const __m256i centuries = divide_epu32<100>(y);
+            __m256i days = _mm256_mullo_epi32(y, _mm256_set1_epi32(365));
+            days = _mm256_add_epi32(days, _mm256_srli_epi32(y, 2));
+            days = _mm256_sub_epi32(days, centuries);
+            days = _mm256_add_epi32(days, _mm256_srli_epi32(centuries, 2));
+            days = _mm256_add_epi32(days, doy);
+
+            // subtract the added era, and shift origin from 0000-03-01 to 1970-01-01
+            return _mm256_sub_epi32(days, _mm256_set1_epi32(146'097 + 719'468));
+        }
+
+        /** Number of eras (400-year periods) added to day counts to keep them non-negative in `civil_from_days`. */
+        constexpr static std::int64_t civil_from_days_eras = 8;
+
+        /**
+         * Converts eight day counts since 1970-01-01 into dates in the Gregorian calendar.
+         *
+         * Vectorized variant of `civil_from_days`, with each member of the vector a 32-bit integer. Day counts
+         * must satisfy `0 <= days + 719468 + 146097 * civil_from_days_eras < 2^31`.
+         */
+        SIMDPARSE_TARGET_AVX2 inline void civil_from_days(const __m256i& days, __m256i& year, __m256i& month, __m256i& day)
+        {
+            const __m256i z = _mm256_add_epi32(days, _mm256_set1_epi32(static_cast<int>(719'468 + 146'097 * civil_from_days_eras)));
+            const __m256i era = divide_epu32<146'097>(z);
+            const __m256i doe = _mm256_sub_epi32(z, _mm256_mullo_epi32(era, _mm256_set1_epi32(146'097)));
+
+            // (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365
+            const __m256i is_last_day = _mm256_cmpeq_epi32(doe, _mm256_set1_epi32(146'096));
+            __m256i yoe = _mm256_sub_epi32(doe, divide_epu32<1'460>(doe));
+            yoe = _mm256_add_epi32(yoe, divide_epu32<36'524>(doe));
+            yoe = _mm256_add_epi32(yoe, is_last_day);
+            yoe = divide_epu32<365>(yoe);
+
+            // doe - (365 * yoe + yoe / 4 - yoe / 100)
+            __m256i doy = _mm256_mullo_epi32(yoe, _mm256_set1_epi32(365));
+            doy = _mm256_add_epi32(doy, _mm256_srli_epi32(yoe, 2));
+            doy = _mm256_sub_epi32(doy, divide_epu32<100>(yoe));
+            doy = _mm256_sub_epi32(doe, doy);
+
+            // month and day with years starting on March 1
+            const __m256i mp = divide_epu32<153>(_mm256_add_epi32(_mm256_mullo_epi32(doy, _mm256_set1_epi32(5)), _mm256_set1_epi32(2)));
+            const __m256i month_start = divide_epu32<5>(_mm256_add_epi32(_mm256_mullo_epi32(mp, _mm256_set1_epi32(153)), _mm256_set1_epi32(2)));
+            day = _mm256_add_epi32(_mm256_sub_epi32(doy, month_start), _mm256_set1_epi32(1));
+            const __m256i is_jan_feb = _mm256_cmpgt_epi32(mp, _mm256_set1_epi32(9));
+            month = _mm256_add_epi32(_mm256_add_epi32(mp, _mm256_set1_epi32(3)), _mm256_and_si256(is_jan_feb, _mm256_set1_epi32(-12)));
+
+            // subtract the added eras, and shift to years starting on January 1
+            year = _mm256_add_epi32(yoe, _mm256_mullo_epi32(era, _mm256_set1_epi32(400)));
+            year = _mm256_sub_epi32(year, _mm256_set1_epi32(static_cast<int>(400 * civil_from_days_eras)));
+            year = _mm256_sub_epi32(year, is_jan_feb);
+        }
+    }
+#endif
+
     /** Represents a date according to the Gregorian calendar. */
     struct date
     {
@@ -117,14 +545,24 @@ namespace simdparse
             return 0;
         }
 
-#if defined(__AVX2__)
     private:
-        /** Parses an RFC 3339 date string with SIMD instructions. */
-        bool parse_date(const std::string_view& str)
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Parses an RFC 3339 date string with SIMD instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool parse_date_simd(const std::string_view& str)
         {
-            alignas(__m128i) std::array<char, 16> buf;
-            std::memcpy(buf.data(), str.data(), str.size());
-            const __m128i characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            __m128i characters;
+            if constexpr (Padded) {
+                characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data()));
+            } else {
+                alignas(__m128i) std::array<char, 16> buf;
+                std::memcpy(buf.data(), str.data(), str.size());
+                characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            }
 
             // validate a date string `YYYY-MM-DD`
             const __m128i lower_bound = _mm_setr_epi8(
@@ -183,27 +621,110 @@ namespace simdparse
             day = 10 * value.c[6] + value.c[7];
             return true;
         }
-#else
-    private:
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Parses an RFC 3339 date string with NEON instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        bool parse_date_simd(const std::string_view& str)
+        {
+            uint8x16_t characters;
+            if constexpr (Padded) {
+                characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(str.data()));
+            } else {
+                alignas(16) std::array<char, 16> buf = {};
+                std::memcpy(buf.data(), str.data(), str.size());
+                characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(buf.data()));
+            }
+
+            // validate a date string `YYYY-MM-DD`
+            static constexpr std::uint8_t lower_bound[16] = {
+                48, 48, 48, 48, // year; 48 = ASCII '0'
+                45,             // ASCII '-'
+                48, 48,         // month
+                45,             // ASCII '-'
+                48, 48,         // day
+                0, 0, 0, 0, 0, 0  // don't care
+            };
+            static constexpr std::uint8_t upper_bound[16] = {
+                57, 57, 57, 57, // year; 57 = ASCII '9'
+                45,             // ASCII '-'
+                49, 57,         // month
+                45,             // ASCII '-'
+                51, 57,         // day
+                255, 255, 255, 255, 255, 255  // don't care
+            };
+
+            const uint8x16_t too_low = vcgtq_u8(vld1q_u8(lower_bound), characters);
+            const uint8x16_t too_high = vcgtq_u8(characters, vld1q_u8(upper_bound));
+            if (vmaxvq_u8(vorrq_u8(too_low, too_high)) != 0) {
+                return false;
+            }
+
+            // group digits `YYYY-MM-DD------` into packed digit values `YYYYMMDD`; out-of-range indices yield zero
+            static constexpr std::uint8_t mask[16] = {
+                0, 1, 2, 3,  // year
+                5, 6,        // month
+                8, 9,        // day
+                255, 255, 255, 255, 255, 255, 255, 255
+            };
+            const uint8x16_t grouped_integers = vqtbl1q_u8(vandq_u8(characters, vdupq_n_u8(15)), vld1q_u8(mask));
+
+            std::array<std::uint8_t, 8> value;
+            vst1_u8(value.data(), vget_low_u8(grouped_integers));
+
+            year = 1000 * value[0] + 100 * value[1] + 10 * value[2] + value[3];
+            month = 10 * value[4] + value[5];
+            day = 10 * value[6] + value[7];
+            return true;
+        }
+#endif
+
+        /** Parses an RFC 3339 date string. */
         bool parse_date(const std::string_view& str)
         {
             using detail::parse_range;
 
             // 1984-10-24
             return parse_range(str, 0, 4, year)
+                && str[4] == '-'
                 && parse_range(str, 5, 7, month) && month <= 12
+                && str[7] == '-'
                 && parse_range(str, 8, 10, day) && day <= 31
                 ;
         }
-#endif
-    public:
-        bool parse(const std::string_view& str)
+
+        template<bool Padded>
+        bool parse_iso_date(const std::string_view& str)
         {
+            SIMDPARSE_COUNT(date_calls);
             if (str.size() != 10) {
+                SIMDPARSE_COUNT(date_failures);
                 return false;
             }
 
-            return parse_date(str);
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(date_simd);
+                return SIMDPARSE_COUNT_RESULT(date_failures, parse_date_simd<Padded>(str));
+            }
+#endif
+            SIMDPARSE_COUNT(date_scalar);
+            return SIMDPARSE_COUNT_RESULT(date_failures, parse_date(str));
+        }
+
+    public:
+        bool parse(const std::string_view& str)
+        {
+            return parse_iso_date<false>(str);
+        }
+
+        /** Parses an RFC 3339 date string, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_iso_date<true>(str);
         }
 
     public:
@@ -268,7 +789,7 @@ namespace simdparse
             return _value;
         }
 
-        void assign(int minutes)
+        constexpr void assign(int minutes)
         {
             _value = minutes;
         }
@@ -464,50 +985,104 @@ namespace simdparse
         /** Parses a date-time string with an optional time zone offset. */
         bool parse(const std::string_view& str)
         {
+            return SIMDPARSE_COUNT_RESULT(datetime_failures, parse_date_time_offset<false>(str));
+        }
+
+        /** Parses a date-time string with an optional time zone offset, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return SIMDPARSE_COUNT_RESULT(datetime_failures, parse_date_time_offset<true>(str));
+        }
+
+        /**
+         * Parses a date-time string with a layout known at compile time.
+         *
+         * Strings in any other layout are rejected, even if they are valid RFC 3339 date-time strings.
+         */
+        template<char Separator, unsigned int FractionalDigits, tz_designator TimeZone>
+        bool parse(const std::string_view& str, datetime_format<Separator, FractionalDigits, TimeZone>)
+        {
+            return parse_date_time_format<datetime_format<Separator, FractionalDigits, TimeZone>, false>(str);
+        }
+
+        /** Parses a date-time string with a layout known at compile time, reading directly from the padded input. */
+        template<char Separator, unsigned int FractionalDigits, tz_designator TimeZone>
+        bool parse(const padded_string_view& str, datetime_format<Separator, FractionalDigits, TimeZone>)
+        {
+            return parse_date_time_format<datetime_format<Separator, FractionalDigits, TimeZone>, true>(str);
+        }
+
+    private:
+        template<typename Format, bool Padded>
+        bool parse_date_time_format(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(datetime_calls);
+            if (str.size() != Format::size) {
+                SIMDPARSE_COUNT(datetime_failures);
+                return false;
+            }
+
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(datetime_simd);
+                return SIMDPARSE_COUNT_RESULT(datetime_failures, (parse_date_time_format_simd<Format, Padded>(str)));
+            }
+#endif
+            SIMDPARSE_COUNT(datetime_scalar);
+            return SIMDPARSE_COUNT_RESULT(datetime_failures, str[10] == Format::separator && parse_date_time(str.substr(0, 19)) && parse_format_suffix<Format>(str));
+        }
+
+        template<bool Padded>
+        bool parse_date_time_offset(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(datetime_calls);
             if (str.size() < 19 || str.size() > 35) {
                 return false;
             }
 
-            if (str.back() == 'Z') {
+            switch (detail::detect_tz_designator(str)) {
+            case tz_designator::zulu:
+                SIMDPARSE_COUNT(datetime_zulu);
                 // 1984-10-24 23:59:59.123456789Z
                 // 1984-10-24 23:59:59.123456Z
                 // 1984-10-24 23:59:59.123Z
                 // 1984-10-24 23:59:59Z
-                if (!parse_naive_date_time(str.substr(0, str.size() - 1))) {
+                if (!parse_naive_date_time<Padded>(str.substr(0, str.size() - 1))) {
                     return false;
                 }
                 offset = tzoffset();
                 return true;
-            }
 
-            char offset_sign = str[str.size() - 6];
-            if (offset_sign == '+' || offset_sign == '-') {
+            case tz_designator::offset:
+                SIMDPARSE_COUNT(datetime_offset);
                 // 1984-10-24 23:59:59.123456789+00:00
                 // 1984-10-24 23:59:59.123456+00:00
                 // 1984-10-24 23:59:59.123+00:00
                 // 1984-10-24 23:59:59+00:00
-                if (!parse_naive_date_time(str.substr(0, str.size() - 6))) {
+                if (!parse_naive_date_time<Padded>(str.substr(0, str.size() - 6))) {
                     return false;
                 }
                 if (!offset.parse(str.substr(str.size() - 6, 6))) {
                     return false;
                 }
                 return true;
-            }
 
-            if (std::memcmp(" UTC", str.data() + str.size() - 4, 4) == 0) {
+            case tz_designator::utc:
+                SIMDPARSE_COUNT(datetime_utc);
                 // 1984-10-24 23:59:59 UTC
-                if (!parse_naive_date_time(str.substr(0, str.size() - 4))) {
+                if (!parse_naive_date_time<Padded>(str.substr(0, str.size() - 4))) {
                     return false;
                 }
                 offset = tzoffset();
                 return true;
-            } else {
+
+            default:
+                SIMDPARSE_COUNT(datetime_naive);
                 // 1984-10-24 23:59:59.123456789
                 // 1984-10-24 23:59:59.123456
                 // 1984-10-24 23:59:59.123
                 // 1984-10-24 23:59:59
-                if (!parse_naive_date_time(str)) {
+                if (!parse_naive_date_time<Padded>(str)) {
                     return false;
                 }
                 offset = tzoffset();
@@ -515,14 +1090,13 @@ namespace simdparse
             }
         }
 
-#if defined(__AVX2__)
-    private:
+#if defined(SIMDPARSE_AVX2)
         /**
          * Parses an RFC 3339 date-time string with SIMD instructions.
          *
          * @see https://movermeyer.com/2023-01-04-rfc-3339-simd/
          */
-        bool parse_date_time(const std::string_view& str)
+        SIMDPARSE_TARGET_AVX2 bool parse_date_time_simd(const std::string_view& str)
         {
             assert(str.size() == 19);
 
@@ -582,28 +1156,127 @@ namespace simdparse
             alignas(__m128i) std::array<std::uint16_t, 8> result;
             _mm_store_si128(reinterpret_cast<__m128i*>(result.data()), values);
 
-            year = (result[0] * 100) + result[1];
+            year = (result[0] * 100) + result[1];
+            month = result[2];
+            day = result[3];
+            hour = result[4];
+            minute = result[5];
+
+            return str[16] == ':' && detail::parse_range(str, 17, 19, second) && second < 60;
+        }
+
+        /**
+         * Parses an RFC 3339 date-time string with a fractional part using SIMD instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool parse_date_time_fractional_simd(const std::string_view& str)
+        {
+            assert(str.size() <= 29);
+
+            __m256i characters;
+            if constexpr (Padded) {
+                // replace characters past the end of the string with `0`
+                const __m256i positions = _mm256_setr_epi8(
+                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+                );
+                const __m256i in_string = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(str.size())), positions);
+                const __m256i loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str.data()));
+                characters = _mm256_blendv_epi8(_mm256_set1_epi8('0'), loaded, in_string);
+            } else {
+                alignas(__m256i) std::array<char, 32> buf;
+                std::memcpy(buf.data(), str.data(), str.size());
+                std::memset(buf.data() + str.size(), '0', 32 - str.size());
+                characters = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf.data()));
+            }
+
+            __m256i values;
+            if (!detail::fuse_date_time_fractional(characters, values)) {
+                return false;
+            }
+
+            // extract values
+            alignas(__m256i) std::array<std::int16_t, 16> result;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), values);
+
+            year = 100 * result[0] + result[1];
+            month = result[2];
+            day = result[3];
+            hour = result[4];
+            minute = result[5];
+            second = result[8];
+            unsigned int milli = result[9] + result[10];
+            unsigned int micro = result[11] + result[12];
+            unsigned int nano = result[13] + result[14];
+            nanosecond = 1'000'000ull * milli + 1'000ull * micro + nano;
+            return true;
+        }
+
+        /**
+         * Parses a date-time string with a layout known at compile time using SIMD instructions.
+         *
+         * Bounds, masks and the position of the time zone designator are constants, and there are no branches
+         * other than validity checks.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<typename Format, bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool parse_date_time_format_simd(const std::string_view& str)
+        {
+            const __m256i characters = detail::load_fixed_size<Format::size, Padded>(str.data());
+
+            __m256i values;
+            if (!detail::fuse_date_time_format<Format>(characters, values)) {
+                return false;
+            }
+
+            // extract values
+            alignas(__m256i) std::array<std::int16_t, 16> result;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), values);
+
+            year = 100 * result[0] + result[1];
             month = result[2];
             day = result[3];
             hour = result[4];
             minute = result[5];
+            second = result[8];
+            unsigned int milli = result[9] + result[10];
+            unsigned int micro = result[11] + result[12];
+            unsigned int nano = result[13] + result[14];
+            nanosecond = 1'000'000ull * milli + 1'000ull * micro + nano;
 
-            return detail::parse_range(str, 17, 19, second) && second < 60;
+            if constexpr (Format::time_zone != tz_designator::offset) {
+                offset = tzoffset();
+                if constexpr (Format::size > 32) {
+                    // last character of ` UTC` after 9 fractional digits extends past the vector
+                    static_assert(Format::time_zone == tz_designator::utc && Format::size == 33);
+                    return str[32] == 'C';
+                } else {
+                    return true;
+                }
+            } else if constexpr (Format::size > 32) {
+                // time zone offset extends past the vector
+                return offset.parse(str.substr(Format::suffix_offset, 6));
+            } else {
+                // digits and separator of the time zone offset have already been validated
+                const char* p = str.data() + Format::suffix_offset;
+                const int sign = (p[0] == '+') - (p[0] == '-');
+                offset.assign(sign * (600 * (p[1] - '0') + 60 * (p[2] - '0') + 10 * (p[4] - '0') + (p[5] - '0')));
+                return sign != 0;
+            }
         }
-
-        /** Parses an RFC 3339 date-time string with a fractional part using SIMD instructions. */
-        bool parse_date_time_fractional(const std::string_view& str)
+#elif defined(SIMDPARSE_NEON)
+        /** Parses an RFC 3339 date-time string with NEON instructions. */
+        bool parse_date_time_simd(const std::string_view& str)
         {
-            assert(str.size() <= 29);
-
-            alignas(__m256i) std::array<char, 32> buf;
-            std::memcpy(buf.data(), str.data(), str.size());
-            std::memset(buf.data() + str.size(), '0', 32 - str.size());
+            assert(str.size() == 19);
 
-            const __m256i characters = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf.data()));
+            const uint8x16_t characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(str.data()));
 
-            // validate a 32-byte partial date-time string `YYYY-MM-DDThh:mm:ss.fffffffff---`
-            const __m256i lower_bound = _mm256_setr_epi8(
+            // validate a 16-byte partial date-time string `YYYY-MM-DDThh:mm`
+            static constexpr std::uint8_t lower_bound[16] = {
                 48, 48, 48, 48, // year; 48 = ASCII '0'
                 45,             // ASCII '-'
                 48, 48,         // month
@@ -612,13 +1285,9 @@ namespace simdparse
                 32,             // ASCII ' '
                 48, 48,         // hour
                 58,             // ASCII ':'
-                48, 48,         // minute
-                58,             // ASCII ':'
-                48, 48,         // second
-                46,             // ASCII '.'
-                48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48
-            );
-            const __m256i upper_bound = _mm256_setr_epi8(
+                48, 48          // minute
+            };
+            static constexpr std::uint8_t upper_bound[16] = {
                 57, 57, 57, 57, // year; 57 = ASCII '9'
                 45,             // ASCII '-'
                 49, 57,         // month
@@ -627,91 +1296,96 @@ namespace simdparse
                 84,             // ASCII 'T'
                 50, 57,         // hour
                 58,             // ASCII ':'
-                53, 57,         // minute
-                58,             // ASCII ':'
-                53, 57,         // second
-                46,             // ASCII '.'
-                57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57
-            );
+                53, 57          // minute
+            };
 
-            const __m256i too_low = _mm256_cmpgt_epi8(lower_bound, characters);
-            const __m256i too_high = _mm256_cmpgt_epi8(characters, upper_bound);
-            const __m256i out_of_bounds = _mm256_or_si256(too_low, too_high);
-            if (_mm256_movemask_epi8(out_of_bounds)) {
+            const uint8x16_t too_low = vcgtq_u8(vld1q_u8(lower_bound), characters);
+            const uint8x16_t too_high = vcgtq_u8(characters, vld1q_u8(upper_bound));
+            if (vmaxvq_u8(vorrq_u8(too_low, too_high)) != 0) {
                 return false;
             }
 
-            // convert ASCII characters into digit value (offset from character `0`)
-            const __m256i ascii_digit_mask = _mm256_setr_epi8(
-                15, 15, 15, 15,  // year
-                0,
-                15, 15,          // month
-                0,
-                15, 15,          // day
-                0,
-                15, 15,          // hour
-                0,
-                15, 15,          // minute
-                0,
-                15, 15,          // second
-                0,
-                15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15
-            );
-            const __m256i spread_integers = _mm256_and_si256(characters, ascii_digit_mask);
-
-            // group spread digits `YYYY-MM-DD hh:mm:ss.fffffffff---` into packed digits `YYYYMMDDhhmm----ss-fff-fff-fff--`
-            const __m256i mask = _mm256_setr_epi8(
+            // group digits `YYYY-MM-DD hh:mm` into packed digit values `YYYYMMDDhhmm----`
+            static constexpr std::uint8_t mask[16] = {
                 0, 1, 2, 3,  // year
                 5, 6,        // month
                 8, 9,        // day
                 11, 12,      // hour
                 14, 15,      // minute
-                -1, -1, -1, -1,
-                1, 2,        // second
-                -1,
-                4, 5, 6,     // millisecond range
-                -1,
-                7, 8, 9,     // microsecond range
-                -1,
-                10, 11, 12,  // nanosecond range
-                -1, -1
-            );
-            const __m256i packed_integers = _mm256_shuffle_epi8(spread_integers, mask);
+                255, 255, 255, 255
+            };
+            const uint8x16_t packed_integers = vqtbl1q_u8(vandq_u8(characters, vdupq_n_u8(15)), vld1q_u8(mask));
 
-            // fuse neighboring digits into a single value
-            const __m256i weights = _mm256_setr_epi8(
-                10, 1, 10, 1,   // year
-                10, 1,          // month
-                10, 1,          // day
-                10, 1,          // hour
-                10, 1,          // minute
-                0, 0, 0, 0,
-                10, 1,          // second
-                0, 100, 10, 1,  // millisecond range
-                0, 100, 10, 1,  // microsecond range
-                0, 100, 10, 1,  // nanosecond range
-                0, 0
-            );
-            const __m256i values = _mm256_maddubs_epi16(packed_integers, weights);
+            // fuse neighboring digits into a single value, with the first digit in the low byte of each 16-bit integer
+            const uint16x8_t digits = vreinterpretq_u16_u8(packed_integers);
+            const uint16x8_t values = vmlaq_n_u16(vshrq_n_u16(digits, 8), vandq_u16(digits, vdupq_n_u16(0xff)), 10);
 
-            // extract values
-            alignas(__m256i) std::array<std::int16_t, 16> result;
-            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), values);
+            std::array<std::uint16_t, 8> result;
+            vst1q_u16(result.data(), values);
 
-            year = 100 * result[0] + result[1];
+            year = (result[0] * 100) + result[1];
             month = result[2];
             day = result[3];
             hour = result[4];
             minute = result[5];
-            second = result[8];
-            unsigned int milli = result[9] + result[10];
-            unsigned int micro = result[11] + result[12];
-            unsigned int nano = result[13] + result[14];
-            nanosecond = 1'000'000ull * milli + 1'000ull * micro + nano;
-            return true;
+
+            return str[16] == ':' && detail::parse_range(str, 17, 19, second) && second < 60;
         }
-#else
-    private:
+
+        /**
+         * Parses an RFC 3339 date-time string with a fractional part using NEON instructions.
+         *
+         * The string is read in place, whether or not it is padded.
+         */
+        template<bool Padded>
+        bool parse_date_time_fractional_simd(const std::string_view& str)
+        {
+            assert(str.size() <= 29);
+
+            return parse_date_time_simd(str.substr(0, 19))
+                && str[19] == '.'
+                && parse_fractional(str.substr(20))
+                ;
+        }
+
+        /** Parses a date-time string with a layout known at compile time using NEON instructions. */
+        template<typename Format, bool Padded>
+        bool parse_date_time_format_simd(const std::string_view& str)
+        {
+            return str[10] == Format::separator
+                && parse_date_time_simd(str.substr(0, 19))
+                && parse_format_suffix<Format>(str)
+                ;
+        }
+#endif
+
+        /** Parses the fractional part and the time zone designator of a date-time string in a known layout. */
+        template<typename Format>
+        bool parse_format_suffix(const std::string_view& str)
+        {
+            if constexpr (Format::fractional_digits > 0) {
+                if (str[19] != '.' || !parse_fractional(str.substr(20, Format::fractional_digits))) {
+                    return false;
+                }
+            } else {
+                nanosecond = 0;
+            }
+
+            const std::string_view suffix = str.substr(Format::suffix_offset);
+            if constexpr (Format::time_zone == tz_designator::offset) {
+                return offset.parse(suffix);
+            } else if constexpr (Format::time_zone == tz_designator::zulu) {
+                offset = tzoffset();
+                return suffix[0] == 'Z';
+            } else if constexpr (Format::time_zone == tz_designator::utc) {
+                offset = tzoffset();
+                return std::memcmp(" UTC", suffix.data(), 4) == 0;
+            } else {
+                offset = tzoffset();
+                return true;
+            }
+        }
+
         /** Parses an RFC 3339 date-time string. */
         bool parse_date_time(const std::string_view& str)
         {
@@ -744,14 +1418,28 @@ namespace simdparse
                 && parse_fractional(str.substr(20))
                 ;
         }
-#endif
 
         /** Parses an RFC 3339 date-time string without time zone offset. */
+        template<bool Padded>
         bool parse_naive_date_time(const std::string_view& str)
         {
             if (str.size() > 29 || str.size() < 19) {
                 return false;
-            } else if (str.size() > 19) {
+            }
+            if (str.size() == 19) {
+                // objects may be reused, e.g. when parsing records
+                nanosecond = 0;
+            } else {
+                SIMDPARSE_COUNT(datetime_fractional);
+            }
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(datetime_simd);
+                return str.size() > 19 ? parse_date_time_fractional_simd<Padded>(str) : parse_date_time_simd(str);
+            }
+#endif
+            SIMDPARSE_COUNT(datetime_scalar);
+            if (str.size() > 19) {
                 return parse_date_time_fractional(str);
             } else {
                 return parse_date_time(str);
@@ -801,7 +1489,7 @@ namespace simdparse
         }
 
         /** Construct a timestamp from parts. */
-        microtime(
+        constexpr microtime(
             int year,
             unsigned int month,
             unsigned int day,
@@ -815,7 +1503,7 @@ namespace simdparse
         }
 
         /** Construct a timestamp from parts. */
-        microtime(
+        constexpr microtime(
             int year,
             unsigned int month,
             unsigned int day,
@@ -887,76 +1575,62 @@ namespace simdparse
             return static_cast<std::time_t>(_value / 1'000'000);
         }
 
+        /** Number of days before/after epoch of the date and time component, and seconds elapsed since midnight. */
+        constexpr void as_days(std::int64_t& days, unsigned int& seconds) const
+        {
+            const std::int64_t t = _value / 1'000'000;
+            days = (t >= 0 ? t : t - 86'399) / 86'400;
+            seconds = static_cast<unsigned int>(t - days * 86'400);
+        }
+
         /** Returns the Gregorian calendar date of this time instant. */
-        date as_date() const
+        constexpr date as_date() const
         {
-            std::time_t timer = as_time();
-            std::tm* ts = gmtime(&timer);
-            if (ts == nullptr) {
+            if (undefined()) {
                 return date();
             }
 
-            return date(
-                ts->tm_year + 1900,
-                ts->tm_mon + 1,
-                ts->tm_mday
-            );
+            std::int64_t days = 0;
+            unsigned int seconds = 0;
+            as_days(days, seconds);
+
+            date d;
+            detail::civil_from_days(days, d.year, d.month, d.day);
+            return d;
         }
 
         /** Returns the (Gregorian) date and (UTC) time of this time instant. */
-        datetime as_datetime() const
+        constexpr datetime as_datetime() const
         {
             if (undefined()) {
                 return datetime();
             }
 
-            std::time_t timer = as_time();
-            std::tm* ts = gmtime(&timer);
-            if (ts == nullptr) {
-                return datetime();
-            }
+            std::int64_t days = 0;
+            unsigned int seconds = 0;
+            as_days(days, seconds);
 
-            return datetime(
-                ts->tm_year + 1900,
-                ts->tm_mon + 1,
-                ts->tm_mday,
-                ts->tm_hour,
-                ts->tm_min,
-                ts->tm_sec,
-                1000 * microseconds()
-            );
+            datetime dt;
+            detail::civil_from_days(days, dt.year, dt.month, dt.day);
+            dt.hour = seconds / 3'600;
+            dt.minute = seconds / 60 % 60;
+            dt.second = seconds % 60;
+            dt.nanosecond = 1000 * microseconds();
+            return dt;
         }
 
         /** Sets the (Gregorian) date and time (with time zone). */
-        void assign(int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, unsigned long microsecond, const tzoffset& offset)
+        constexpr void assign(int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, unsigned long microsecond, const tzoffset& offset)
         {
-            // use 400-year periodicity of Gregorian calendar
-            int periods = 0;
-            while (year < 1900) {
-                year += 400;
-                ++periods;
-            }
+            std::int64_t seconds = detail::days_from_civil(year, month, day) * 86'400
+                + static_cast<std::int64_t>(60 * (60 * hour + minute) + second)
+                - 60 * offset.minutes();
 
-            std::tm ts{};
-            ts.tm_year = year - 1900;
-            ts.tm_mon = month - 1;
-            ts.tm_mday = day;
-            ts.tm_hour = hour - offset.minutes() / 60;
-            ts.tm_min = minute - offset.minutes() % 60;
-            ts.tm_sec = second;
-            ts.tm_isdst = 0;
-            std::time_t t = timegm(&ts);
-            if (t != static_cast<std::time_t>(-1)) {
-                _value = t;
-                _value -= periods * (146'097ll * 24 * 60 * 60);
-                _value *= 1'000'000;
-                if (_value > 0) {
-                    _value += microsecond;
-                } else {
-                    _value -= microsecond;
-                }
+            _value = seconds * 1'000'000;
+            if (_value >= 0) {
+                _value += microsecond;
             } else {
-                _value = UNSET;
+                _value -= microsecond;
             }
         }
 
@@ -991,6 +1665,198 @@ namespace simdparse
         std::int64_t _value = UNSET;
     };
 
+    /**
+     * A date-time value packed into an order-preserving 96-bit integer.
+     *
+     * Fields are stored from most to least significant bit: year (14 bits), month (5 bits), day (6 bits), hour
+     * (5 bits), minute (6 bits), second (6 bits), nanosecond (30 bits) and time zone offset in minutes (16 bits, with
+     * a bias of 2^15), such that comparing the integers orders values like `datetime::compare`. Each field is wide
+     * enough for all values that the parser accepts, so conversion to and from `datetime` is lossless for years
+     * 0 to 9999.
+     */
+    struct packed_datetime
+    {
+        constexpr static std::string_view name = "date-time";
+
+        constexpr packed_datetime()
+        {
+        }
+
+        constexpr explicit packed_datetime(const datetime& dt)
+        {
+            assert(dt.year >= 0 && dt.year <= 9999);
+            assign(
+                static_cast<unsigned int>(dt.year), dt.month, dt.day, dt.hour, dt.minute, dt.second,
+                static_cast<std::uint32_t>(dt.nanosecond), dt.offset.minutes()
+            );
+        }
+
+        /** Unpacks the fields into a date-time object. */
+        constexpr datetime as_datetime() const
+        {
+            tzoffset offset;
+            offset.assign(static_cast<int>(_low & 0xffff) - offset_bias);
+            return datetime(
+                static_cast<int>(_high >> 50),
+                static_cast<unsigned int>((_high >> 45) & 0x1f),
+                static_cast<unsigned int>((_high >> 39) & 0x3f),
+                static_cast<unsigned int>((_high >> 34) & 0x1f),
+                static_cast<unsigned int>((_high >> 28) & 0x3f),
+                static_cast<unsigned int>((_high >> 22) & 0x3f),
+                static_cast<unsigned long>(((_high & 0x3fffff) << 8) | (_low >> 16)),
+                offset
+            );
+        }
+
+        constexpr bool operator==(const packed_datetime& op) const
+        {
+            return _high == op._high && _low == op._low;
+        }
+
+        constexpr bool operator!=(const packed_datetime& op) const
+        {
+            return !(*this == op);
+        }
+
+        constexpr bool operator<(const packed_datetime& op) const
+        {
+            return _high < op._high || (_high == op._high && _low < op._low);
+        }
+
+        constexpr bool operator<=(const packed_datetime& op) const
+        {
+            return !(op < *this);
+        }
+
+        constexpr bool operator>=(const packed_datetime& op) const
+        {
+            return !(*this < op);
+        }
+
+        constexpr bool operator>(const packed_datetime& op) const
+        {
+            return op < *this;
+        }
+
+        /** Most significant 64 bits: date, time up to seconds, and the upper 22 bits of the nanosecond part. */
+        constexpr std::uint64_t high() const
+        {
+            return _high;
+        }
+
+        /** Least significant 32 bits: the lower 8 bits of the nanosecond part, and the biased time zone offset. */
+        constexpr std::uint32_t low() const
+        {
+            return _low;
+        }
+
+        /** Hash value that mixes the packed bits, for use as a key in unordered containers. */
+        std::size_t hash() const
+        {
+            // finalize with the 64-bit mixer of MurmurHash3
+            std::uint64_t h = _high ^ (static_cast<std::uint64_t>(_low) * 0x9e3779b97f4a7c15ull);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return static_cast<std::size_t>(h);
+        }
+
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /**
+         * Parses a date-time string with an optional time zone offset.
+         *
+         * Accepts the same strings as `datetime::parse`. Strings with a fractional part are packed straight from the
+         * digits fused by the AVX2 kernel, without populating a `datetime` object first.
+         */
+        bool parse(const std::string_view& str)
+        {
+#if defined(SIMDPARSE_AVX2)
+            if (str.size() >= 19 && str.size() <= 35 && detail::use_avx2()) {
+                const tz_designator time_zone = detail::detect_tz_designator(str);
+                const std::size_t naive_length = str.size() - detail::tz_designator_length(time_zone);
+                if (naive_length > 20 && naive_length <= 29) {
+                    SIMDPARSE_COUNT(datetime_calls);
+                    SIMDPARSE_COUNT(datetime_fractional);
+                    SIMDPARSE_COUNT(datetime_simd);
+                    tzoffset offset;
+                    return SIMDPARSE_COUNT_RESULT(datetime_failures,
+                        (time_zone != tz_designator::offset || offset.parse(str.substr(naive_length))) && parse_fractional_simd(str.substr(0, naive_length), offset.minutes())
+                    );
+                }
+            }
+#endif
+            datetime dt;
+            if (!dt.parse(str)) {
+                return false;
+            }
+            *this = packed_datetime(dt);
+            return true;
+        }
+
+    private:
+        constexpr static int offset_bias = 0x8000;
+
+        constexpr void assign(unsigned int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, std::uint32_t nanosecond, int offset)
+        {
+            _high = static_cast<std::uint64_t>(year) << 50
+                | static_cast<std::uint64_t>(month) << 45
+                | static_cast<std::uint64_t>(day) << 39
+                | static_cast<std::uint64_t>(hour) << 34
+                | static_cast<std::uint64_t>(minute) << 28
+                | static_cast<std::uint64_t>(second) << 22
+                | nanosecond >> 8;
+            _low = (nanosecond & 0xff) << 16 | static_cast<std::uint32_t>(offset + offset_bias);
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Parses a date-time string `YYYY-MM-DDThh:mm:ss.f` with 1 to 9 fractional digits and no time zone designator. */
+        SIMDPARSE_TARGET_AVX2 bool parse_fractional_simd(const std::string_view& str, int offset)
+        {
+            alignas(__m256i) std::array<char, 32> buf;
+            std::memcpy(buf.data(), str.data(), str.size());
+            std::memset(buf.data() + str.size(), '0', 32 - str.size());
+
+            __m256i values;
+            if (!detail::fuse_date_time_fractional(_mm256_load_si256(reinterpret_cast<const __m256i*>(buf.data())), values)) {
+                return false;
+            }
+
+            // YY YY MM DD hh mm -- -- ss ms ms us us ns ns --
+            alignas(__m256i) std::array<std::int16_t, 16> result;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), values);
+
+            const std::uint32_t milli = static_cast<std::uint32_t>(result[9] + result[10]);
+            const std::uint32_t micro = static_cast<std::uint32_t>(result[11] + result[12]);
+            const std::uint32_t nano = static_cast<std::uint32_t>(result[13] + result[14]);
+            assign(
+                static_cast<unsigned int>(100 * result[0] + result[1]),
+                static_cast<unsigned int>(result[2]),
+                static_cast<unsigned int>(result[3]),
+                static_cast<unsigned int>(result[4]),
+                static_cast<unsigned int>(result[5]),
+                static_cast<unsigned int>(result[8]),
+                1'000'000 * milli + 1'000 * micro + nano,
+                offset
+            );
+            return true;
+        }
+#endif
+
+        std::uint64_t _high = 0;
+        std::uint32_t _low = offset_bias;
+    };
+
     namespace detail
     {
         /**
@@ -1102,3 +1968,15 @@ namespace simdparse
         }
     }
 }
+
+namespace std
+{
+    template<>
+    struct hash<simdparse::packed_datetime>
+    {
+        std::size_t operator()(const simdparse::packed_datetime& dt) const noexcept
+        {
+            return dt.hash();
+        }
+    };
+}
@@ -12,17 +12,104 @@
 #include <string_view>
 #include <array>
 #include <charconv>
+#include <limits>
 #include <cstdint>
 #include <cstring>
+#include <cassert>
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+#include "stats.hpp"
 
-#if defined(__AVX2__)
+#if defined(SIMDPARSE_AVX2) || defined(SIMDPARSE_AVX512)
 #include <immintrin.h>
-#elif (defined(__i386__) || defined(__x86_64__))
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
+#elif defined(__SSSE3__) && (defined(__i386__) || defined(__x86_64__))
 #include <tmmintrin.h>
 #endif
 
 namespace simdparse
 {
+    namespace detail
+    {
+        /** Powers of ten that fit into a 64-bit unsigned integer. */
+        constexpr inline std::uint64_t powers_of_ten[20] = {
+            1ull, 10ull, 100ull, 1'000ull, 10'000ull, 100'000ull, 1'000'000ull, 10'000'000ull, 100'000'000ull,
+            1'000'000'000ull, 10'000'000'000ull, 100'000'000'000ull, 1'000'000'000'000ull, 10'000'000'000'000ull,
+            100'000'000'000'000ull, 1'000'000'000'000'000ull, 10'000'000'000'000'000ull, 100'000'000'000'000'000ull,
+            1'000'000'000'000'000'000ull, 10'000'000'000'000'000'000ull
+        };
+
+#if defined(SIMDPARSE_AVX2)
+        /** Bit mask of the bytes of a 256-bit register that are not digit values, among the leading `size` bytes. */
+        SIMDPARSE_TARGET_AVX2 inline std::uint32_t non_digit_mask(__m256i values_digit_1, std::size_t size)
+        {
+            const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(values_digit_1, _mm256_set1_epi8(9)), values_digit_1);
+            return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_digit)) & static_cast<std::uint32_t>((std::uint64_t{ 1 } << size) - 1);
+        }
+
+        /**
+         * Shuffles the bytes of a 256-bit register across 128-bit lanes.
+         *
+         * Bit 4 of each index selects the low or the high lane of the input. Positions with an index of -1 are zero.
+         */
+        SIMDPARSE_TARGET_AVX2 inline __m256i shuffle_across_lanes(__m256i values, __m256i indices)
+        {
+            const __m256i low = _mm256_permute2x128_si256(values, values, 0x00);
+            const __m256i high = _mm256_permute2x128_si256(values, values, 0x11);
+            return _mm256_blendv_epi8(
+                _mm256_shuffle_epi8(low, indices),
+                _mm256_shuffle_epi8(high, indices),
+                _mm256_slli_epi16(indices, 3)
+            );
+        }
+
+        /** Fuses 32 digit values into four 64-bit integers of eight digits each. */
+        SIMDPARSE_TARGET_AVX2 inline void fuse_digits_32(__m256i digits, std::array<std::uint64_t, 4>& result)
+        {
+            // 1  2  3  4  5  6  7  8  -->  12  34  56  78  -->  1234  5678  -->  12345678
+            const __m256i values_digit_2 = _mm256_maddubs_epi16(digits, _mm256_set1_epi16(0x010a));
+            const __m256i values_digit_4 = _mm256_madd_epi16(values_digit_2, _mm256_set1_epi32(0x00010064));
+            const __m256i values_digit_8 = _mm256_add_epi64(
+                _mm256_mul_epu32(values_digit_4, _mm256_set1_epi64x(10'000)),
+                _mm256_srli_epi64(values_digit_4, 32)
+            );
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result.data()), values_digit_8);
+        }
+#elif defined(SIMDPARSE_NEON)
+        /** Bit mask of the bytes of a pair of registers that are not digit values, among the leading `size` bytes. */
+        inline std::uint32_t non_digit_mask(const uint8x16x2_t& values_digit_1, std::size_t size)
+        {
+            // weight each byte that is not a digit by its bit position within a group of eight bytes, and add
+            // neighboring bytes three times such that each byte sums up the weights of a group of eight bytes
+            static constexpr std::uint8_t bit_weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            const uint8x16_t weights = vld1q_u8(bit_weights);
+            const uint8x16_t low = vandq_u8(vcgtq_u8(values_digit_1.val[0], vdupq_n_u8(9)), weights);
+            const uint8x16_t high = vandq_u8(vcgtq_u8(values_digit_1.val[1], vdupq_n_u8(9)), weights);
+            const uint8x16_t sum_2 = vpaddq_u8(low, high);
+            const uint8x16_t sum_4 = vpaddq_u8(sum_2, sum_2);
+            const uint8x16_t sum_8 = vpaddq_u8(sum_4, sum_4);
+            return static_cast<std::uint32_t>(vgetq_lane_u64(vreinterpretq_u64_u8(sum_8), 0)) & static_cast<std::uint32_t>((std::uint64_t{ 1 } << size) - 1);
+        }
+
+        /** Fuses 32 digit values into four 64-bit integers of eight digits each. */
+        inline void fuse_digits_32(const uint8x16x2_t& digits, std::array<std::uint64_t, 4>& result)
+        {
+            // 1  2  3  4  5  6  7  8  -->  12  34  56  78  -->  1234  5678  -->  12345678
+            for (std::size_t k = 0; k < 2; ++k) {
+                const uint16x8_t digits_1 = vreinterpretq_u16_u8(digits.val[k]);
+                const uint16x8_t values_digit_2 = vmlaq_n_u16(vshrq_n_u16(digits_1, 8), vandq_u16(digits_1, vdupq_n_u16(0xff)), 10);
+                const uint32x4_t digits_2 = vreinterpretq_u32_u16(values_digit_2);
+                const uint32x4_t values_digit_4 = vmlaq_n_u32(vshrq_n_u32(digits_2, 16), vandq_u32(digits_2, vdupq_n_u32(0xffff)), 100);
+                const uint64x2_t digits_4 = vreinterpretq_u64_u32(values_digit_4);
+                const uint64x2_t values_digit_8 = vmlal_n_u32(vmovl_u32(vshrn_n_u64(digits_4, 32)), vmovn_u64(digits_4), 10'000);
+                result[2 * k] = vgetq_lane_u64(values_digit_8, 0);
+                result[2 * k + 1] = vgetq_lane_u64(values_digit_8, 1);
+            }
+        }
+#endif
+    }
+
     struct decimal_integer
     {
         constexpr static std::string_view name = "decimal integer";
@@ -73,41 +160,58 @@ namespace simdparse
             return result.ec == std::errc{} && result.ptr == str.data() + str.size();
         }
 
-#if (defined(__AVX2__) || defined(__i386__) || defined(__x86_64__))
     private:
-        template<std::size_t Size>
+        /** Parses the leading (at most) `Size` digits with a SIMD kernel, and any remaining digits with `from_chars`. */
+        template<std::size_t Size, bool (decimal_integer::*ParseSimd)(const std::string_view&)>
         bool parse_integer(const std::string_view& str)
         {
             if (str.size() > Size) {
-                if (!parse_simd(str.substr(0, Size))) {
+                if (!(this->*ParseSimd)(str.substr(0, Size))) {
                     return false;
                 }
+                SIMDPARSE_COUNT(decimal_tail);
+                constexpr unsigned long long max_value = std::numeric_limits<unsigned long long>::max();
                 std::size_t len = str.size() - Size;
                 unsigned long long val = value;
                 for (std::size_t k = 0; k < len; ++k) {
+                    if (val > max_value / 10) {
+                        return false;
+                    }
                     val *= 10;
                 }
                 if (!parse_chars(str.substr(Size, len))) {
                     return false;
                 }
+                if (value > max_value - val) {
+                    return false;
+                }
                 value += val;
                 return true;
             } else {
-                return parse_simd(str);
+                return (this->*ParseSimd)(str);
             }
         }
-#endif
 
-#if defined(__AVX2__)
+#if defined(SIMDPARSE_AVX2)
     private:
-        /** Parses the string representation of an integer with SIMD instructions. */
-        bool parse_simd(const std::string_view& str)
+        /**
+         * Parses the string representation of an integer of at most 16 digits with SIMD instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool parse_simd_16(const std::string_view& str)
         {
-            alignas(__m128i) std::array<char, 16> buf = {
-                '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0'
-            };
-            std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
-            const __m128i characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            __m128i characters;
+            if constexpr (Padded) {
+                characters = detail::load_right_aligned(str.data(), str.size(), '0');
+            } else {
+                alignas(__m128i) std::array<char, 16> buf = {
+                    '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0'
+                };
+                std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
+                characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            }
 
             const __m128i lower_bound = _mm_set1_epi8('0');
             const __m128i upper_bound = _mm_set1_epi8('9');
@@ -149,17 +253,116 @@ namespace simdparse
             value = 100'000'000ull * result[0] + result[1];
             return true;
         }
+#elif defined(SIMDPARSE_NEON)
+    private:
+        /**
+         * Parses the string representation of an integer of at most 16 digits with NEON instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        bool parse_simd_16(const std::string_view& str)
+        {
+            uint8x16_t characters;
+            if constexpr (Padded) {
+                characters = detail::load_right_aligned(str.data(), str.size(), '0');
+            } else {
+                alignas(16) std::array<char, 16> buf = {
+                    '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0'
+                };
+                std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
+                characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(buf.data()));
+            }
 
-    public:
-        bool parse(const std::string_view& str)
+            // convert ASCII characters into digit value (offset from character `0`)
+            // characters below `0` wrap around, and are caught by the same comparison as characters above `9`
+            const uint8x16_t values_digit_1 = vsubq_u8(characters, vdupq_n_u8('0'));
+            if (vmaxvq_u8(vcgtq_u8(values_digit_1, vdupq_n_u8(9))) != 0) {
+                return false;
+            }
+
+            // combine pairs of digits into eight 16-bit integers, with the first digit in the low byte
+            // 1  2  3  4  5  6  7  8  -->  12  34  56  78
+            const uint16x8_t digits_1 = vreinterpretq_u16_u8(values_digit_1);
+            const uint16x8_t values_digit_2 = vmlaq_n_u16(vshrq_n_u16(digits_1, 8), vandq_u16(digits_1, vdupq_n_u16(0xff)), 10);
+
+            // combine consecutive 16-bit integers into four 32-bit integers
+            // 12  34  56  78  -->  1234  5678
+            const uint32x4_t digits_2 = vreinterpretq_u32_u16(values_digit_2);
+            const uint32x4_t values_digit_4 = vmlaq_n_u32(vshrq_n_u32(digits_2, 16), vandq_u32(digits_2, vdupq_n_u32(0xffff)), 100);
+
+            // combine consecutive 32-bit integers into two 64-bit integers with a widening multiply-add
+            // 1234  5678  -->  12345678
+            const uint64x2_t digits_4 = vreinterpretq_u64_u32(values_digit_4);
+            const uint64x2_t values_digit_8 = vmlal_n_u32(vmovl_u32(vshrn_n_u64(digits_4, 32)), vmovn_u64(digits_4), 10'000);
+
+            value = 100'000'000ull * vgetq_lane_u64(values_digit_8, 0) + vgetq_lane_u64(values_digit_8, 1);
+            return true;
+        }
+#endif
+
+#if defined(SIMDPARSE_AVX512)
+    private:
+        /**
+         * Parses the string representation of an integer of 1 to 20 digits with AVX-512 instructions.
+         *
+         * Digits are loaded with a masked load, aligned to the end of a 32-byte vector with a byte permutation, and
+         * fused into four 8-digit parts. Values that do not fit into 64 bits are rejected.
+         */
+        SIMDPARSE_TARGET_AVX512 bool parse_simd_20(const std::string_view& str)
         {
-            return parse_integer<16>(str);
+            const std::size_t len = str.size();
+            assert(len > 0 && len <= 20);
+
+            const __mmask32 load_mask = static_cast<__mmask32>((1u << len) - 1);
+            const __m256i characters = _mm256_maskz_loadu_epi8(load_mask, str.data());
+
+            // convert ASCII characters into digit value, and reject characters other than digits
+            const __m256i values_digit_1 = _mm256_maskz_sub_epi8(load_mask, characters, _mm256_set1_epi8('0'));
+            if (_mm256_mask_cmpgt_epu8_mask(load_mask, values_digit_1, _mm256_set1_epi8(9))) {
+                return false;
+            }
+
+            // move digits to the end of the vector, filling leading positions with zero
+            const __m256i indices = _mm256_sub_epi8(
+                _mm256_setr_epi8(
+                    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+                ),
+                _mm256_set1_epi8(static_cast<char>(32 - len))
+            );
+            const __mmask32 keep_mask = static_cast<__mmask32>(~0u << (32 - len));
+            const __m256i digits = _mm256_maskz_permutexvar_epi8(keep_mask, indices, values_digit_1);
+
+            // 1  2  3  4  5  6  7  8  -->  12  34  56  78  -->  1234  5678
+            const __m256i values_digit_2 = _mm256_maddubs_epi16(digits, _mm256_set1_epi16(0x010a));
+            const __m256i values_digit_4 = _mm256_madd_epi16(values_digit_2, _mm256_set1_epi32(0x00010064));
+
+            // combine pairs of 32-bit integers into four 64-bit integers of eight digits each
+            // 1234  5678  -->  12345678
+            const __m256i values_digit_8 = _mm256_add_epi64(
+                _mm256_mul_epu32(values_digit_4, _mm256_set1_epi64x(10'000)),
+                _mm256_srli_epi64(values_digit_4, 32)
+            );
+
+            alignas(__m256i) std::array<std::uint64_t, 4> result;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(result.data()), values_digit_8);
+
+            // the largest 64-bit unsigned integer is 18'446'744'073'709'551'615 = 1844 * 10^16 + 6'744'073'709'551'615
+            const std::uint64_t high = result[1];  // at most 4 digits
+            const std::uint64_t low = 100'000'000ull * result[2] + result[3];  // at most 16 digits
+            if (high > 1844 || (high == 1844 && low > 6'744'073'709'551'615ull)) {
+                return false;
+            }
+            value = 10'000'000'000'000'000ull * high + low;
+            return true;
         }
+#endif
 
-#elif (defined(__i386__) || defined(__x86_64__))
+#if !defined(__AVX2__) && defined(__SSSE3__) && (defined(__i386__) || defined(__x86_64__))
     private:
-        /** Parses the string representation of an integer with SIMD instructions. */
-        bool parse_simd(const std::string_view& str)
+        /** Parses the string representation of an integer of at most 8 digits with SIMD instructions. */
+        bool parse_simd_8(const std::string_view& str)
         {
             char buf[8] = { '0', '0', '0', '0', '0', '0', '0', '0' };
             std::memcpy(buf + 8 - str.size(), str.data(), str.size());
@@ -205,21 +408,55 @@ namespace simdparse
             value = ((intermediate >> 32) & 0xffffffff) + (intermediate & 0xffffffff) * 10'000;
             return true;
         }
+#endif
 
-    public:
-        bool parse(const std::string_view& str)
+    private:
+        template<bool Padded>
+        bool parse_decimal(const std::string_view& str)
         {
-            return parse_integer<8>(str);
+            SIMDPARSE_COUNT(decimal_calls);
+            if (str.empty()) {
+                SIMDPARSE_COUNT(decimal_failures);
+                return false;
+            }
+#if defined(SIMDPARSE_AVX512)
+            if (detail::use_avx512()) {
+                if (str.size() <= 20) {
+                    SIMDPARSE_COUNT(decimal_avx512);
+                    return SIMDPARSE_COUNT_RESULT(decimal_failures, parse_simd_20(str));
+                } else {
+                    SIMDPARSE_COUNT(decimal_scalar);
+                    return SIMDPARSE_COUNT_RESULT(decimal_failures, parse_chars(str));
+                }
+            }
+#endif
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(decimal_simd);
+                return SIMDPARSE_COUNT_RESULT(decimal_failures, (parse_integer<16, &decimal_integer::parse_simd_16<Padded>>(str)));
+            }
+#endif
+#if !defined(__AVX2__) && defined(__SSSE3__) && (defined(__i386__) || defined(__x86_64__))
+            SIMDPARSE_COUNT(decimal_mmx);
+            return SIMDPARSE_COUNT_RESULT(decimal_failures, (parse_integer<8, &decimal_integer::parse_simd_8>(str)));
+#else
+            SIMDPARSE_COUNT(decimal_scalar);
+            return SIMDPARSE_COUNT_RESULT(decimal_failures, parse_chars(str));
+#endif
         }
 
-#else
     public:
+        /** Parses the string representation of a decimal integer into an integer value. */
         bool parse(const std::string_view& str)
         {
-            return parse_chars(str);
+            return parse_decimal<false>(str);
         }
 
-#endif
+        /** Parses the string representation of a decimal integer, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_decimal<true>(str);
+        }
 
         /** Parses the string representation of a decimal integer into an integer value. */
         bool parse(const char* beg, const char* end)
@@ -235,4 +472,440 @@ namespace simdparse
 
         unsigned long long value = 0;
     };
+
+    namespace detail
+    {
+        /**
+         * Digits of a decimal number with an optional minus sign and an optional decimal point, e.g. `-12345.6789`.
+         */
+        struct decimal_digits
+        {
+            /** Digits of the integer and the fractional part as a single integer, e.g. `123456789`. */
+            std::uint64_t mantissa = 0;
+            /** Number of digits after the decimal point. */
+            std::size_t fraction_digits = 0;
+            /** Position past the last digit, e.g. where an exponent starts. */
+            std::size_t end = 0;
+            bool negative = false;
+        };
+
+        /** Largest number of digits (including leading zeros) whose value always fits into 64 bits. */
+        constexpr std::size_t max_decimal_digits = 19;
+
+        /**
+         * Splits the longest prefix of a string that matches `-?[0-9]*(\.[0-9]*)?` into components one character at
+         * a time.
+         *
+         * @returns False unless the prefix has 1 to 19 digits.
+         */
+        inline bool split_decimal(const std::string_view& str, decimal_digits& parts)
+        {
+            std::size_t k = 0;
+            if (!str.empty() && str[0] == '-') {
+                parts.negative = true;
+                k = 1;
+            }
+
+            std::uint64_t mantissa = 0;
+            std::size_t digits = 0;
+            for (; k < str.size(); ++k) {
+                const unsigned char digit = static_cast<unsigned char>(str[k] - '0');
+                if (digit > 9) {
+                    break;
+                }
+                mantissa = 10 * mantissa + digit;
+                ++digits;
+            }
+            if (k < str.size() && str[k] == '.') {
+                const std::size_t point = k;
+                for (++k; k < str.size(); ++k) {
+                    const unsigned char digit = static_cast<unsigned char>(str[k] - '0');
+                    if (digit > 9) {
+                        break;
+                    }
+                    mantissa = 10 * mantissa + digit;
+                }
+                parts.fraction_digits = k - point - 1;
+                digits += parts.fraction_digits;
+            }
+            parts.mantissa = mantissa;
+            parts.end = k;
+            return digits >= 1 && digits <= max_decimal_digits;
+        }
+
+#if defined(SIMDPARSE_SIMD)
+        /**
+         * Locates the sign, the decimal point and the end of the digits from a mask of characters that are not digits.
+         *
+         * @param separators Bit `k` is set if character `k` of the string is not a digit.
+         * @returns Number of digits, excluding the sign and the decimal point.
+         */
+        inline std::size_t locate_decimal_separators(const std::string_view& str, std::uint32_t separators, decimal_digits& parts)
+        {
+            std::size_t begin = 0;
+            if (str[0] == '-') {
+                parts.negative = true;
+                begin = 1;
+                separators &= ~std::uint32_t{ 1 };
+            }
+
+            std::size_t end = separators != 0 ? count_trailing_zeros(separators) : str.size();
+            std::size_t digits = end - begin;
+            if (end < str.size() && str[end] == '.') {
+                const std::size_t point = end;
+                separators &= separators - 1;
+                end = separators != 0 ? count_trailing_zeros(separators) : str.size();
+                parts.fraction_digits = end - point - 1;
+                digits += parts.fraction_digits;
+            }
+            parts.end = end;
+            return digits;
+        }
+#endif
+
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Splits a decimal number of at most 32 characters into components with AVX2 instructions.
+         *
+         * The sign, the decimal point and the end of the digits are found with a single comparison and `movemask`.
+         * A byte shuffle then removes the sign and the decimal point, and right-aligns all digits in the register,
+         * such that they are fused into a single integer with the same multiply-add steps as `decimal_integer`.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool split_decimal_simd(const std::string_view& str, decimal_digits& parts)
+        {
+            const std::size_t size = str.size();
+            const __m256i characters = load_partial<Padded>(str.data(), size);
+            const __m256i values_digit_1 = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+            const std::size_t digits = locate_decimal_separators(str, non_digit_mask(values_digit_1, size), parts);
+            if (digits < 1 || digits > max_decimal_digits) {
+                return false;
+            }
+
+            // digit `k` of the combined digits is moved to position `32 - digits + k`, skipping the sign at the start
+            // and the decimal point in front of the trailing `fraction_digits` positions
+            const __m256i positions = _mm256_setr_epi8(
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+            );
+            const __m256i after_point = _mm256_cmpgt_epi8(positions, _mm256_set1_epi8(static_cast<char>(31 - parts.fraction_digits)));
+            const __m256i in_range = _mm256_cmpgt_epi8(positions, _mm256_set1_epi8(static_cast<char>(31 - digits)));
+            const __m256i shift = _mm256_set1_epi8(static_cast<char>((parts.negative ? 1 : 0) + digits - 32));
+            const __m256i indices = _mm256_blendv_epi8(
+                _mm256_set1_epi8(-1),
+                _mm256_sub_epi8(_mm256_add_epi8(positions, shift), after_point),
+                in_range
+            );
+
+            alignas(__m256i) std::array<std::uint64_t, 4> result;
+            fuse_digits_32(shuffle_across_lanes(values_digit_1, indices), result);
+
+            // the leading 13 positions are always zero
+            parts.mantissa = 10'000'000'000'000'000ull * result[1] + 100'000'000ull * result[2] + result[3];
+            return true;
+        }
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Splits a decimal number of at most 32 characters into components with NEON instructions.
+         *
+         * The sign, the decimal point and the end of the digits are found with a single comparison. A table lookup
+         * then removes the sign and the decimal point, and right-aligns all digits, such that they are fused into a
+         * single integer with the same multiply-accumulate steps as `decimal_integer`.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        bool split_decimal_simd(const std::string_view& str, decimal_digits& parts)
+        {
+            const std::size_t size = str.size();
+            const uint8x16x2_t characters = load_partial<Padded>(str.data(), size);
+            uint8x16x2_t values_digit_1;
+            values_digit_1.val[0] = vsubq_u8(characters.val[0], vdupq_n_u8('0'));
+            values_digit_1.val[1] = vsubq_u8(characters.val[1], vdupq_n_u8('0'));
+            const std::size_t digits = locate_decimal_separators(str, non_digit_mask(values_digit_1, size), parts);
+            if (digits < 1 || digits > max_decimal_digits) {
+                return false;
+            }
+
+            // digit `k` of the combined digits is moved to position `32 - digits + k`, skipping the sign at the start
+            // and the decimal point in front of the trailing `fraction_digits` positions; indices out of range
+            // produce zero
+            static constexpr std::uint8_t positions[32] = {
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+            };
+            const uint8x16_t point_bound = vdupq_n_u8(static_cast<std::uint8_t>(32 - parts.fraction_digits));
+            const uint8x16_t lower_bound = vdupq_n_u8(static_cast<std::uint8_t>(32 - digits));
+            const uint8x16_t shift = vdupq_n_u8(static_cast<std::uint8_t>((parts.negative ? 1 : 0) + digits - 32));
+            uint8x16x2_t shuffled;
+            for (std::size_t k = 0; k < 2; ++k) {
+                const uint8x16_t position = vld1q_u8(positions + 16 * k);
+                const uint8x16_t after_point = vcleq_u8(point_bound, position);
+                const uint8x16_t in_range = vcleq_u8(lower_bound, position);
+                const uint8x16_t indices = vorrq_u8(vsubq_u8(vaddq_u8(position, shift), after_point), vmvnq_u8(in_range));
+                shuffled.val[k] = vqtbl2q_u8(values_digit_1, indices);
+            }
+
+            std::array<std::uint64_t, 4> result;
+            fuse_digits_32(shuffled, result);
+
+            // the leading 13 positions are always zero
+            parts.mantissa = 10'000'000'000'000'000ull * result[1] + 100'000'000ull * result[2] + result[3];
+            return true;
+        }
+#endif
+
+        /**
+         * Splits a decimal number into components, with a vector kernel where available.
+         *
+         * Strings of more than 32 characters, and strings of less than 8 characters without padding, are split one
+         * character at a time.
+         */
+        template<bool Padded>
+        bool split_decimal_number(const std::string_view& str, decimal_digits& parts)
+        {
+            if (str.empty()) {
+                return false;
+            }
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd() && str.size() <= 32 && (Padded || str.size() >= 8)) {
+                return split_decimal_simd<Padded>(str, parts);
+            }
+#endif
+            return split_decimal(str, parts);
+        }
+    }
+
+    /** A decimal integer with an optional minus sign that fits into a C++ `long long`, e.g. `-12345`. */
+    struct signed_decimal
+    {
+        constexpr static std::string_view name = "signed decimal integer";
+
+        constexpr signed_decimal()
+        {
+        }
+
+        constexpr signed_decimal(long long value)
+            : value(value)
+        {
+        }
+
+        constexpr bool operator==(const signed_decimal& op) const
+        {
+            return value == op.value;
+        }
+
+        constexpr bool operator!=(const signed_decimal& op) const
+        {
+            return value != op.value;
+        }
+
+        constexpr bool operator<(const signed_decimal& op) const
+        {
+            return value < op.value;
+        }
+
+        constexpr bool operator<=(const signed_decimal& op) const
+        {
+            return value <= op.value;
+        }
+
+        constexpr bool operator>=(const signed_decimal& op) const
+        {
+            return value >= op.value;
+        }
+
+        constexpr bool operator>(const signed_decimal& op) const
+        {
+            return value > op.value;
+        }
+
+    private:
+        /** Parses the digits after the sign with the kernels of `decimal_integer`, and checks the range. */
+        template<typename S>
+        bool parse_signed(const S& str)
+        {
+            const bool negative = !str.empty() && str[0] == '-';
+            const std::size_t offset = negative ? 1 : 0;
+            decimal_integer magnitude;
+            if (!magnitude.parse(S(str.data() + offset, str.size() - offset))) {
+                return false;
+            }
+
+            constexpr unsigned long long max_value = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+            if (!negative) {
+                if (magnitude.value > max_value) {
+                    return false;
+                }
+                value = static_cast<long long>(magnitude.value);
+            } else if (magnitude.value <= max_value) {
+                value = -static_cast<long long>(magnitude.value);
+            } else if (magnitude.value == max_value + 1) {
+                value = std::numeric_limits<long long>::min();
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+    public:
+        /** Parses the string representation of a signed decimal integer into an integer value. */
+        bool parse(const std::string_view& str)
+        {
+            return parse_signed(str);
+        }
+
+        /** Parses the string representation of a signed decimal integer, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_signed(str);
+        }
+
+        /** Parses the string representation of a signed decimal integer into an integer value. */
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        /** Parses the string representation of a signed decimal integer into an integer value. */
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        long long value = 0;
+    };
+
+    /**
+     * A decimal number with a fixed number of fractional digits, stored exactly as a scaled 64-bit integer.
+     *
+     * For example, `fixed_decimal<6>` parses `-12345.6789` into the value `-12'345'678'900`. The string has an
+     * optional minus sign and an optional decimal point, with 1 to 19 digits in total. Fractional digits beyond
+     * `Scale` are accepted only if they are zeros, such that parsing never loses precision.
+     *
+     * @tparam Scale Number of fractional digits of the value, at most 18.
+     */
+    template<unsigned int Scale>
+    struct fixed_decimal
+    {
+        static_assert(Scale <= 18, "expected: at most 18 fractional digits");
+
+        constexpr static std::string_view name = "fixed-point decimal";
+        constexpr static unsigned int scale = Scale;
+
+        constexpr fixed_decimal()
+        {
+        }
+
+        /** Constructs a fixed-point decimal from its value multiplied by 10 to the power of `Scale`. */
+        constexpr explicit fixed_decimal(std::int64_t value)
+            : value(value)
+        {
+        }
+
+        constexpr bool operator==(const fixed_decimal& op) const
+        {
+            return value == op.value;
+        }
+
+        constexpr bool operator!=(const fixed_decimal& op) const
+        {
+            return value != op.value;
+        }
+
+        constexpr bool operator<(const fixed_decimal& op) const
+        {
+            return value < op.value;
+        }
+
+        constexpr bool operator<=(const fixed_decimal& op) const
+        {
+            return value <= op.value;
+        }
+
+        constexpr bool operator>=(const fixed_decimal& op) const
+        {
+            return value >= op.value;
+        }
+
+        constexpr bool operator>(const fixed_decimal& op) const
+        {
+            return value > op.value;
+        }
+
+    private:
+        template<bool Padded>
+        bool parse_fixed(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(fixed_decimal_calls);
+            detail::decimal_digits parts;
+            if (!detail::split_decimal_number<Padded>(str, parts) || parts.end != str.size()) {
+                SIMDPARSE_COUNT(fixed_decimal_failures);
+                return false;
+            }
+            return SIMDPARSE_COUNT_RESULT(fixed_decimal_failures, assign(parts));
+        }
+
+        bool assign(const detail::decimal_digits& parts)
+        {
+            std::uint64_t magnitude = parts.mantissa;
+            constexpr std::uint64_t max_value = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+            const std::uint64_t limit = parts.negative ? max_value + 1 : max_value;
+            if (parts.fraction_digits <= Scale) {
+                const std::uint64_t multiplier = detail::powers_of_ten[Scale - parts.fraction_digits];
+                if (magnitude > limit / multiplier) {
+                    return false;
+                }
+                magnitude *= multiplier;
+            } else {
+                const std::uint64_t divisor = detail::powers_of_ten[parts.fraction_digits - Scale];
+                if (magnitude % divisor != 0) {
+                    return false;
+                }
+                magnitude /= divisor;
+                if (magnitude > limit) {
+                    return false;
+                }
+            }
+
+            if (!parts.negative) {
+                value = static_cast<std::int64_t>(magnitude);
+            } else if (magnitude <= max_value) {
+                value = -static_cast<std::int64_t>(magnitude);
+            } else {
+                value = std::numeric_limits<std::int64_t>::min();
+            }
+            return true;
+        }
+
+    public:
+        /** Parses the string representation of a decimal number into a scaled integer value. */
+        bool parse(const std::string_view& str)
+        {
+            return parse_fixed<false>(str);
+        }
+
+        /** Parses the string representation of a decimal number, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_fixed<true>(str);
+        }
+
+        /** Parses the string representation of a decimal number into a scaled integer value. */
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        /** Parses the string representation of a decimal number into a scaled integer value. */
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /** Value multiplied by 10 to the power of `Scale`. */
+        std::int64_t value = 0;
+    };
 }
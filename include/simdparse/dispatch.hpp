@@ -0,0 +1,275 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SIMDPARSE_CPUID_MSVC
+#include <intrin.h>
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMDPARSE_CPUID_GNU
+#include <cpuid.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Instruction set selection.
+ *
+ * `SIMDPARSE_AVX2` is defined when AVX2 kernels are compiled, either because the translation unit targets AVX2
+ * (e.g. `-mavx2`), or because runtime dispatch has been requested with `SIMDPARSE_DISPATCH` on an x86 platform.
+ * In the latter case, kernels are compiled with `SIMDPARSE_TARGET_AVX2`, and are only invoked if the processor
+ * supports the instruction set.
+ *
+ * `SIMDPARSE_AVX512` and `SIMDPARSE_TARGET_AVX512` work alike for kernels that need AVX-512 with the extensions
+ * BW (byte and word), VL (vector length) and VBMI (byte permutation).
+ *
+ * `SIMDPARSE_NEON` is defined on 64-bit ARM, where Advanced SIMD (NEON) is part of the base instruction set.
+ *
+ * `SIMDPARSE_SIMD` is defined if either AVX2 or NEON kernels are compiled. Types that have both implement them
+ * as functions of the same name, and select them with `detail::use_simd()`.
+ */
+#if defined(__AVX2__)
+#define SIMDPARSE_AVX2
+#define SIMDPARSE_TARGET_AVX2
+#elif defined(SIMDPARSE_DISPATCH) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define SIMDPARSE_AVX2
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMDPARSE_TARGET_AVX2
+#else
+#define SIMDPARSE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#if defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__AVX512VBMI__)
+#define SIMDPARSE_AVX512
+#define SIMDPARSE_TARGET_AVX512
+#elif defined(SIMDPARSE_DISPATCH) && (defined(__x86_64__) || defined(_M_X64))
+#define SIMDPARSE_AVX512
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMDPARSE_TARGET_AVX512
+#else
+#define SIMDPARSE_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw,avx512vl,avx512vbmi")))
+#endif
+#endif
+
+#if (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define SIMDPARSE_NEON
+#endif
+
+#if defined(SIMDPARSE_AVX2) || defined(SIMDPARSE_NEON)
+#define SIMDPARSE_SIMD
+#endif
+
+namespace simdparse
+{
+    /** Instruction set extensions supported by the processor and the operating system. */
+    struct cpu_features
+    {
+        bool sse42 = false;
+        bool avx2 = false;
+        bool avx512bw = false;
+        bool avx512vl = false;
+        bool avx512vbmi = false;
+
+        /** Queries the processor with `cpuid`, and the operating system with `xgetbv` for saving extended state. */
+        static cpu_features detect()
+        {
+            cpu_features features;
+#if defined(SIMDPARSE_CPUID_MSVC) || defined(SIMDPARSE_CPUID_GNU)
+            std::uint32_t leaf1[4];
+            std::uint32_t leaf7[4];
+            if (!cpuid(1, leaf1)) {
+                return features;
+            }
+            if (!cpuid(7, leaf7)) {
+                leaf7[0] = leaf7[1] = leaf7[2] = leaf7[3] = 0;
+            }
+            const std::uint32_t leaf1_ecx = leaf1[2];
+            const std::uint32_t leaf7_ebx = leaf7[1];
+            const std::uint32_t leaf7_ecx = leaf7[2];
+
+            features.sse42 = (leaf1_ecx >> 20) & 1;
+
+            // AVX registers are usable only if the operating system saves them on context switch
+            const bool osxsave = (leaf1_ecx >> 27) & 1;
+            const bool avx = (leaf1_ecx >> 28) & 1;
+            if (!osxsave || !avx) {
+                return features;
+            }
+            const std::uint64_t xcr0 = xgetbv();
+            if ((xcr0 & 0x06) != 0x06) {  // XMM and YMM state
+                return features;
+            }
+            features.avx2 = (leaf7_ebx >> 5) & 1;
+
+            if ((xcr0 & 0xe6) != 0xe6) {  // opmask, upper half of ZMM0-15 and ZMM16-31 state
+                return features;
+            }
+            const bool avx512f = (leaf7_ebx >> 16) & 1;
+            features.avx512bw = avx512f && ((leaf7_ebx >> 30) & 1);
+            features.avx512vl = avx512f && ((leaf7_ebx >> 31) & 1);
+            features.avx512vbmi = features.avx512bw && ((leaf7_ecx >> 1) & 1);
+#endif
+            return features;
+        }
+
+    private:
+#if defined(SIMDPARSE_CPUID_MSVC)
+        /** Executes `cpuid` with the given leaf (and sub-leaf 0), storing registers EAX, EBX, ECX and EDX. */
+        static bool cpuid(unsigned int leaf, std::uint32_t (&regs)[4])
+        {
+            int info[4];
+            __cpuid(info, 0);
+            if (static_cast<unsigned int>(info[0]) < leaf) {
+                return false;
+            }
+            __cpuidex(info, static_cast<int>(leaf), 0);
+            for (int k = 0; k < 4; ++k) {
+                regs[k] = static_cast<std::uint32_t>(info[k]);
+            }
+            return true;
+        }
+
+        static std::uint64_t xgetbv()
+        {
+            return _xgetbv(0);
+        }
+#elif defined(SIMDPARSE_CPUID_GNU)
+        /** Executes `cpuid` with the given leaf (and sub-leaf 0), storing registers EAX, EBX, ECX and EDX. */
+        static bool cpuid(unsigned int leaf, std::uint32_t (&regs)[4])
+        {
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid_count(leaf, 0, &eax, &ebx, &ecx, &edx)) {
+                return false;
+            }
+            regs[0] = eax;
+            regs[1] = ebx;
+            regs[2] = ecx;
+            regs[3] = edx;
+            return true;
+        }
+
+        static std::uint64_t xgetbv()
+        {
+            std::uint32_t eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<std::uint64_t>(edx) << 32) | eax;
+        }
+#endif
+    };
+
+    /**
+     * Instruction set extensions that dispatched kernels are allowed to use.
+     *
+     * Initialized once with the features detected on first use. Clearing a flag forces the next best path, which
+     * is useful for testing fallback code. Only the kernels selected at run time (with `SIMDPARSE_DISPATCH`)
+     * honor these flags; kernels compiled for a fixed target (e.g. with `-mavx2`) are always used.
+     */
+    inline cpu_features& dispatch_features()
+    {
+        static cpu_features features = cpu_features::detect();
+        return features;
+    }
+
+    namespace detail
+    {
+        /** True if AVX2 kernels are to be used. */
+        inline bool use_avx2()
+        {
+#if defined(__AVX2__)
+            return true;
+#elif defined(SIMDPARSE_AVX2)
+            return dispatch_features().avx2;
+#else
+            return false;
+#endif
+        }
+
+        /** True if AVX-512 kernels (with BW, VL and VBMI extensions) are to be used. */
+        inline bool use_avx512()
+        {
+#if defined(__AVX512BW__) && defined(__AVX512VL__) && defined(__AVX512VBMI__)
+            return true;
+#elif defined(SIMDPARSE_AVX512)
+            const cpu_features& features = dispatch_features();
+            return features.avx2 && features.avx512bw && features.avx512vl && features.avx512vbmi;
+#else
+            return false;
+#endif
+        }
+
+        /** True if NEON kernels are to be used. */
+        constexpr bool use_neon()
+        {
+#if defined(SIMDPARSE_NEON)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /** True if either AVX2 or NEON kernels are to be used. */
+        inline bool use_simd()
+        {
+            return use_avx2() || use_neon();
+        }
+
+        /** Index of the least significant set bit in a non-zero integer. */
+        inline unsigned int count_trailing_zeros(std::uint32_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned int>(index);
+#else
+            return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+        }
+
+        /** Index of the least significant set bit in a non-zero integer. */
+        inline unsigned int count_trailing_zeros(std::uint64_t mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return static_cast<unsigned int>(index);
+#else
+            return static_cast<unsigned int>(__builtin_ctzll(mask));
+#endif
+        }
+
+        /** Number of leading zero bits in a non-zero integer. */
+        inline unsigned int count_leading_zeros(std::uint64_t value)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, value);
+            return 63 - static_cast<unsigned int>(index);
+#else
+            return static_cast<unsigned int>(__builtin_clzll(value));
+#endif
+        }
+
+        /** Reverses the order of bytes in an integer, e.g. to read a big-endian value on a little-endian machine. */
+        inline std::uint64_t byte_swap(std::uint64_t value)
+        {
+#if defined(_MSC_VER)
+            return _byteswap_uint64(value);
+#else
+            return __builtin_bswap64(value);
+#endif
+        }
+    }
+}
@@ -0,0 +1,437 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <array>
+#include <limits>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include "datetime.hpp"
+#include "decimal.hpp"
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+#include "stats.hpp"
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace simdparse
+{
+    /** Unit of a numeric timestamp that counts time elapsed since the Unix epoch. */
+    enum class epoch_unit
+    {
+        automatic,  // by number of integer digits
+        seconds,  // 1700000000
+        milliseconds,  // 1700000000123
+        microseconds,  // 1700000000123456
+        nanoseconds  // 1700000000123456789
+    };
+
+    /**
+     * Unit of a numeric timestamp known at compile time.
+     *
+     * Passed as a tag to `epoch_time::parse` to skip inferring the unit from the number of digits, e.g.
+     * `epoch_format<epoch_unit::milliseconds>` for `1700000000123`.
+     */
+    template<epoch_unit Unit>
+    struct epoch_format
+    {
+        constexpr static epoch_unit unit = Unit;
+    };
+
+    namespace detail
+    {
+        /**
+         * Components of a numeric timestamp.
+         */
+        struct epoch_parts
+        {
+            /** Integer part, at most 19 digits. */
+            std::uint64_t integer = 0;
+            /** The first 8 digits of the fractional part, padded with zeros, e.g. `5` becomes `50'000'000`. */
+            std::uint32_t fraction = 0;
+            /** Number of digits in the integer part. */
+            std::size_t digits = 0;
+            bool negative = false;
+        };
+
+        /** Longest string accepted: a sign, 19 integer digits, a decimal point and 9 fractional digits. */
+        constexpr std::size_t epoch_max_size = 30;
+
+        /**
+         * Infers the unit of a numeric timestamp from the number of its integer digits.
+         *
+         * Timestamps of the current era have 10, 13, 16 and 19 digits in seconds, milliseconds, microseconds and
+         * nanoseconds, respectively. A digit count between two of these selects the nearest unit, such that seconds
+         * cover dates up to year 5138, and milliseconds cover dates from year 2001.
+         */
+        constexpr inline epoch_unit epoch_unit_from_digits(std::size_t digits)
+        {
+            if (digits <= 11) {
+                return epoch_unit::seconds;
+            } else if (digits <= 14) {
+                return epoch_unit::milliseconds;
+            } else if (digits <= 17) {
+                return epoch_unit::microseconds;
+            } else {
+                return epoch_unit::nanoseconds;
+            }
+        }
+
+        /**
+         * Converts the components of a numeric timestamp into microseconds since the epoch.
+         *
+         * Digits beyond microsecond precision are truncated, rounding towards zero. Timestamps before the epoch are
+         * encoded like in `microtime::assign`, i.e. as whole seconds rounded towards negative infinity, with the
+         * sub-second part subtracted, e.g. `-1.5` as `-2'500'000`.
+         *
+         * @returns False if the result does not fit into a 64-bit signed integer.
+         */
+        constexpr inline bool epoch_to_microseconds(const epoch_parts& parts, epoch_unit unit, std::int64_t& value)
+        {
+            std::uint64_t multiplier = 1;
+            std::uint64_t fraction = 0;
+            std::uint64_t integer = parts.integer;
+            switch (unit == epoch_unit::automatic ? epoch_unit_from_digits(parts.digits) : unit) {
+                case epoch_unit::seconds:
+                    multiplier = 1'000'000;
+                    fraction = parts.fraction / 100;
+                    break;
+                case epoch_unit::milliseconds:
+                    multiplier = 1'000;
+                    fraction = parts.fraction / 100'000;
+                    break;
+                case epoch_unit::microseconds:
+                    break;
+                default:
+                    integer /= 1'000;
+                    break;
+            }
+
+            constexpr std::uint64_t max_value = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+            if (integer > max_value / multiplier) {
+                return false;
+            }
+            const std::uint64_t magnitude = integer * multiplier + fraction;
+            if (magnitude > max_value) {
+                return false;
+            }
+            if (!parts.negative) {
+                value = static_cast<std::int64_t>(magnitude);
+                return true;
+            }
+
+            // split into whole seconds rounded towards negative infinity, and a non-negative sub-second part
+            std::uint64_t seconds = magnitude / 1'000'000;
+            std::uint64_t microseconds = magnitude % 1'000'000;
+            if (microseconds != 0) {
+                seconds += 1;
+                microseconds = 1'000'000 - microseconds;
+            }
+            if (seconds > max_value / 1'000'000 || seconds * 1'000'000 > max_value - microseconds) {
+                return false;
+            }
+            value = -static_cast<std::int64_t>(seconds * 1'000'000 + microseconds);
+            return true;
+        }
+
+        /**
+         * Splits a numeric timestamp into components one character at a time.
+         */
+        inline bool split_epoch(const std::string_view& str, epoch_parts& parts)
+        {
+            std::size_t k = 0;
+            if (str[0] == '-') {
+                parts.negative = true;
+                k = 1;
+            }
+
+            const std::size_t integer_begin = k;
+            std::uint64_t integer = 0;
+            for (; k < str.size() && k - integer_begin < 20; ++k) {
+                const unsigned char digit = static_cast<unsigned char>(str[k] - '0');
+                if (digit > 9) {
+                    break;
+                }
+                integer = 10 * integer + digit;
+            }
+            parts.digits = k - integer_begin;
+            if (parts.digits < 1 || parts.digits > 19) {
+                return false;
+            }
+            parts.integer = integer;
+
+            if (k == str.size()) {
+                return true;
+            }
+            if (str[k] != '.' || str.size() - k < 2 || str.size() - k > 10) {
+                return false;
+            }
+
+            std::uint32_t fraction = 0;
+            std::uint32_t scale = 10'000'000;
+            for (++k; k < str.size(); ++k) {
+                const unsigned char digit = static_cast<unsigned char>(str[k] - '0');
+                if (digit > 9) {
+                    return false;
+                }
+                fraction += scale * digit;
+                scale /= 10;
+            }
+            parts.fraction = fraction;
+            return true;
+        }
+
+#if defined(SIMDPARSE_SIMD)
+        /**
+         * Locates the integer part of a numeric timestamp from a mask of characters that are not digits.
+         *
+         * @param separators Bit `k` is set if character `k` of the string is not a digit.
+         * @param integer_end Position of the decimal point, or the length of the string if there is none.
+         */
+        inline bool locate_epoch_separators(const std::string_view& str, std::uint32_t separators, epoch_parts& parts, std::size_t& integer_end)
+        {
+            std::size_t integer_begin = 0;
+            if (str[0] == '-') {
+                parts.negative = true;
+                integer_begin = 1;
+                separators &= ~std::uint32_t{ 1 };
+            }
+
+            if (separators == 0) {
+                integer_end = str.size();
+            } else {
+                integer_end = count_trailing_zeros(separators);
+                if ((separators & (separators - 1)) != 0 || str[integer_end] != '.' || integer_end + 1 == str.size()) {
+                    return false;
+                }
+            }
+            parts.digits = integer_end - integer_begin;
+            return parts.digits >= 1 && parts.digits <= 19 && str.size() - integer_end <= 10;
+        }
+#endif
+
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Splits a numeric timestamp into components with AVX2 instructions.
+         *
+         * The string is loaded into a single register. After locating the sign and the decimal point, a byte shuffle
+         * right-aligns the integer part in the leading 24 bytes of the register and left-aligns the fractional part
+         * in the trailing 8 bytes, and all digits are fused into four 64-bit integers of 8 digits each.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool split_epoch_simd(const std::string_view& str, epoch_parts& parts)
+        {
+            const std::size_t size = str.size();
+            const __m256i characters = load_partial<Padded>(str.data(), size);
+
+            // convert ASCII characters into digit value, and find characters other than digits
+            const __m256i values_digit_1 = _mm256_sub_epi8(characters, _mm256_set1_epi8('0'));
+            const std::uint32_t separators = non_digit_mask(values_digit_1, size);
+
+            std::size_t integer_end;
+            if (!locate_epoch_separators(str, separators, parts, integer_end)) {
+                return false;
+            }
+            const std::size_t fraction_digits = integer_end < size ? size - integer_end - 1 : 0;
+
+            // position `k` of the output takes the character at `integer_end - 24 + k` for the integer part, and at
+            // `integer_end - 23 + k` for the fractional part, skipping the decimal point
+            const __m256i positions = _mm256_setr_epi8(
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+            );
+            const __m256i offsets = _mm256_setr_epi8(
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 25, 26, 27, 28, 29, 30, 31, 32
+            );
+            const __m256i in_range = _mm256_and_si256(
+                _mm256_cmpgt_epi8(positions, _mm256_set1_epi8(static_cast<char>(23 - parts.digits))),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(24 + fraction_digits)), positions)
+            );
+            const __m256i indices = _mm256_blendv_epi8(
+                _mm256_set1_epi8(-1),
+                _mm256_add_epi8(offsets, _mm256_set1_epi8(static_cast<char>(integer_end - 24))),
+                in_range
+            );
+
+            alignas(__m256i) std::array<std::uint64_t, 4> result;
+            fuse_digits_32(shuffle_across_lanes(values_digit_1, indices), result);
+
+            // the leading 5 positions are always zero, so the integer part fits into 64 bits
+            parts.integer = 10'000'000'000'000'000ull * result[0] + 100'000'000ull * result[1] + result[2];
+            parts.fraction = static_cast<std::uint32_t>(result[3]);
+            return true;
+        }
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Splits a numeric timestamp into components with NEON instructions.
+         *
+         * The string is loaded into a pair of registers. After locating the sign and the decimal point, a table
+         * lookup right-aligns the integer part in the leading 24 bytes and left-aligns the fractional part in the
+         * trailing 8 bytes, and all digits are fused into four 64-bit integers of 8 digits each.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        bool split_epoch_simd(const std::string_view& str, epoch_parts& parts)
+        {
+            const std::size_t size = str.size();
+            const uint8x16x2_t characters = load_partial<Padded>(str.data(), size);
+
+            // convert ASCII characters into digit value, and find characters other than digits
+            uint8x16x2_t values_digit_1;
+            values_digit_1.val[0] = vsubq_u8(characters.val[0], vdupq_n_u8('0'));
+            values_digit_1.val[1] = vsubq_u8(characters.val[1], vdupq_n_u8('0'));
+
+            const std::uint32_t separators = non_digit_mask(values_digit_1, size);
+
+            std::size_t integer_end;
+            if (!locate_epoch_separators(str, separators, parts, integer_end)) {
+                return false;
+            }
+            const std::size_t fraction_digits = integer_end < size ? size - integer_end - 1 : 0;
+
+            // position `k` of the output takes the character at `integer_end - 24 + k` for the integer part, and at
+            // `integer_end - 23 + k` for the fractional part, skipping the decimal point; indices out of range
+            // produce zero
+            static constexpr std::uint8_t positions[32] = {
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+            };
+            static constexpr std::uint8_t offsets[32] = {
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                16, 17, 18, 19, 20, 21, 22, 23, 25, 26, 27, 28, 29, 30, 31, 32
+            };
+            const uint8x16_t shift = vdupq_n_u8(static_cast<std::uint8_t>(integer_end - 24));
+            const uint8x16_t lower_bound = vdupq_n_u8(static_cast<std::uint8_t>(24 - parts.digits));
+            const uint8x16_t upper_bound = vdupq_n_u8(static_cast<std::uint8_t>(24 + fraction_digits));
+            uint8x16x2_t digits;
+            for (std::size_t k = 0; k < 2; ++k) {
+                const uint8x16_t position = vld1q_u8(positions + 16 * k);
+                const uint8x16_t in_range = vandq_u8(vcleq_u8(lower_bound, position), vcgtq_u8(upper_bound, position));
+                const uint8x16_t indices = vorrq_u8(vaddq_u8(vld1q_u8(offsets + 16 * k), shift), vmvnq_u8(in_range));
+                digits.val[k] = vqtbl2q_u8(values_digit_1, indices);
+            }
+
+            std::array<std::uint64_t, 4> result;
+            fuse_digits_32(digits, result);
+
+            // the leading 5 positions are always zero, so the integer part fits into 64 bits
+            parts.integer = 10'000'000'000'000'000ull * result[0] + 100'000'000ull * result[1] + result[2];
+            parts.fraction = static_cast<std::uint32_t>(result[3]);
+            return true;
+        }
+#endif
+    }
+
+    /**
+     * A UTC timestamp parsed from the number of seconds, milliseconds, microseconds or nanoseconds elapsed since the
+     * Unix epoch, e.g. `1700000000`, `1700000000123` or `1700000000.123456`.
+     *
+     * The integer part has 1 to 19 digits, and may be preceded by a minus sign. The optional fractional part has 1 to
+     * 9 digits. Unless a unit is given with an `epoch_format` tag, the unit is inferred from the number of integer
+     * digits. Digits beyond microsecond precision are truncated.
+     */
+    struct epoch_time : microtime
+    {
+        constexpr static std::string_view name = "epoch timestamp";
+
+        using microtime::microtime;
+
+        constexpr epoch_time()
+        {
+        }
+
+        constexpr epoch_time(const microtime& t)
+            : microtime(t)
+        {
+        }
+
+        bool parse(const std::string_view& str)
+        {
+            return parse_epoch<epoch_unit::automatic, false>(str);
+        }
+
+        /** Parses a numeric timestamp, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_epoch<epoch_unit::automatic, true>(str);
+        }
+
+        /** Parses a numeric timestamp in a unit known at compile time. */
+        template<epoch_unit Unit>
+        bool parse(const std::string_view& str, epoch_format<Unit>)
+        {
+            return parse_epoch<Unit, false>(str);
+        }
+
+        /** Parses a numeric timestamp in a unit known at compile time, reading directly from the padded input. */
+        template<epoch_unit Unit>
+        bool parse(const padded_string_view& str, epoch_format<Unit>)
+        {
+            return parse_epoch<Unit, true>(str);
+        }
+
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /** Microseconds since the epoch. */
+        constexpr microtime as_microtime() const
+        {
+            return *this;
+        }
+
+    private:
+        template<epoch_unit Unit, bool Padded>
+        bool parse_epoch(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(epoch_calls);
+            if (str.empty() || str.size() > detail::epoch_max_size) {
+                SIMDPARSE_COUNT(epoch_failures);
+                return false;
+            }
+
+            detail::epoch_parts parts;
+            bool result;
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd() && (Padded || str.size() >= 8)) {
+                SIMDPARSE_COUNT(epoch_simd);
+                result = detail::split_epoch_simd<Padded>(str, parts);
+            } else
+#endif
+            {
+                SIMDPARSE_COUNT(epoch_scalar);
+                result = detail::split_epoch(str, parts);
+            }
+
+            std::int64_t value = 0;
+            if (!result || !detail::epoch_to_microseconds(parts, Unit, value)) {
+                SIMDPARSE_COUNT(epoch_failures);
+                return false;
+            }
+            static_cast<microtime&>(*this) = microtime(value);
+            return true;
+        }
+    };
+}
@@ -11,103 +11,579 @@
 #pragma once
 #include "datetime.hpp"
 #include "decimal.hpp"
+#include "dispatch.hpp"
+#include "floating_point.hpp"
 #include "hexadecimal.hpp"
 #include "ipaddr.hpp"
+#include "network.hpp"
 #include "uuid.hpp"
+#include <array>
+#include <charconv>
 #include <string>
+#include <system_error>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#endif
 
 namespace simdparse
 {
+    namespace detail
+    {
+        /** Copies a formatted string into the caller-provided buffer if it fits. */
+        inline std::to_chars_result copy_chars(char* first, char* last, const char* str, std::size_t len)
+        {
+            if (static_cast<std::size_t>(last - first) < len) {
+                return { last, std::errc::value_too_large };
+            }
+            std::memcpy(first, str, len);
+            return { first + len, std::errc{} };
+        }
+
+        /** Writes exactly two decimal digits of a value less than 100. */
+        inline char* write_2digits(char* p, unsigned int value)
+        {
+            *p++ = static_cast<char>('0' + value / 10);
+            *p++ = static_cast<char>('0' + value % 10);
+            return p;
+        }
+
+        /** Writes the hexadecimal digits of a 16-bit value without leading zeros. */
+        inline char* write_hex16(char* p, unsigned int value)
+        {
+            static constexpr char hex_digits[] = "0123456789abcdef";
+            int shift = 12;
+            while (shift > 0 && (value >> shift) == 0) {
+                shift -= 4;
+            }
+            for (; shift >= 0; shift -= 4) {
+                *p++ = hex_digits[(value >> shift) & 0xf];
+            }
+            return p;
+        }
+
+        /** Writes the dotted decimal form of an IPv4 address of at most 15 characters. */
+        inline char* write_ipv4(char* p, const std::uint8_t* addr)
+        {
+            for (std::size_t k = 0; k < 4; ++k) {
+                unsigned int octet = addr[k];
+                if (k > 0) {
+                    *p++ = '.';
+                }
+                if (octet >= 100) {
+                    *p++ = static_cast<char>('0' + octet / 100);
+                    p = write_2digits(p, octet % 100);
+                } else if (octet >= 10) {
+                    p = write_2digits(p, octet);
+                } else {
+                    *p++ = static_cast<char>('0' + octet);
+                }
+            }
+            return p;
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Writes a date-time string of 29 characters into a 32-byte buffer with SIMD instructions, as in `write_date_time`. */
+        SIMDPARSE_TARGET_AVX2 inline void write_date_time_simd(char* buf, int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, unsigned long nanosecond)
+        {
+            // pairs of digits in 16-bit integers, with a single leading nanosecond digit in the last slot
+            const __m128i first_pairs = _mm_setr_epi16(
+                static_cast<short>(year / 100),
+                static_cast<short>(year % 100),
+                static_cast<short>(month),
+                static_cast<short>(day),
+                static_cast<short>(hour),
+                static_cast<short>(minute),
+                static_cast<short>(second),
+                static_cast<short>(nanosecond / 100'000'000)
+            );
+            const __m128i second_pairs = _mm_setr_epi16(
+                static_cast<short>(nanosecond / 1'000'000 % 100),
+                static_cast<short>(nanosecond / 10'000 % 100),
+                static_cast<short>(nanosecond / 100 % 100),
+                static_cast<short>(nanosecond % 100),
+                0, 0, 0, 0
+            );
+
+            // spread pairs of digits into bytes, most significant digit first
+            // 19  84  10  24  -->  '1' '9'  '8' '4'  '1' '0'  '2' '4'
+            const __m128i scale_10 = _mm_set1_epi16(10);
+            const __m128i ascii_zero = _mm_set1_epi8('0');
+            const __m128i first_tens = _mm_mulhi_epu16(first_pairs, _mm_set1_epi16(6554));  // x / 10 for x < 100
+            const __m128i first_ones = _mm_sub_epi16(first_pairs, _mm_mullo_epi16(first_tens, scale_10));
+            const __m128i first_digits = _mm_or_si128(_mm_or_si128(first_tens, _mm_slli_epi16(first_ones, 8)), ascii_zero);
+            const __m128i second_tens = _mm_mulhi_epu16(second_pairs, _mm_set1_epi16(6554));
+            const __m128i second_ones = _mm_sub_epi16(second_pairs, _mm_mullo_epi16(second_tens, scale_10));
+            const __m128i second_digits = _mm_or_si128(_mm_or_si128(second_tens, _mm_slli_epi16(second_ones, 8)), ascii_zero);
+
+            // insert separators `YYYY-MM-DD hh:mm` into first 16 bytes
+            const __m128i first_mask = _mm_setr_epi8(0, 1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10, 11);
+            const __m128i first_separators = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, ' ', 0, 0, ':', 0, 0);
+            const __m128i first_chars = _mm_or_si128(_mm_shuffle_epi8(first_digits, first_mask), first_separators);
+
+            // insert separators `:ss.fffffffff` into next 13 bytes
+            // s  s  f  f | f  f  f  f  f  f  f  f  -  -  -  -
+            const __m128i trailing_digits = _mm_alignr_epi8(second_digits, first_digits, 12);
+            const __m128i second_mask = _mm_setr_epi8(-1, 0, 1, -1, 3, 4, 5, 6, 7, 8, 9, 10, 11, -1, -1, -1);
+            const __m128i second_separators = _mm_setr_epi8(':', 0, 0, '.', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m128i second_chars = _mm_or_si128(_mm_shuffle_epi8(trailing_digits, second_mask), second_separators);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), first_chars);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + 16), second_chars);
+        }
+#endif
+
+        /**
+         * Writes a date-time string `YYYY-MM-DD hh:mm:ss.fffffffff` of 29 characters into a 32-byte buffer.
+         *
+         * The year must be between 0 and 9999.
+         */
+        inline void write_date_time(char* buf, int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, unsigned long nanosecond)
+        {
+#if defined(SIMDPARSE_AVX2)
+            if (use_avx2()) {
+                write_date_time_simd(buf, year, month, day, hour, minute, second, nanosecond);
+                return;
+            }
+#endif
+            char* p = buf;
+            p = write_2digits(p, static_cast<unsigned int>(year / 100));
+            p = write_2digits(p, static_cast<unsigned int>(year % 100));
+            *p++ = '-';
+            p = write_2digits(p, month);
+            *p++ = '-';
+            p = write_2digits(p, day);
+            *p++ = ' ';
+            p = write_2digits(p, hour);
+            *p++ = ':';
+            p = write_2digits(p, minute);
+            *p++ = ':';
+            p = write_2digits(p, second);
+            *p++ = '.';
+            unsigned long fraction = nanosecond;
+            for (int k = 8; k >= 0; --k) {
+                p[k] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Writes all 16 hexadecimal digits of a 64-bit integer in lowercase, most significant digit first. */
+        SIMDPARSE_TARGET_AVX2 inline void write_hex64_simd(char* buf, std::uint64_t value)
+        {
+            // split bytes into high and low nibbles, and reverse to most significant nibble first
+            const __m128i bytes = _mm_cvtsi64_si128(static_cast<long long>(value));
+            const __m128i low_nibbles = _mm_and_si128(bytes, _mm_set1_epi8(0x0f));
+            const __m128i high_nibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0f));
+            const __m128i nibbles = _mm_unpacklo_epi8(high_nibbles, low_nibbles);
+            const __m128i reverse = _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+            const __m128i ordered = _mm_shuffle_epi8(nibbles, reverse);
+
+            // look up hexadecimal digit for each nibble
+            const __m128i hex_digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), _mm_shuffle_epi8(hex_digits, ordered));
+        }
+
+        /** Writes an RFC 4122 UUID string of 36 characters into a 48-byte buffer with SIMD instructions. */
+        SIMDPARSE_TARGET_AVX2 inline void write_uuid_simd(char* buf, const std::uint8_t* id)
+        {
+            // split bytes into high and low nibbles, most significant nibble first
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(id));
+            const __m128i low_nibbles = _mm_and_si128(bytes, _mm_set1_epi8(0x0f));
+            const __m128i high_nibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0f));
+            const __m256i nibbles = _mm256_setr_m128i(_mm_unpacklo_epi8(high_nibbles, low_nibbles), _mm_unpackhi_epi8(high_nibbles, low_nibbles));
+
+            // look up hexadecimal digit for each nibble
+            const __m256i hex_digits = _mm256_setr_epi8(
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+            );
+            const __m256i hex = _mm256_shuffle_epi8(hex_digits, nibbles);
+
+            // insert dashes
+            // lane 1: 0123456789abcdef -> 01234567-89ab-cd
+            // lane 2: FEDCBA9876543210 -> __-FEDC-BA987654
+            const __m256i dash_shuffle = _mm256_setr_epi8(
+                0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13,
+                -1, -1, -1, 0, 1, 2, 3, -1, 4, 5, 6, 7, 8, 9, 10, 11
+            );
+            const __m256i dashes = _mm256_setr_epi8(
+                0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0,
+                0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0
+            );
+            __m256i chars = _mm256_or_si256(_mm256_shuffle_epi8(hex, dash_shuffle), dashes);
+
+            // insert characters that cross the lane boundary
+            // lane 2: __-FEDC-BA987654 -> ef-FEDC-BA987654
+            chars = _mm256_insert_epi16(chars, _mm256_extract_epi16(hex, 7), 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), chars);
+
+            // append trailing characters
+            std::int32_t tail = _mm256_extract_epi32(hex, 7);
+            std::memcpy(buf + 32, &tail, 4);
+        }
+#endif
+
+        /**
+         * Writes a date-time string of 29 characters with an arbitrary year, shifting characters if necessary.
+         *
+         * As with `%.4d`, the year has at least four digits and a sign if negative, e.g. `-0012` or `12345`.
+         *
+         * @returns Number of characters written, at most 40.
+         */
+        inline std::size_t write_any_date_time(char* buf, int year, unsigned int month, unsigned int day, unsigned int hour, unsigned int minute, unsigned int second, unsigned long nanosecond)
+        {
+            if (year >= 0 && year <= 9999) {
+                write_date_time(buf, year, month, day, hour, minute, second, nanosecond);
+                return 29;
+            }
+
+            // years with a sign or five or more digits
+            std::array<char, 32> tail;
+            write_date_time(tail.data(), 0, month, day, hour, minute, second, nanosecond);
+            char* p = buf;
+            unsigned int magnitude = static_cast<unsigned int>(year);
+            if (year < 0) {
+                *p++ = '-';
+                magnitude = 0 - magnitude;
+            }
+            if (magnitude < 10000) {
+                p = write_2digits(p, magnitude / 100);
+                p = write_2digits(p, magnitude % 100);
+            } else {
+                p = std::to_chars(p, p + 10, magnitude).ptr;
+            }
+            std::memcpy(p, tail.data() + 4, 25);
+            return static_cast<std::size_t>(p - buf) + 25;
+        }
+    }
+
+    inline std::to_chars_result to_chars(char* first, char* last, const decimal_integer& i)
+    {
+        return std::to_chars(first, last, i.value);
+    }
+
+    /** Writes the hexadecimal representation of an integer in lowercase, without a `0x` prefix or leading zeros. */
+    inline std::to_chars_result to_chars(char* first, char* last, const hexadecimal_integer& i)
+    {
+        std::size_t len = 1;
+        for (std::uint64_t v = i.value >> 4; v != 0; v >>= 4) {
+            ++len;
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        if (detail::use_avx2()) {
+            std::array<char, 16> buf;
+            detail::write_hex64_simd(buf.data(), i.value);
+            return detail::copy_chars(first, last, buf.data() + 16 - len, len);
+        }
+#endif
+        if (static_cast<std::size_t>(last - first) < len) {
+            return { last, std::errc::value_too_large };
+        }
+        return std::to_chars(first, last, i.value, 16);
+    }
+
+    /** Writes the hexadecimal representation of a 128-bit integer in lowercase, without a `0x` prefix or leading zeros. */
+    inline std::to_chars_result to_chars(char* first, char* last, const uint128& i)
+    {
+        if (i.high == 0) {
+            return to_chars(first, last, hexadecimal_integer(i.low));
+        }
+        std::to_chars_result result = to_chars(first, last, hexadecimal_integer(i.high));
+        if (result.ec != std::errc{} || last - result.ptr < 16) {
+            return { last, std::errc::value_too_large };
+        }
+        for (std::size_t k = 0; k < 16; ++k) {
+            result.ptr[k] = detail::hex_digits[(i.low >> (60 - 4 * k)) & 0x0f];
+        }
+        return { result.ptr + 16, std::errc{} };
+    }
+
+    inline std::to_chars_result to_chars(char* first, char* last, const ipv4_addr& addr)
+    {
+        std::array<char, 16> buf;
+        char* end = detail::write_ipv4(buf.data(), addr.data());
+        return detail::copy_chars(first, last, buf.data(), end - buf.data());
+    }
+
+    /**
+     * Writes the text representation of an IPv6 address as recommended by RFC 5952.
+     *
+     * The longest run of two or more zero groups is compressed into `::`, and IPv4-mapped and IPv4-compatible
+     * addresses are written with a dotted decimal suffix, matching the output of `inet_ntop`.
+     */
+    inline std::to_chars_result to_chars(char* first, char* last, const ipv6_addr& addr)
+    {
+        const std::uint8_t* bytes = addr.data();
+        std::array<unsigned int, 8> words;
+        for (std::size_t k = 0; k < 8; ++k) {
+            words[k] = (static_cast<unsigned int>(bytes[2 * k]) << 8) | bytes[2 * k + 1];
+        }
+
+        // find the longest run of zero groups
+        int best_base = -1;
+        int best_len = 0;
+        int cur_base = -1;
+        int cur_len = 0;
+        for (int k = 0; k < 8; ++k) {
+            if (words[k] == 0) {
+                if (cur_base < 0) {
+                    cur_base = k;
+                    cur_len = 1;
+                } else {
+                    ++cur_len;
+                }
+            } else if (cur_base >= 0) {
+                if (cur_len > best_len) {
+                    best_base = cur_base;
+                    best_len = cur_len;
+                }
+                cur_base = -1;
+            }
+        }
+        if (cur_base >= 0 && cur_len > best_len) {
+            best_base = cur_base;
+            best_len = cur_len;
+        }
+        if (best_len < 2) {
+            best_base = -1;
+        }
+
+        std::array<char, 48> buf;
+        char* p = buf.data();
+        for (int k = 0; k < 8; ++k) {
+            if (best_base >= 0 && k >= best_base && k < best_base + best_len) {
+                if (k == best_base) {
+                    *p++ = ':';
+                }
+                continue;
+            }
+            if (k != 0) {
+                *p++ = ':';
+            }
+            if (k == 6 && best_base == 0 && (best_len == 6 || (best_len == 5 && words[5] == 0xffff))) {
+                p = detail::write_ipv4(p, bytes + 12);
+                break;
+            }
+            p = detail::write_hex16(p, words[k]);
+        }
+        if (best_base >= 0 && best_base + best_len == 8) {
+            *p++ = ':';
+        }
+        return detail::copy_chars(first, last, buf.data(), p - buf.data());
+    }
+
+    /** Writes a network in CIDR notation, e.g. `192.0.2.0/24`. */
+    inline std::to_chars_result to_chars(char* first, char* last, const ipv4_network& network)
+    {
+        std::to_chars_result result = to_chars(first, last, network.address());
+        if (result.ec != std::errc{} || result.ptr == last) {
+            return { last, std::errc::value_too_large };
+        }
+        *result.ptr++ = '/';
+        return std::to_chars(result.ptr, last, network.prefix_length());
+    }
+
+    /** Writes a network in CIDR notation, e.g. `2001:db8::/32`. */
+    inline std::to_chars_result to_chars(char* first, char* last, const ipv6_network& network)
+    {
+        std::to_chars_result result = to_chars(first, last, network.address());
+        if (result.ec != std::errc{} || result.ptr == last) {
+            return { last, std::errc::value_too_large };
+        }
+        *result.ptr++ = '/';
+        return std::to_chars(result.ptr, last, network.prefix_length());
+    }
+
+    inline std::to_chars_result to_chars(char* first, char* last, const date& d)
+    {
+        // 1984-01-01
+        std::array<char, 40> buf;
+        std::size_t len = detail::write_any_date_time(buf.data(), d.year, d.month, d.day, 0, 0, 0, 0) - 19;
+        return detail::copy_chars(first, last, buf.data(), len);
+    }
+
+    /** Writes an RFC 3339 date-time string with 9 fractional digits, and a `Z` suffix or time zone offset. */
+    inline std::to_chars_result to_chars(char* first, char* last, const datetime& dt)
+    {
+        // 1984-01-01 01:02:03.123456789Z
+        // 1984-01-01 01:02:03.123456789+01:00
+        std::array<char, 48> buf;
+        std::size_t len = detail::write_any_date_time(buf.data(), dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second, dt.nanosecond);
+        int offset = dt.offset.minutes();
+        if (offset == 0) {
+            buf[len++] = 'Z';
+        } else {
+            unsigned int value = static_cast<unsigned int>(offset > 0 ? offset : -offset);
+            buf[len++] = offset > 0 ? '+' : '-';
+            detail::write_2digits(buf.data() + len, value / 60 % 100);
+            buf[len + 2] = ':';
+            detail::write_2digits(buf.data() + len + 3, value % 60);
+            len += 5;
+        }
+        return detail::copy_chars(first, last, buf.data(), len);
+    }
+
+    /** Writes an RFC 3339 date-time string in UTC with 6 fractional digits; writes nothing for an unset timestamp. */
+    inline std::to_chars_result to_chars(char* first, char* last, const microtime& ts)
+    {
+        if (ts.undefined()) {
+            return { first, std::errc{} };
+        }
+
+        // 1984-01-01 01:02:03.123456Z
+        datetime dt = ts.as_datetime();
+        std::array<char, 48> buf;
+        std::size_t len = detail::write_any_date_time(buf.data(), dt.year, dt.month, dt.day, dt.hour, dt.minute, dt.second, dt.nanosecond) - 3;
+        buf[len++] = 'Z';
+        return detail::copy_chars(first, last, buf.data(), len);
+    }
+
+    /** Writes an RFC 4122 UUID string in the 8-4-4-4-12 format with lowercase hexadecimal digits. */
+    inline std::to_chars_result to_chars(char* first, char* last, const uuid& u)
+    {
+        // f81d4fae-7dec-11d0-a765-00a0c91e6bf6
+        std::array<char, 48> buf;
+
+#if defined(SIMDPARSE_AVX2)
+        if (detail::use_avx2()) {
+            detail::write_uuid_simd(buf.data(), u.data());
+            return detail::copy_chars(first, last, buf.data(), 36);
+        }
+#endif
+        static constexpr char hex_digits[] = "0123456789abcdef";
+        const std::uint8_t* id = u.data();
+        char* p = buf.data();
+        for (std::size_t k = 0; k < 16; ++k) {
+            if (k == 4 || k == 6 || k == 8 || k == 10) {
+                *p++ = '-';
+            }
+            *p++ = hex_digits[id[k] >> 4];
+            *p++ = hex_digits[id[k] & 0xf];
+        }
+
+        return detail::copy_chars(first, last, buf.data(), 36);
+    }
+
+    /**
+     * Writes the text representation of a sequence of objects, separated by a delimiter character.
+     *
+     * @returns The end of the written characters, or an error if the buffer is too small to hold all objects.
+     */
+    template<typename T>
+    std::to_chars_result to_chars(char* first, char* last, const T* items, std::size_t count, char separator)
+    {
+        char* p = first;
+        for (std::size_t k = 0; k < count; ++k) {
+            if (k > 0) {
+                if (p == last) {
+                    return { last, std::errc::value_too_large };
+                }
+                *p++ = separator;
+            }
+            std::to_chars_result result = to_chars(p, last, items[k]);
+            if (result.ec != std::errc{}) {
+                return result;
+            }
+            p = result.ptr;
+        }
+        return { p, std::errc{} };
+    }
+
+    namespace detail
+    {
+        template<std::size_t N, typename T>
+        std::string to_string_with(const T& obj)
+        {
+            std::array<char, N> buf;
+            std::to_chars_result result = to_chars(buf.data(), buf.data() + buf.size(), obj);
+            return std::string(buf.data(), result.ptr);
+        }
+    }
+
     inline std::string to_string(const decimal_integer& i)
     {
         return std::to_string(i.value);
     }
 
-    inline std::string to_string(const hexadecimal_integer& i)
+    inline std::string to_string(const signed_decimal& i)
     {
         return std::to_string(i.value);
     }
 
+    template<unsigned int Scale>
+    std::string to_string(const fixed_decimal<Scale>& d)
+    {
+        const std::uint64_t magnitude = d.value < 0 ? 0 - static_cast<std::uint64_t>(d.value) : static_cast<std::uint64_t>(d.value);
+        std::string str = (d.value < 0 ? "-" : "") + std::to_string(magnitude / detail::powers_of_ten[Scale]);
+        if constexpr (Scale > 0) {
+            const std::string fraction = std::to_string(magnitude % detail::powers_of_ten[Scale]);
+            str += '.';
+            str.append(Scale - fraction.size(), '0');
+            str += fraction;
+        }
+        return str;
+    }
+
+    inline std::string to_string(const floating_point& f)
+    {
+        std::array<char, 32> buf;
+        const int n = std::snprintf(buf.data(), buf.size(), "%.17g", f.value);
+        return std::string(buf.data(), n);
+    }
+
+    inline std::string to_string(const hexadecimal_integer& i)
+    {
+        return detail::to_string_with<16>(i);
+    }
+
+    inline std::string to_string(const uint128& i)
+    {
+        return detail::to_string_with<32>(i);
+    }
+
     inline std::string to_string(const ipv4_addr& addr)
     {
-        char addr_str[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, addr.data(), addr_str, sizeof(addr_str));
-        return addr_str;
+        return detail::to_string_with<16>(addr);
     }
 
     inline std::string to_string(const ipv6_addr& addr)
     {
-        char addr_str[INET6_ADDRSTRLEN];
-        inet_ntop(AF_INET6, addr.data(), addr_str, sizeof(addr_str));
-        return addr_str;
+        return detail::to_string_with<48>(addr);
+    }
+
+    inline std::string to_string(const ipv4_network& network)
+    {
+        return detail::to_string_with<24>(network);
+    }
+
+    inline std::string to_string(const ipv6_network& network)
+    {
+        return detail::to_string_with<56>(network);
     }
 
     inline std::string to_string(const date& d)
     {
-        char buf[16];
-        int n = std::snprintf(buf, sizeof(buf), "%.4d-%02u-%02u",
-            d.year,
-            d.month,
-            d.day
-        );
-        return std::string(buf, buf + n);
+        return detail::to_string_with<32>(d);
     }
 
     inline std::string to_string(const datetime& dt)
     {
-        // 1984-01-01 01:02:03.123456789Z
-        char buf[64];
-        int n = std::snprintf(buf, sizeof(buf), "%.4d-%02u-%02u %02u:%02u:%02u.%09luZ",
-            dt.year,
-            dt.month,
-            dt.day,
-            dt.hour,
-            dt.minute,
-            dt.second,
-            dt.nanosecond
-        );
-        return std::string(buf, buf + n);
+        return detail::to_string_with<64>(dt);
     }
 
     inline std::string to_string(const microtime& ts)
     {
-        std::time_t tv = ts.as_time();
-        std::tm* tp = gmtime(&tv);
-        if (tp == nullptr) {
-            return std::string();
-        }
-
-        // 1984-01-01 01:02:03.123456Z
-        char buf[32];
-        int n = std::snprintf(buf, sizeof(buf), "%.4d-%02u-%02u %02u:%02u:%02u.%06luZ",
-            tp->tm_year + 1900,
-            tp->tm_mon + 1,
-            tp->tm_mday,
-            tp->tm_hour,
-            tp->tm_min,
-            tp->tm_sec,
-            ts.microseconds()
-        );
-        return std::string(buf, buf + n);
+        return detail::to_string_with<64>(ts);
     }
 
     inline std::string to_string(const uuid& u)
     {
-        const std::uint8_t* id = u.data();
-        char buf[37];
-        int n = std::snprintf(buf, sizeof(buf),
-            "%2hhx%2hhx%2hhx%2hhx-"
-            "%2hhx%2hhx-"
-            "%2hhx%2hhx-"
-            "%2hhx%2hhx-"
-            "%2hhx%2hhx%2hhx%2hhx%2hhx%2hhx",
-            id[0], id[1], id[2], id[3],
-            id[4], id[5],
-            id[6], id[7],
-            id[8], id[9],
-            id[10], id[11], id[12], id[13], id[14], id[15]
-        );
-        return std::string(buf, buf + n);
+        return detail::to_string_with<48>(u);
     }
 }
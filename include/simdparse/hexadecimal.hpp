@@ -1,17 +1,229 @@
 #pragma once
+#include <array>
+#include <string>
 #include <string_view>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
-
-#if defined(__AVX2__)
-#include <array>
 #include <cstring>
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+#include "stats.hpp"
+#include "uuid.hpp"
+
+#if defined(SIMDPARSE_AVX2)
 #include <immintrin.h>
-#else
-#include <charconv>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace simdparse
 {
+    namespace detail
+    {
+        /** Maps each character to its 4-bit value, or 16 if the character is not a hexadecimal digit. */
+        constexpr std::array<unsigned char, 256> make_hex_decoding_table()
+        {
+            std::array<unsigned char, 256> table = {};
+            for (unsigned char& value : table) {
+                value = 16;
+            }
+            for (unsigned char k = 0; k < 10; ++k) {
+                table['0' + k] = k;
+            }
+            for (unsigned char k = 0; k < 6; ++k) {
+                table['a' + k] = static_cast<unsigned char>(10 + k);
+                table['A' + k] = static_cast<unsigned char>(10 + k);
+            }
+            return table;
+        }
+
+        constexpr inline std::array<unsigned char, 256> hex_decoding_table = make_hex_decoding_table();
+
+        constexpr inline std::string_view hex_digits = "0123456789abcdef";
+
+#if defined(SIMDPARSE_AVX2)
+        /** Decodes the given number of blocks of 32 hexadecimal characters into 16 bytes each. */
+        SIMDPARSE_TARGET_AVX2 inline bool hex_decode_blocks(const char* input, std::size_t count, std::byte* output)
+        {
+            for (std::size_t k = 0; k < count; ++k) {
+                const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + 32 * k));
+                __m128i value;
+                if (!parse_uuid(characters, value)) {
+                    return false;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16 * k), value);
+            }
+            return true;
+        }
+
+        /** Encodes the given number of blocks of 16 bytes into 32 lowercase hexadecimal characters each. */
+        SIMDPARSE_TARGET_AVX2 inline void hex_encode_blocks(const std::byte* input, std::size_t count, char* output)
+        {
+            const __m256i lookup = _mm256_setr_epi8(
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+            for (std::size_t k = 0; k < count; ++k) {
+                // split bytes into high and low nibbles, most significant nibble first
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16 * k));
+                const __m128i low_nibbles = _mm_and_si128(bytes, _mm_set1_epi8(0x0f));
+                const __m128i high_nibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0f));
+                const __m256i nibbles = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi8(high_nibbles, low_nibbles)), _mm_unpackhi_epi8(high_nibbles, low_nibbles), 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32 * k), _mm256_shuffle_epi8(lookup, nibbles));
+            }
+        }
+#elif defined(SIMDPARSE_NEON)
+        /** Decodes the given number of blocks of 32 hexadecimal characters into 16 bytes each. */
+        inline bool hex_decode_blocks(const char* input, std::size_t count, std::byte* output)
+        {
+            for (std::size_t k = 0; k < count; ++k) {
+                const std::uint8_t* chars = reinterpret_cast<const std::uint8_t*>(input + 32 * k);
+                uint8x16_t value;
+                if (!parse_uuid(vld1q_u8(chars), vld1q_u8(chars + 16), value)) {
+                    return false;
+                }
+                vst1q_u8(reinterpret_cast<std::uint8_t*>(output + 16 * k), value);
+            }
+            return true;
+        }
+
+        /** Encodes the given number of blocks of 16 bytes into 32 lowercase hexadecimal characters each. */
+        inline void hex_encode_blocks(const std::byte* input, std::size_t count, char* output)
+        {
+            const uint8x16_t lookup = vld1q_u8(reinterpret_cast<const std::uint8_t*>(hex_digits.data()));
+            for (std::size_t k = 0; k < count; ++k) {
+                // look up the digits of the high and low nibbles, and interleave them with a structured store
+                const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(input + 16 * k));
+                const uint8x16x2_t digits = { { vqtbl1q_u8(lookup, vshrq_n_u8(bytes, 4)), vqtbl1q_u8(lookup, vandq_u8(bytes, vdupq_n_u8(0x0f))) } };
+                vst2q_u8(reinterpret_cast<std::uint8_t*>(output + 32 * k), digits);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Converts between binary data and its hexadecimal representation, e.g. a SHA-256 digest of 64 characters.
+     *
+     * Decoding accepts both uppercase and lowercase digits; encoding produces lowercase digits. Blocks of 32
+     * characters are converted with the same kernel as `uuid`.
+     */
+    struct hex
+    {
+        constexpr static std::string_view name = "hexadecimal string";
+
+        /** Returned by functions that write into a caller-provided buffer when the input is invalid or the buffer is too small. */
+        constexpr static std::size_t npos = static_cast<std::size_t>(-1);
+
+        /** Number of characters that encode the given number of bytes. */
+        constexpr static std::size_t encoded_size(std::size_t byte_count)
+        {
+            return 2 * byte_count;
+        }
+
+        /** Number of bytes that a string of the given length decodes into, if the length is valid. */
+        constexpr static std::size_t decoded_size(std::size_t char_count)
+        {
+            return char_count / 2;
+        }
+
+        /**
+         * Encodes bytes into a caller-provided buffer.
+         *
+         * @returns Number of characters written, or `npos` if the buffer is smaller than `encoded_size(input.size())`.
+         */
+        static std::size_t encode(const std::basic_string_view<std::byte>& input, char* output, std::size_t capacity)
+        {
+            if (capacity < encoded_size(input.size())) {
+                return npos;
+            }
+
+            std::size_t i = 0;
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                const std::size_t blocks = input.size() / 16;
+                detail::hex_encode_blocks(input.data(), blocks, output);
+                i = 16 * blocks;
+            }
+#endif
+            for (; i < input.size(); ++i) {
+                const unsigned int byte = static_cast<unsigned int>(input[i]);
+                output[2 * i] = detail::hex_digits[byte >> 4];
+                output[2 * i + 1] = detail::hex_digits[byte & 0x0f];
+            }
+            return encoded_size(input.size());
+        }
+
+        static bool encode(const std::basic_string_view<std::byte>& input, std::string& output)
+        {
+            output.resize(encoded_size(input.size()));
+            encode(input, output.data(), output.size());
+            return true;
+        }
+
+        static std::string encode(const std::basic_string_view<std::byte>& input)
+        {
+            std::string output;
+            encode(input, output);
+            return output;
+        }
+
+        static std::string encode(const std::basic_string<std::byte>& input)
+        {
+            return encode(std::basic_string_view<std::byte>(input.data(), input.size()));
+        }
+
+        /**
+         * Decodes a string into a caller-provided buffer.
+         *
+         * @returns Number of bytes written, or `npos` if the input has an odd length, has a character that is not a
+         * hexadecimal digit, or the buffer is smaller than `decoded_size(input.size())`.
+         */
+        static std::size_t decode(const std::string_view& input, std::byte* output, std::size_t capacity)
+        {
+            SIMDPARSE_COUNT(hex_decode_calls);
+            if (input.size() % 2 != 0 || capacity < decoded_size(input.size())) {
+                SIMDPARSE_COUNT(hex_decode_failures);
+                return npos;
+            }
+
+            std::size_t i = 0;
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                const std::size_t blocks = input.size() / 32;
+                if (!detail::hex_decode_blocks(input.data(), blocks, output)) {
+                    SIMDPARSE_COUNT(hex_decode_failures);
+                    return npos;
+                }
+                SIMDPARSE_COUNT_N(hex_blocks32, blocks);
+                i = 32 * blocks;
+            }
+#endif
+
+            SIMDPARSE_COUNT_N(hex_scalar, input.size() - i);
+            for (; i < input.size(); i += 2) {
+                const unsigned int high = detail::hex_decoding_table[static_cast<unsigned char>(input[i])];
+                const unsigned int low = detail::hex_decoding_table[static_cast<unsigned char>(input[i + 1])];
+                if (((high | low) & 16) != 0) {
+                    SIMDPARSE_COUNT(hex_decode_failures);
+                    return npos;
+                }
+                output[i / 2] = static_cast<std::byte>((high << 4) | low);
+            }
+            return decoded_size(input.size());
+        }
+
+        static bool decode(const std::string_view& input, std::basic_string<std::byte>& output)
+        {
+            output.resize(decoded_size(input.size()));
+            return decode(input, output.data(), output.size()) != npos;
+        }
+
+        static bool decode(const std::string& input, std::basic_string<std::byte>& output)
+        {
+            return decode(std::string_view(input.data(), input.size()), output);
+        }
+    };
+
     struct hexadecimal_integer
     {
         constexpr static std::string_view name = "hexadecimal integer";
@@ -70,31 +282,63 @@ namespace simdparse
         /** Parses a hexadecimal string into an integer value. */
         bool parse(const std::string_view& str)
         {
+            return parse_prefixed<false>(str);
+        }
+
+        /** Parses a hexadecimal string into an integer value, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_prefixed<true>(str);
+        }
+
+    private:
+        template<bool Padded>
+        bool parse_prefixed(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(hexadecimal_calls);
             if (str.size() > 2) {
                 if (str[0] == '0' && str[1] == 'x') {
-                    return parse_string(str.substr(2));
+                    return parse_string<Padded>(str.substr(2));
                 }
             }
-            return parse_string(str);
+            return parse_string<Padded>(str);
         }
 
-    private:
+        template<bool Padded>
         bool parse_string(const std::string_view& str)
         {
             if (str.size() > 16) {
+                SIMDPARSE_COUNT(hexadecimal_failures);
                 return false;
             }
-            return parse_hexadecimal(str);
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(hexadecimal_simd);
+                return SIMDPARSE_COUNT_RESULT(hexadecimal_failures, parse_hexadecimal_simd<Padded>(str));
+            }
+#endif
+            SIMDPARSE_COUNT(hexadecimal_scalar);
+            return SIMDPARSE_COUNT_RESULT(hexadecimal_failures, parse_hexadecimal(str));
         }
 
-#if defined(__AVX2__)
-        /** Parses the string representation of an integer with SIMD instructions. */
-        bool parse_hexadecimal(const std::string_view& str)
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Parses the string representation of an integer with SIMD instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool parse_hexadecimal_simd(const std::string_view& str)
         {
-            alignas(__m128i) std::array<char, 16> buf;
-            std::memset(buf.data(), '0', 16 - str.size());
-            std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
-            const __m128i characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            __m128i characters;
+            if constexpr (Padded) {
+                characters = detail::load_right_aligned(str.data(), str.size(), '0');
+            } else {
+                alignas(__m128i) std::array<char, 16> buf;
+                std::memset(buf.data(), '0', 16 - str.size());
+                std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
+                characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+            }
 
             const __m128i digit_lower = _mm_cmpgt_epi8(_mm_set1_epi8('0'), characters);
             const __m128i digit_upper = _mm_cmpgt_epi8(characters, _mm_set1_epi8('9'));
@@ -138,15 +382,169 @@ namespace simdparse
             _mm_storel_epi64(reinterpret_cast<__m128i*>(&value), a);
             return true;
         }
-#else
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Parses the string representation of an integer with NEON instructions.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<bool Padded>
+        bool parse_hexadecimal_simd(const std::string_view& str)
+        {
+            uint8x16_t characters;
+            if constexpr (Padded) {
+                characters = detail::load_right_aligned(str.data(), str.size(), '0');
+            } else {
+                alignas(16) std::array<char, 16> buf;
+                std::memset(buf.data(), '0', 16 - str.size());
+                std::memcpy(buf.data() + 16 - str.size(), str.data(), str.size());
+                characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(buf.data()));
+            }
+
+            // offset from `0` for digits, and offset from `a` for (lowercase) letters, wrapping around if below
+            const uint8x16_t digits = vsubq_u8(characters, vdupq_n_u8('0'));
+            const uint8x16_t alphas = vsubq_u8(vorrq_u8(characters, vdupq_n_u8(0b00100000)), vdupq_n_u8('a'));
+            const uint8x16_t is_digit = vcleq_u8(digits, vdupq_n_u8(9));
+            const uint8x16_t is_alpha = vcleq_u8(alphas, vdupq_n_u8(5));
+            if (vminvq_u8(vorrq_u8(is_digit, is_alpha)) == 0) {
+                return false;
+            }
+            const uint8x16_t nibbles = vbslq_u8(is_digit, digits, vaddq_u8(alphas, vdupq_n_u8(10)));
+
+            // combine pairs of nibbles into bytes (with the high nibble in the low byte of each 16-bit integer),
+            // and reverse bytes to LSB first
+            const uint16x8_t pairs = vreinterpretq_u16_u8(nibbles);
+            const uint8x8_t bytes = vmovn_u16(vorrq_u16(vshlq_n_u16(pairs, 4), vshrq_n_u16(pairs, 8)));
+            value = vget_lane_u64(vreinterpret_u64_u8(vrev64_u8(bytes)), 0);
+            return true;
+        }
+#endif
+
         bool parse_hexadecimal(const std::string_view& str)
         {
             std::from_chars_result result = std::from_chars(str.data(), str.data() + str.size(), value, 16);
             return result.ec == std::errc{} && result.ptr == str.data() + str.size();
         }
-#endif
 
     public:
         std::uint64_t value = 0;
     };
+
+    /**
+     * An unsigned 128-bit integer with 1 to 32 hexadecimal digits and an optional `0x` prefix, e.g. a trace ID.
+     *
+     * Digits are right-aligned in a buffer of 32 characters, and converted with the same kernel as `uuid`.
+     */
+    struct uint128
+    {
+        constexpr static std::string_view name = "128-bit hexadecimal integer";
+
+        constexpr uint128()
+        {
+        }
+
+        constexpr uint128(std::uint64_t high, std::uint64_t low)
+            : high(high)
+            , low(low)
+        {
+        }
+
+        constexpr bool operator==(const uint128& op) const
+        {
+            return high == op.high && low == op.low;
+        }
+
+        constexpr bool operator!=(const uint128& op) const
+        {
+            return !(*this == op);
+        }
+
+        constexpr bool operator<(const uint128& op) const
+        {
+            return high < op.high || (high == op.high && low < op.low);
+        }
+
+        constexpr bool operator<=(const uint128& op) const
+        {
+            return !(op < *this);
+        }
+
+        constexpr bool operator>=(const uint128& op) const
+        {
+            return !(*this < op);
+        }
+
+        constexpr bool operator>(const uint128& op) const
+        {
+            return op < *this;
+        }
+
+        /** Parses a hexadecimal string into a 128-bit integer value. */
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        /** Parses a hexadecimal string into a 128-bit integer value. */
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /** Parses a hexadecimal string into a 128-bit integer value. */
+        bool parse(const std::string_view& str)
+        {
+            SIMDPARSE_COUNT(hexadecimal_calls);
+            if (str.size() > 2 && str[0] == '0' && str[1] == 'x') {
+                return SIMDPARSE_COUNT_RESULT(hexadecimal_failures, parse_string(str.substr(2)));
+            }
+            return SIMDPARSE_COUNT_RESULT(hexadecimal_failures, parse_string(str));
+        }
+
+    private:
+        bool parse_string(const std::string_view& str)
+        {
+            if (str.empty() || str.size() > 32) {
+                return false;
+            }
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(hexadecimal_simd);
+                // strings of full length (e.g. trace IDs) are converted in place
+                const char* digits = str.data();
+                std::array<char, 32> buf;
+                if (str.size() < 32) {
+                    std::memset(buf.data(), '0', 32 - str.size());
+                    std::memcpy(buf.data() + 32 - str.size(), str.data(), str.size());
+                    digits = buf.data();
+                }
+                std::array<std::uint64_t, 2> words;
+                if (!detail::hex_decode_blocks(digits, 1, reinterpret_cast<std::byte*>(words.data()))) {
+                    return false;
+                }
+                high = detail::byte_swap(words[0]);
+                low = detail::byte_swap(words[1]);
+                return true;
+            }
+#endif
+            SIMDPARSE_COUNT(hexadecimal_scalar);
+            std::uint64_t h = 0;
+            std::uint64_t l = 0;
+            for (char c : str) {
+                const std::uint64_t digit = detail::hex_decoding_table[static_cast<unsigned char>(c)];
+                if (digit == 16) {
+                    return false;
+                }
+                h = (h << 4) | (l >> 60);
+                l = (l << 4) | digit;
+            }
+            high = h;
+            low = l;
+            return true;
+        }
+
+    public:
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+    };
 }
@@ -0,0 +1,414 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <array>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include "datetime.hpp"
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace simdparse
+{
+    namespace detail
+    {
+        /**
+         * Holds the numeric value associated with each abbreviated English day name.
+         */
+        constexpr static inline std::uint16_t weekday_values[] = {
+            month_to_integer('M', 'o', 'n'),
+            month_to_integer('T', 'u', 'e'),
+            month_to_integer('W', 'e', 'd'),
+            month_to_integer('T', 'h', 'u'),
+            month_to_integer('F', 'r', 'i'),
+            month_to_integer('S', 'a', 't'),
+            month_to_integer('S', 'u', 'n'),
+            0
+        };
+    }
+
+    /**
+     * Converts an abbreviated English day name into an ordinal.
+     *
+     * This function is case insensitive.
+     *
+     * @returns `1` to `7` for `Mon` to `Sun`, respectively, or `0` on parse error.
+     */
+    constexpr inline unsigned int weekday_to_ordinal(char c1, char c2, char c3)
+    {
+        using detail::maybe_letter;
+
+        if (!maybe_letter(c1) || !maybe_letter(c2) || !maybe_letter(c3)) {
+            return 0;
+        }
+        const std::uint16_t value = detail::month_to_integer(c1, c2, c3);
+        for (unsigned int k = 0; k < 7; ++k) {
+            if (value == detail::weekday_values[k]) {
+                return k + 1;
+            }
+        }
+        return 0;
+    }
+
+    namespace detail
+    {
+        /**
+         * Layout of an HTTP date with fixed time zone `GMT`, e.g. `Sun, 06 Nov 1994 08:49:37 GMT`, as per RFC 7231.
+         *
+         * Timestamp layouts define per-position bounds for validating characters, where letters of day and month
+         * names are only checked to be in the range `A` to `z`, and a byte shuffle that gathers the digits of year,
+         * day, hour, minute, second and time zone offset into 16 bytes `YYYYDDhhmmssHHMM`. The first 16 shuffle
+         * indices select from the first 16 characters, the next 16 indices from the next 16 characters.
+         */
+        struct http_date_gmt_layout
+        {
+            constexpr static std::size_t size = 29;
+            constexpr static bool has_weekday = true;
+            constexpr static std::size_t weekday = 0;
+            constexpr static std::size_t month = 8;
+            constexpr static bool has_zone = false;
+            constexpr static std::size_t zone = 0;
+
+            constexpr static char lower_bound[32] = "AAA, 00 AAA 0000 00:00:00 GMT";
+            constexpr static char upper_bound[32] = "zzz, 39 zzz 9999 29:59:59 GMT";
+            constexpr static std::int8_t shuffle[32] = {
+                12, 13, 14, 15,  // year
+                5, 6,            // day
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1,
+                1, 2,            // hour
+                4, 5,            // minute
+                7, 8,            // second
+                -1, -1, -1, -1
+            };
+        };
+
+        /** Layout of an RFC 2822 date with numeric time zone, e.g. `Sun, 06 Nov 1994 08:49:37 +0100`. */
+        struct http_date_offset_layout
+        {
+            constexpr static std::size_t size = 31;
+            constexpr static bool has_weekday = true;
+            constexpr static std::size_t weekday = 0;
+            constexpr static std::size_t month = 8;
+            constexpr static bool has_zone = true;
+            constexpr static std::size_t zone = 26;
+
+            // sign is checked separately as there is a character between `+` and `-`
+            constexpr static char lower_bound[32] = "AAA, 00 AAA 0000 00:00:00 +0000";
+            constexpr static char upper_bound[32] = "zzz, 39 zzz 9999 29:59:59 -9959";
+            constexpr static std::int8_t shuffle[32] = {
+                12, 13, 14, 15,  // year
+                5, 6,            // day
+                -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1,
+                1, 2,            // hour
+                4, 5,            // minute
+                7, 8,            // second
+                11, 12,          // offset hours
+                13, 14           // offset minutes
+            };
+        };
+
+        /** Layout of an Apache Common Log Format timestamp, e.g. `10/Oct/2000:13:55:36 -0700`. */
+        struct clf_datetime_layout
+        {
+            constexpr static std::size_t size = 26;
+            constexpr static bool has_weekday = false;
+            constexpr static std::size_t weekday = 0;
+            constexpr static std::size_t month = 3;
+            constexpr static bool has_zone = true;
+            constexpr static std::size_t zone = 21;
+
+            constexpr static char lower_bound[32] = "00/AAA/0000:00:00:00 +0000";
+            constexpr static char upper_bound[32] = "39/zzz/9999:29:59:59 -9959";
+            constexpr static std::int8_t shuffle[32] = {
+                7, 8, 9, 10,    // year
+                0, 1,           // day
+                12, 13,         // hour
+                15,             // minute (first digit)
+                -1, -1, -1, -1, -1, -1, -1,
+                -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                0,              // minute (second digit)
+                2, 3,           // second
+                6, 7,           // offset hours
+                8, 9            // offset minutes
+            };
+        };
+
+        /**
+         * Validates the characters of a timestamp against per-position bounds, and fuses neighboring digits.
+         *
+         * On success, the output holds year (as two values to be combined), day, hour, minute, second, and the hours
+         * and minutes of the time zone offset. Equivalent to the vectorized variant.
+         */
+        template<typename Layout>
+        bool fuse_timestamp_digits(const char* str, std::array<std::uint16_t, 8>& values)
+        {
+            for (std::size_t k = 0; k < Layout::size; ++k) {
+                if (str[k] < Layout::lower_bound[k] || str[k] > Layout::upper_bound[k]) {
+                    return false;
+                }
+            }
+
+            std::array<std::uint8_t, 16> digits = {};
+            for (std::size_t k = 0; k < 16; ++k) {
+                if (Layout::shuffle[k] >= 0) {
+                    digits[k] |= str[Layout::shuffle[k]] & 0x0f;
+                }
+                if (Layout::shuffle[16 + k] >= 0) {
+                    digits[k] |= str[16 + Layout::shuffle[16 + k]] & 0x0f;
+                }
+            }
+            for (std::size_t k = 0; k < 8; ++k) {
+                values[k] = static_cast<std::uint16_t>(10 * digits[2 * k] + digits[2 * k + 1]);
+            }
+            return true;
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Converts an abbreviated English month name into an ordinal, comparing against all month names at once.
+         *
+         * @returns `1` to `12` for `Jan` to `Dec`, respectively, or `0` if there is no match.
+         */
+        SIMDPARSE_TARGET_AVX2 inline unsigned int month_to_ordinal_simd(char c1, char c2, char c3)
+        {
+            const __m256i names = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(month_values));
+            const __m256i value = _mm256_set1_epi16(static_cast<short>(month_to_integer(c1, c2, c3)));
+            // ignore the padding lanes past the 12 month names, which hold zero
+            const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(names, value))) & 0xffffff;
+            return mask != 0 ? count_trailing_zeros(mask) / 2 + 1 : 0;
+        }
+
+        /**
+         * Converts an abbreviated English day name into an ordinal, comparing against all day names at once.
+         *
+         * @returns `1` to `7` for `Mon` to `Sun`, respectively, or `0` if there is no match.
+         */
+        SIMDPARSE_TARGET_AVX2 inline unsigned int weekday_to_ordinal_simd(char c1, char c2, char c3)
+        {
+            const __m128i names = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weekday_values));
+            const __m128i value = _mm_set1_epi16(static_cast<short>(month_to_integer(c1, c2, c3)));
+            // ignore the padding lane past the 7 day names, which holds zero
+            const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(names, value))) & 0x3fff;
+            return mask != 0 ? count_trailing_zeros(mask) / 2 + 1 : 0;
+        }
+
+        /**
+         * Validates the characters of a timestamp against per-position bounds, and fuses neighboring digits using
+         * SIMD instructions.
+         *
+         * Characters are checked in a single 256-bit comparison, digits of both lanes are gathered into 16 bytes
+         * with a byte shuffle, and neighboring digits are fused with a multiply-add.
+         *
+         * @tparam Padded True if the string is followed by padding, and can be loaded without a copy.
+         */
+        template<typename Layout, bool Padded>
+        SIMDPARSE_TARGET_AVX2 bool fuse_timestamp_digits_simd(const char* str, std::array<std::uint16_t, 8>& values)
+        {
+            const __m256i characters = load_fixed_size<Layout::size, Padded>(str);
+
+            const __m256i lower_bound = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Layout::lower_bound));
+            const __m256i upper_bound = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Layout::upper_bound));
+            const __m256i too_low = _mm256_cmpgt_epi8(lower_bound, characters);
+            const __m256i too_high = _mm256_cmpgt_epi8(characters, upper_bound);
+            if (_mm256_movemask_epi8(_mm256_or_si256(too_low, too_high))) {
+                return false;
+            }
+
+            // gather digits `YYYYDDhhmmssHHMM` from both lanes, with empty positions yielding zero
+            const __m256i spread_integers = _mm256_and_si256(characters, _mm256_set1_epi8(0x0f));
+            const __m256i shuffle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Layout::shuffle));
+            const __m256i gathered = _mm256_shuffle_epi8(spread_integers, shuffle);
+            const __m128i packed_integers = _mm_or_si128(_mm256_castsi256_si128(gathered), _mm256_extracti128_si256(gathered, 1));
+
+            // fuse neighboring digits into a single value
+            const __m128i weights = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+            const __m128i fused = _mm_maddubs_epi16(packed_integers, weights);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values.data()), fused);
+            return true;
+        }
+#endif
+
+        /**
+         * Assigns the fields of a validated timestamp to a date-time object, and checks their range.
+         *
+         * @param values Fields fused with `fuse_timestamp_digits`.
+         */
+        template<typename Layout>
+        bool assign_timestamp(const char* str, const std::array<std::uint16_t, 8>& values, unsigned int month, unsigned int weekday, datetime& dt)
+        {
+            int sign = 1;
+            if constexpr (Layout::has_zone) {
+                sign = (str[Layout::zone] == '+') - (str[Layout::zone] == '-');
+            }
+
+            dt.year = 100 * values[0] + values[1];
+            dt.month = month;
+            dt.day = values[2];
+            dt.hour = values[3];
+            dt.minute = values[4];
+            dt.second = values[5];
+            dt.nanosecond = 0;
+            dt.offset.assign(sign * (60 * values[6] + values[7]));
+
+            // bounds on the first digit already limit minutes and seconds
+            return month != 0
+                && weekday != 0
+                && sign != 0
+                && dt.day >= 1 && dt.day <= 31
+                && dt.hour < 24
+                ;
+        }
+
+        /** Parses a timestamp in the given layout into a date-time object. */
+        template<typename Layout, bool Padded>
+        bool parse_timestamp(const std::string_view& str, datetime& dt)
+        {
+            const char* p = str.data();
+            std::array<std::uint16_t, 8> values;
+#if defined(SIMDPARSE_AVX2)
+            if (use_avx2()) {
+                if (!fuse_timestamp_digits_simd<Layout, Padded>(p, values)) {
+                    return false;
+                }
+                const unsigned int month = month_to_ordinal_simd(p[Layout::month], p[Layout::month + 1], p[Layout::month + 2]);
+                unsigned int weekday = 1;
+                if constexpr (Layout::has_weekday) {
+                    weekday = weekday_to_ordinal_simd(p[Layout::weekday], p[Layout::weekday + 1], p[Layout::weekday + 2]);
+                }
+                return assign_timestamp<Layout>(p, values, month, weekday, dt);
+            }
+#endif
+            if (!fuse_timestamp_digits<Layout>(p, values)) {
+                return false;
+            }
+            const unsigned int month = month_to_ordinal(p[Layout::month], p[Layout::month + 1], p[Layout::month + 2]);
+            unsigned int weekday = 1;
+            if constexpr (Layout::has_weekday) {
+                weekday = weekday_to_ordinal(p[Layout::weekday], p[Layout::weekday + 1], p[Layout::weekday + 2]);
+            }
+            return assign_timestamp<Layout>(p, values, month, weekday, dt);
+        }
+    }
+
+    /**
+     * Date and time parsed from an HTTP date string, with time zone `GMT` or a numeric offset.
+     *
+     * Accepts the preferred format of RFC 7231 (IMF-fixdate) `Sun, 06 Nov 1994 08:49:37 GMT`, and the RFC 2822
+     * format with a numeric time zone `Sun, 06 Nov 1994 08:49:37 +0100`, both with a two-digit day. Day and month
+     * names are case insensitive; the day name is validated but not checked against the date.
+     */
+    struct http_date : datetime
+    {
+        constexpr static std::string_view name = "HTTP date";
+
+        using datetime::datetime;
+
+        constexpr http_date()
+        {
+        }
+
+        constexpr http_date(const datetime& dt)
+            : datetime(dt)
+        {
+        }
+
+        bool parse(const std::string_view& str)
+        {
+            return parse_http_date<false>(str);
+        }
+
+        /** Parses an HTTP date string, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_http_date<true>(str);
+        }
+
+        /** Microseconds since the epoch. */
+        constexpr microtime as_microtime() const
+        {
+            return microtime(year, month, day, hour, minute, second, nanosecond / 1'000, offset);
+        }
+
+    private:
+        template<bool Padded>
+        bool parse_http_date(const std::string_view& str)
+        {
+            if (str.size() == detail::http_date_gmt_layout::size) {
+                return detail::parse_timestamp<detail::http_date_gmt_layout, Padded>(str, *this);
+            } else if (str.size() == detail::http_date_offset_layout::size) {
+                return detail::parse_timestamp<detail::http_date_offset_layout, Padded>(str, *this);
+            } else {
+                return false;
+            }
+        }
+    };
+
+    /**
+     * Date and time parsed from a timestamp in the Apache Common Log Format (CLF).
+     *
+     * Accepts `10/Oct/2000:13:55:36 -0700`, optionally enclosed in square brackets as written by `%t` in access logs.
+     * Month names are case insensitive.
+     */
+    struct clf_datetime : datetime
+    {
+        constexpr static std::string_view name = "CLF date-time";
+
+        using datetime::datetime;
+
+        constexpr clf_datetime()
+        {
+        }
+
+        constexpr clf_datetime(const datetime& dt)
+            : datetime(dt)
+        {
+        }
+
+        bool parse(const std::string_view& str)
+        {
+            return parse_clf_datetime<false>(str);
+        }
+
+        /** Parses a CLF timestamp, reading directly from the padded input. */
+        bool parse(const padded_string_view& str)
+        {
+            return parse_clf_datetime<true>(str);
+        }
+
+        /** Microseconds since the epoch. */
+        constexpr microtime as_microtime() const
+        {
+            return microtime(year, month, day, hour, minute, second, nanosecond / 1'000, offset);
+        }
+
+    private:
+        template<bool Padded>
+        bool parse_clf_datetime(const std::string_view& str)
+        {
+            using layout = detail::clf_datetime_layout;
+            if (str.size() == layout::size) {
+                return detail::parse_timestamp<layout, Padded>(str, *this);
+            } else if (str.size() == layout::size + 2 && str.front() == '[' && str.back() == ']') {
+                // skip opening and closing square brackets
+                return detail::parse_timestamp<layout, Padded>(str.substr(1, layout::size), *this);
+            } else {
+                return false;
+            }
+        }
+    };
+}
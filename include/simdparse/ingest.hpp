@@ -0,0 +1,368 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "scanner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+
+#if defined(_WIN32) || defined(_WIN64)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace simdparse
+{
+    /**
+     * A read-only memory mapping of an entire file.
+     *
+     * The operating system is advised that the mapping is read sequentially, which enables aggressive read-ahead.
+     */
+    struct mapped_file
+    {
+        /** Maps a file into memory. Throws `std::system_error` if the file cannot be opened or mapped. */
+        explicit mapped_file(const char* path)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "cannot open file");
+            }
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size)) {
+                const DWORD error = GetLastError();
+                CloseHandle(file);
+                throw std::system_error(static_cast<int>(error), std::system_category(), "cannot get file size");
+            }
+            _size = static_cast<std::size_t>(size.QuadPart);
+            if (_size > 0) {
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr) {
+                    const DWORD error = GetLastError();
+                    CloseHandle(file);
+                    throw std::system_error(static_cast<int>(error), std::system_category(), "cannot map file");
+                }
+                _data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                const DWORD error = GetLastError();
+                CloseHandle(mapping);
+                if (_data == nullptr) {
+                    CloseHandle(file);
+                    throw std::system_error(static_cast<int>(error), std::system_category(), "cannot map file");
+                }
+            }
+            CloseHandle(file);
+#else
+            const int fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "cannot open file");
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "cannot get file size");
+            }
+            _size = static_cast<std::size_t>(st.st_size);
+            if (_size > 0) {
+                void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "cannot map file");
+                }
+                ::madvise(addr, _size, MADV_SEQUENTIAL);
+                _data = static_cast<const char*>(addr);
+            }
+            ::close(fd);
+#endif
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& op) noexcept
+            : _data(std::exchange(op._data, nullptr))
+            , _size(std::exchange(op._size, 0))
+        {
+        }
+
+        mapped_file& operator=(mapped_file&& op) noexcept
+        {
+            if (this != &op) {
+                unmap();
+                _data = std::exchange(op._data, nullptr);
+                _size = std::exchange(op._size, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file()
+        {
+            unmap();
+        }
+
+        const char* data() const
+        {
+            return _data;
+        }
+
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+        /** Contents of the file. */
+        std::string_view view() const
+        {
+            return std::string_view(_data, _size);
+        }
+
+    private:
+        void unmap()
+        {
+            if (_data == nullptr) {
+                return;
+            }
+#if defined(_WIN32) || defined(_WIN64)
+            UnmapViewOfFile(_data);
+#else
+            ::munmap(const_cast<char*>(_data), _size);
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        const char* _data = nullptr;
+        std::size_t _size = 0;
+    };
+
+    /**
+     * Splits a buffer into (at most) the given number of chunks of about the same size, each ending with a line feed.
+     *
+     * The last chunk extends to the end of the buffer. Lines are never split, hence quoted fields must not contain
+     * line feeds if chunks are scanned independently.
+     */
+    inline std::vector<std::string_view> split_lines(const std::string_view& buffer, std::size_t count)
+    {
+        std::vector<std::string_view> chunks;
+        if (buffer.empty() || count == 0) {
+            return chunks;
+        }
+
+        const std::size_t target = (buffer.size() + count - 1) / count;
+        std::size_t start = 0;
+        while (start < buffer.size()) {
+            std::size_t end = start + target;
+            if (end >= buffer.size()) {
+                end = buffer.size();
+            } else {
+                const std::size_t newline = buffer.find('\n', end - 1);
+                end = newline == std::string_view::npos ? buffer.size() : newline + 1;
+            }
+            chunks.push_back(buffer.substr(start, end - start));
+            start = end;
+        }
+        return chunks;
+    }
+
+    namespace detail
+    {
+        /** Number of worker threads to use for the requested count, where 0 stands for all hardware threads. */
+        inline std::size_t worker_count(std::size_t thread_count)
+        {
+            if (thread_count == 0) {
+                thread_count = std::thread::hardware_concurrency();
+            }
+            return thread_count > 0 ? thread_count : 1;
+        }
+
+        /**
+         * Number of chunks to split a buffer into for the given number of threads.
+         *
+         * Several chunks per thread balance load if some chunks take longer than others, while a minimum chunk size
+         * keeps the per-chunk overhead negligible.
+         */
+        inline std::size_t chunk_count(std::size_t buffer_size, std::size_t thread_count)
+        {
+            constexpr std::size_t chunks_per_thread = 4;
+            constexpr std::size_t min_chunk_size = 64 * 1024;
+            const std::size_t count = (std::min)(thread_count * chunks_per_thread, (buffer_size + min_chunk_size - 1) / min_chunk_size);
+            return count > 0 ? count : 1;
+        }
+    }
+
+    /**
+     * Invokes a function on each chunk with a pool of worker threads.
+     *
+     * Idle threads pick the next unprocessed chunk. The function is called as `fn(index, chunk)`, where `index` is
+     * the position of the chunk in the list. If the function throws, remaining chunks are skipped, and the first
+     * exception is re-thrown on the calling thread, which also acts as one of the workers.
+     *
+     * @param thread_count Number of worker threads, or 0 to use all hardware threads.
+     */
+    template<typename F>
+    void for_each_chunk(const std::vector<std::string_view>& chunks, std::size_t thread_count, F&& fn)
+    {
+        thread_count = (std::min)(detail::worker_count(thread_count), chunks.size());
+
+        std::atomic<std::size_t> next_chunk(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        auto work = [&]() {
+            while (!failed.load(std::memory_order_relaxed)) {
+                const std::size_t index = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                if (index >= chunks.size()) {
+                    break;
+                }
+                try {
+                    fn(index, chunks[index]);
+                } catch (...) {
+                    if (!failed.exchange(true)) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        if (thread_count > 1) {
+            workers.reserve(thread_count - 1);
+            for (std::size_t k = 1; k < thread_count; ++k) {
+                workers.emplace_back(work);
+            }
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /** Records stored column by column, with a validity mask for each record. */
+    template<typename... Ts>
+    struct record_columns
+    {
+        constexpr static std::size_t column_count = sizeof...(Ts);
+
+        /** Number of records. */
+        std::size_t size() const
+        {
+            return valid.size();
+        }
+
+        /** Appends a record, with bit `k` of `mask` set if column `k` has been parsed successfully. */
+        void push_back(const std::tuple<Ts...>& record, std::uint64_t mask)
+        {
+            push_back(record, std::index_sequence_for<Ts...>());
+            valid.push_back(mask);
+        }
+
+        /** Moves all records of another set of columns to the end of this set. */
+        void append(record_columns&& other)
+        {
+            append(std::move(other), std::index_sequence_for<Ts...>());
+            valid.insert(valid.end(), other.valid.begin(), other.valid.end());
+            other.valid.clear();
+        }
+
+        /** Values for each column; values of fields that have not been parsed successfully are unspecified. */
+        std::tuple<std::vector<Ts>...> columns;
+
+        /** A mask for each record with bit `k` set if column `k` has been parsed successfully. */
+        std::vector<std::uint64_t> valid;
+
+    private:
+        template<std::size_t... Is>
+        void push_back(const std::tuple<Ts...>& record, std::index_sequence<Is...>)
+        {
+            (std::get<Is>(columns).push_back(std::get<Is>(record)), ...);
+        }
+
+        template<std::size_t... Is>
+        void append(record_columns&& other, std::index_sequence<Is...>)
+        {
+            (append_column(std::get<Is>(columns), std::get<Is>(other.columns)), ...);
+        }
+
+        template<typename T>
+        static void append_column(std::vector<T>& target, std::vector<T>& source)
+        {
+            if (target.empty()) {
+                target = std::move(source);
+            } else {
+                target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+            }
+            source.clear();
+        }
+    };
+
+    /**
+     * Parses the delimiter-separated records of a buffer into columns with a pool of worker threads.
+     *
+     * Each worker scans newline-aligned chunks with a `field_scanner` into its own columns, which are concatenated
+     * in buffer order at the end. Quoted fields must not contain line feeds.
+     *
+     * @param thread_count Number of worker threads, or 0 to use all hardware threads.
+     * @param skip_header True if the first line of the buffer is a header to be skipped.
+     */
+    template<typename... Ts>
+    record_columns<Ts...> parse_parallel(std::string_view buffer, std::size_t thread_count = 0, bool skip_header = false, char delimiter = ',', char quote = '"')
+    {
+        if (skip_header) {
+            const std::size_t newline = buffer.find('\n');
+            buffer.remove_prefix(newline == std::string_view::npos ? buffer.size() : newline + 1);
+        }
+
+        thread_count = detail::worker_count(thread_count);
+        const std::vector<std::string_view> chunks = split_lines(buffer, detail::chunk_count(buffer.size(), thread_count));
+
+        // a slot per chunk keeps the output in buffer order irrespective of which thread processes which chunk
+        std::vector<record_columns<Ts...>> parts(chunks.size());
+        for_each_chunk(chunks, thread_count, [&parts, delimiter, quote](std::size_t index, const std::string_view& chunk) {
+            record_columns<Ts...>& part = parts[index];
+            field_scanner<Ts...> scanner(chunk, delimiter, quote);
+            typename field_scanner<Ts...>::record_type record;
+            while (scanner.next(record)) {
+                part.push_back(record, scanner.valid());
+            }
+        });
+
+        record_columns<Ts...> result;
+        for (record_columns<Ts...>& part : parts) {
+            result.append(std::move(part));
+        }
+        return result;
+    }
+}
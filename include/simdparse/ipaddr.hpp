@@ -13,6 +13,12 @@
 #include <string_view>
 #include <cstdint>
 #include <cstring>
+#include "dispatch.hpp"
+
+#if defined(__AVX2__)
+#include "uuid.hpp"
+#include <immintrin.h>
+#endif
 
 #if defined(_WIN32) || defined(_WIN64)
 #define WIN32_LEAN_AND_MEAN
@@ -24,6 +30,235 @@
 
 namespace simdparse
 {
+    namespace detail
+    {
+#if defined(__AVX2__)
+        /**
+         * Shuffle patterns that move the digits of each octet in a dotted-quad string into a separate 32-bit lane.
+         *
+         * Digits are right-aligned within the first three bytes of the lane, and high bits fill unused bytes.
+         * The pattern for octets of lengths `a`, `b`, `c` and `d` has the index `27*(a-1) + 9*(b-1) + 3*(c-1) + (d-1)`.
+         */
+        constexpr std::array<std::array<std::int8_t, 16>, 81> make_ipv4_shuffle_table()
+        {
+            std::array<std::array<std::int8_t, 16>, 81> table = {};
+            for (int pattern = 0; pattern < 81; ++pattern) {
+                const int lengths[4] = { pattern / 27 + 1, pattern / 9 % 3 + 1, pattern / 3 % 3 + 1, pattern % 3 + 1 };
+                int start = 0;
+                for (int k = 0; k < 4; ++k) {
+                    for (int j = 0; j < 4; ++j) {
+                        int offset = j - (3 - lengths[k]);
+                        table[pattern][4 * k + j] = static_cast<std::int8_t>(j < 3 && offset >= 0 ? start + offset : -1);
+                    }
+                    start += lengths[k] + 1;
+                }
+            }
+            return table;
+        }
+
+        alignas(16) constexpr std::array<std::array<std::int8_t, 16>, 81> ipv4_shuffle_table = make_ipv4_shuffle_table();
+
+        /**
+         * Parses an IPv4 address in dotted decimal notation of at most 15 characters.
+         *
+         * Accepts the same strings as `inet_pton`: exactly four decimal octets of one to three digits, each no greater
+         * than 255, without leading zeros.
+         */
+        inline bool parse_ipv4(const char* str, std::size_t len, std::uint8_t* addr)
+        {
+            if (len < 7 || len > 15) {
+                return false;
+            }
+
+            alignas(__m128i) std::array<char, 16> buf = {};
+            std::memcpy(buf.data(), str, len);
+            const __m128i characters = _mm_load_si128(reinterpret_cast<const __m128i*>(buf.data()));
+
+            // classify characters as digits and dots
+            const __m128i digits = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+            const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+            const __m128i is_dot = _mm_cmpeq_epi8(characters, _mm_set1_epi8('.'));
+            const std::uint32_t length_mask = (1u << len) - 1;
+            const std::uint32_t digit_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_digit)) & length_mask;
+            std::uint32_t dot_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_dot)) & length_mask;
+            if ((digit_mask | dot_mask) != length_mask) {
+                return false;
+            }
+
+            // find positions of the three dots
+            unsigned int dots[3];
+            for (unsigned int& dot : dots) {
+                if (dot_mask == 0) {
+                    return false;
+                }
+                dot = count_trailing_zeros(dot_mask);
+                dot_mask &= dot_mask - 1;
+            }
+            if (dot_mask != 0) {
+                return false;
+            }
+
+            // derive octet lengths, each between 1 and 3
+            const unsigned int first_len = dots[0];
+            const unsigned int second_len = dots[1] - dots[0] - 1;
+            const unsigned int third_len = dots[2] - dots[1] - 1;
+            const unsigned int fourth_len = static_cast<unsigned int>(len) - dots[2] - 1;
+            if (first_len - 1 > 2 || second_len - 1 > 2 || third_len - 1 > 2 || fourth_len - 1 > 2) {
+                return false;
+            }
+            const unsigned int pattern = 27 * (first_len - 1) + 9 * (second_len - 1) + 3 * (third_len - 1) + (fourth_len - 1);
+
+            // move digits of each octet into a 32-bit lane, and combine them into an integer
+            const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(ipv4_shuffle_table[pattern].data()));
+            const __m128i octet_digits = _mm_shuffle_epi8(digits, shuffle);
+            const __m128i weights = _mm_setr_epi8(100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+            const __m128i octets = _mm_madd_epi16(_mm_maddubs_epi16(octet_digits, weights), _mm_set1_epi16(1));
+
+            // reject octets greater than 255, and octets with leading zeros (e.g. `01` with a value less than 10)
+            constexpr int min_values[4] = { 0, 0, 10, 100 };
+            const __m128i lower_bound = _mm_setr_epi32(min_values[first_len], min_values[second_len], min_values[third_len], min_values[fourth_len]);
+            const __m128i out_of_range = _mm_or_si128(
+                _mm_cmpgt_epi32(octets, _mm_set1_epi32(255)),
+                _mm_cmpgt_epi32(lower_bound, octets)
+            );
+            if (!_mm_testz_si128(out_of_range, out_of_range)) {
+                return false;
+            }
+
+            // pack the lowest byte of each lane
+            const __m128i packed = _mm_shuffle_epi8(octets, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+            const std::int32_t value = _mm_cvtsi128_si32(packed);
+            std::memcpy(addr, &value, 4);
+            return true;
+        }
+
+        /** Classifies 32 characters into masks of hexadecimal digits, colons and dots. */
+        inline void classify_ipv6(const __m256i& characters, std::uint64_t& hex, std::uint64_t& colon, std::uint64_t& dot)
+        {
+            const __m256i is_digit = _mm256_andnot_si256(
+                _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8('0'), characters), _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('9'))),
+                _mm256_set1_epi8(-1)
+            );
+            const __m256i lowercase_characters = _mm256_or_si256(characters, _mm256_set1_epi8(0b00100000));
+            const __m256i is_alpha = _mm256_andnot_si256(
+                _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8('a'), lowercase_characters), _mm256_cmpgt_epi8(lowercase_characters, _mm256_set1_epi8('f'))),
+                _mm256_set1_epi8(-1)
+            );
+            hex = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)));
+            colon = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8(':'))));
+            dot = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(characters, _mm256_set1_epi8('.'))));
+        }
+
+        /**
+         * Parses an IPv6 address in text representation of at most 45 characters.
+         *
+         * Accepts the same strings as `inet_pton`: eight groups of one to four hexadecimal digits separated by colons,
+         * where a single `::` may stand in for one or more zero groups, and the last two groups may be written as an
+         * IPv4 address in dotted decimal notation.
+         */
+        inline bool parse_ipv6(const char* str, std::size_t len, std::uint8_t* addr)
+        {
+            if (len == 0 || len >= 46) {
+                return false;
+            }
+
+            // classify characters, with 4 bytes of padding in front to allow reading a group of digits at any position
+            alignas(__m256i) std::array<char, 68> buf = {};
+            char* text = buf.data() + 4;
+            std::memcpy(text, str, len);
+            std::uint64_t hex_lo, colon_lo, dot_lo;
+            std::uint64_t hex_hi, colon_hi, dot_hi;
+            classify_ipv6(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), hex_lo, colon_lo, dot_lo);
+            classify_ipv6(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 32)), hex_hi, colon_hi, dot_hi);
+            const std::uint64_t length_mask = (std::uint64_t(1) << len) - 1;
+            std::uint64_t hex = (hex_lo | (hex_hi << 32)) & length_mask;
+            std::uint64_t colon = (colon_lo | (colon_hi << 32)) & length_mask;
+            const std::uint64_t dot = (dot_lo | (dot_hi << 32)) & length_mask;
+            if ((hex | colon | dot) != length_mask || colon == 0) {
+                return false;
+            }
+
+            // reject a single leading colon
+            if ((colon & ~(colon >> 1) & 1) != 0) {
+                return false;
+            }
+
+            // split off a trailing IPv4 address after the last colon
+            std::array<std::uint8_t, 16> result;
+            std::size_t ipv4_groups = 0;
+            if (dot != 0) {
+                std::uint64_t remaining = colon;
+                std::size_t ipv4_start;
+                do {
+                    ipv4_start = count_trailing_zeros(remaining) + 1;
+                    remaining &= remaining - 1;
+                } while (remaining != 0);
+                const std::uint64_t before_ipv4 = (std::uint64_t(1) << ipv4_start) - 1;
+                if ((dot & before_ipv4) != 0 || !parse_ipv4(text + ipv4_start, len - ipv4_start, result.data() + 12)) {
+                    return false;
+                }
+                hex &= before_ipv4;
+                ipv4_groups = 2;
+            } else if (((colon >> (len - 1)) & ~(colon >> (len - 2)) & 1) != 0) {
+                // single trailing colon
+                return false;
+            }
+
+            // reject more than one `::`, and more than four digits in a group
+            const std::uint64_t double_colon = colon & (colon >> 1);
+            if ((double_colon & (double_colon - 1)) != 0) {
+                return false;
+            }
+            if ((hex & (hex >> 1) & (hex >> 2) & (hex >> 3) & (hex >> 4)) != 0) {
+                return false;
+            }
+
+            // count groups of digits, where a trailing IPv4 address counts as two groups
+            const std::uint64_t group_start = hex & ~(hex << 1);
+            const std::uint64_t group_end = hex & ~(hex >> 1);
+            std::size_t group_count = ipv4_groups;
+            for (std::uint64_t m = group_end; m != 0; m &= m - 1) {
+                ++group_count;
+            }
+            if (double_colon != 0 ? group_count > 7 : group_count != 8) {
+                return false;
+            }
+
+            // right-align digits of each group in a slot of 4 characters, and expand `::` into zero groups
+            alignas(__m256i) std::array<char, 32> digits;
+            std::memset(digits.data(), '0', digits.size());
+            const std::uint64_t before_gap = double_colon != 0 ? double_colon - 1 : ~std::uint64_t(0);
+            std::size_t slot = 0;
+            bool gap_expanded = false;
+            for (std::uint64_t starts = group_start, ends = group_end; ends != 0; starts &= starts - 1, ends &= ends - 1) {
+                const unsigned int start = count_trailing_zeros(starts);
+                const unsigned int end = count_trailing_zeros(ends);
+                if (!gap_expanded && ((before_gap >> start) & 1) == 0) {
+                    slot += 8 - group_count;
+                    gap_expanded = true;
+                }
+
+                // read 4 characters that end with the group, and replace characters before the group with zeros
+                std::uint32_t chars;
+                std::memcpy(&chars, text + end - 3, 4);
+                const std::uint32_t keep = ~std::uint32_t(0) << (8 * (3 - (end - start)));
+                chars = (chars & keep) | (0x30303030 & ~keep);
+                std::memcpy(digits.data() + 4 * slot, &chars, 4);
+                ++slot;
+            }
+
+            // convert hexadecimal digits into bytes
+            __m128i value;
+            if (!parse_uuid(_mm256_load_si256(reinterpret_cast<const __m256i*>(digits.data())), value)) {
+                return false;
+            }
+            std::memcpy(result.data(), &value, 16 - 2 * ipv4_groups);
+            std::memcpy(addr, result.data(), result.size());
+            return true;
+        }
+#endif
+    }
+
     struct ipv4_addr
     {
         constexpr static std::string_view name = "IPv4 address";
@@ -98,6 +333,9 @@ namespace simdparse
         /** Parses an IPv4 address string into an IPv4 address object. */
         bool parse(const std::string_view& str)
         {
+#if defined(__AVX2__)
+            return detail::parse_ipv4(str.data(), str.size(), _addr.data());
+#else
             if (str.size() >= INET_ADDRSTRLEN) {
                 return false;
             }
@@ -113,6 +351,7 @@ namespace simdparse
             }
 
             return true;
+#endif
         }
 
     private:
@@ -219,6 +458,9 @@ namespace simdparse
         /** Parses an IPv6 address string into an IPv6 address object. */
         bool parse(const std::string_view& str)
         {
+#if defined(__AVX2__)
+            return detail::parse_ipv6(str.data(), str.size(), _addr.data());
+#else
             if (str.size() >= INET6_ADDRSTRLEN) {
                 return false;
             }
@@ -233,6 +475,7 @@ namespace simdparse
             }
 
             return true;
+#endif
         }
 
     private:
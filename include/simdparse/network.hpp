@@ -0,0 +1,511 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "dispatch.hpp"
+#include "ipaddr.hpp"
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace simdparse
+{
+    namespace detail
+    {
+        /** Parses a network prefix length of one to three decimal digits, without leading zeros. */
+        inline bool parse_prefix_length(const std::string_view& str, unsigned int max_length, unsigned int& length)
+        {
+            if (str.empty() || str.size() > 3 || (str.size() > 1 && str[0] == '0')) {
+                return false;
+            }
+            unsigned int value = 0;
+            for (char c : str) {
+                if (c < '0' || c > '9') {
+                    return false;
+                }
+                value = 10 * value + static_cast<unsigned int>(c - '0');
+            }
+            if (value > max_length) {
+                return false;
+            }
+            length = value;
+            return true;
+        }
+
+        /** Interprets the bytes of an IPv4 address as an unsigned integer in network byte order. */
+        inline std::uint32_t address_key(const ipv4_addr& addr)
+        {
+            const std::uint8_t* bytes = addr.data();
+            return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) | (static_cast<std::uint32_t>(bytes[2]) << 8) | bytes[3];
+        }
+
+        /** Interprets the bytes of an IPv6 address as a pair of unsigned integers in network byte order. */
+        inline std::pair<std::uint64_t, std::uint64_t> address_key(const ipv6_addr& addr)
+        {
+            const std::uint8_t* bytes = addr.data();
+            std::uint64_t hi = 0;
+            std::uint64_t lo = 0;
+            for (std::size_t k = 0; k < 8; ++k) {
+                hi = (hi << 8) | bytes[k];
+                lo = (lo << 8) | bytes[k + 8];
+            }
+            return { hi, lo };
+        }
+
+        /** Bits of an IPv4 address that are not part of the network prefix. */
+        constexpr std::uint32_t host_mask(std::uint32_t, unsigned int prefix_length)
+        {
+            return prefix_length >= 32 ? 0 : ~std::uint32_t(0) >> prefix_length;
+        }
+
+        /** Bits of an IPv6 address that are not part of the network prefix. */
+        constexpr std::pair<std::uint64_t, std::uint64_t> host_mask(const std::pair<std::uint64_t, std::uint64_t>&, unsigned int prefix_length)
+        {
+            return {
+                prefix_length >= 64 ? 0 : ~std::uint64_t(0) >> prefix_length,
+                prefix_length <= 64 ? ~std::uint64_t(0) : prefix_length >= 128 ? 0 : ~std::uint64_t(0) >> (prefix_length - 64)
+            };
+        }
+
+        constexpr bool has_host_bits(std::uint32_t key, unsigned int prefix_length)
+        {
+            return (key & host_mask(key, prefix_length)) != 0;
+        }
+
+        constexpr bool has_host_bits(const std::pair<std::uint64_t, std::uint64_t>& key, unsigned int prefix_length)
+        {
+            const std::pair<std::uint64_t, std::uint64_t> mask = host_mask(key, prefix_length);
+            return (key.first & mask.first) != 0 || (key.second & mask.second) != 0;
+        }
+
+        constexpr std::uint32_t last_key(std::uint32_t key, unsigned int prefix_length)
+        {
+            return key | host_mask(key, prefix_length);
+        }
+
+        constexpr std::pair<std::uint64_t, std::uint64_t> last_key(const std::pair<std::uint64_t, std::uint64_t>& key, unsigned int prefix_length)
+        {
+            const std::pair<std::uint64_t, std::uint64_t> mask = host_mask(key, prefix_length);
+            return { key.first | mask.first, key.second | mask.second };
+        }
+
+        /** The key that immediately follows a key that is not the maximum value. */
+        constexpr std::uint32_t next_key(std::uint32_t key)
+        {
+            return key + 1;
+        }
+
+        /** The key that immediately follows a key that is not the maximum value. */
+        constexpr std::pair<std::uint64_t, std::uint64_t> next_key(const std::pair<std::uint64_t, std::uint64_t>& key)
+        {
+            return { key.second == ~std::uint64_t(0) ? key.first + 1 : key.first, key.second + 1 };
+        }
+
+        constexpr bool is_max_key(std::uint32_t key)
+        {
+            return key == ~std::uint32_t(0);
+        }
+
+        constexpr bool is_max_key(const std::pair<std::uint64_t, std::uint64_t>& key)
+        {
+            return key.first == ~std::uint64_t(0) && key.second == ~std::uint64_t(0);
+        }
+
+        /**
+         * Parses a network in CIDR notation `address/length` with no host bits set.
+         *
+         * @tparam Address An IP address type.
+         * @tparam MaxLength Number of bits in the address.
+         */
+        template<typename Address, unsigned int MaxLength>
+        bool parse_network(const std::string_view& str, Address& address, unsigned int& prefix_length)
+        {
+            std::size_t pos = str.rfind('/');
+            if (pos == std::string_view::npos) {
+                return false;
+            }
+
+            Address addr;
+            unsigned int length;
+            if (!addr.parse(str.substr(0, pos)) || !parse_prefix_length(str.substr(pos + 1), MaxLength, length)) {
+                return false;
+            }
+            if (has_host_bits(address_key(addr), length)) {
+                return false;
+            }
+
+            address = addr;
+            prefix_length = length;
+            return true;
+        }
+    }
+
+    /** An IPv4 network in CIDR notation, e.g. `192.0.2.0/24`. */
+    struct ipv4_network
+    {
+        constexpr static std::string_view name = "IPv4 network";
+        using address_type = ipv4_addr;
+
+        constexpr ipv4_network()
+        {
+        }
+
+        /** Construct a network from a network address with no host bits set, and a prefix length of at most 32. */
+        constexpr ipv4_network(const ipv4_addr& address, unsigned int prefix_length)
+            : _address(address)
+            , _prefix_length(prefix_length)
+        {
+        }
+
+        bool operator==(const ipv4_network& op) const
+        {
+            return _address == op._address && _prefix_length == op._prefix_length;
+        }
+
+        bool operator!=(const ipv4_network& op) const
+        {
+            return !(*this == op);
+        }
+
+        const ipv4_addr& address() const
+        {
+            return _address;
+        }
+
+        unsigned int prefix_length() const
+        {
+            return _prefix_length;
+        }
+
+        /** True if the address belongs to this network. */
+        bool contains(const ipv4_addr& addr) const
+        {
+            const std::uint32_t key = detail::address_key(addr);
+            return (key & ~detail::host_mask(key, _prefix_length)) == detail::address_key(_address);
+        }
+
+        /** Parses an IPv4 network string in CIDR notation into a network object. */
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        /** Parses an IPv4 network string in CIDR notation into a network object. */
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /**
+         * Parses an IPv4 network string in CIDR notation into a network object.
+         *
+         * Rejects networks whose address has bits set beyond the prefix length (e.g. `192.0.2.1/24`).
+         */
+        bool parse(const std::string_view& str)
+        {
+            return detail::parse_network<ipv4_addr, 32>(str, _address, _prefix_length);
+        }
+
+    private:
+        ipv4_addr _address;
+        unsigned int _prefix_length = 0;
+    };
+
+    /** An IPv6 network in CIDR notation, e.g. `2001:db8::/32`. */
+    struct ipv6_network
+    {
+        constexpr static std::string_view name = "IPv6 network";
+        using address_type = ipv6_addr;
+
+        constexpr ipv6_network()
+        {
+        }
+
+        /** Construct a network from a network address with no host bits set, and a prefix length of at most 128. */
+        constexpr ipv6_network(const ipv6_addr& address, unsigned int prefix_length)
+            : _address(address)
+            , _prefix_length(prefix_length)
+        {
+        }
+
+        bool operator==(const ipv6_network& op) const
+        {
+            return _address == op._address && _prefix_length == op._prefix_length;
+        }
+
+        bool operator!=(const ipv6_network& op) const
+        {
+            return !(*this == op);
+        }
+
+        const ipv6_addr& address() const
+        {
+            return _address;
+        }
+
+        unsigned int prefix_length() const
+        {
+            return _prefix_length;
+        }
+
+        /** True if the address belongs to this network. */
+        bool contains(const ipv6_addr& addr) const
+        {
+            const std::pair<std::uint64_t, std::uint64_t> key = detail::address_key(addr);
+            const std::pair<std::uint64_t, std::uint64_t> mask = detail::host_mask(key, _prefix_length);
+            return std::make_pair(key.first & ~mask.first, key.second & ~mask.second) == detail::address_key(_address);
+        }
+
+        /** Parses an IPv6 network string in CIDR notation into a network object. */
+        bool parse(const char* beg, const char* end)
+        {
+            return parse(std::string_view(beg, end - beg));
+        }
+
+        /** Parses an IPv6 network string in CIDR notation into a network object. */
+        bool parse(const char* beg, std::size_t siz)
+        {
+            return parse(std::string_view(beg, siz));
+        }
+
+        /**
+         * Parses an IPv6 network string in CIDR notation into a network object.
+         *
+         * Rejects networks whose address has bits set beyond the prefix length (e.g. `2001:db8::1/32`).
+         */
+        bool parse(const std::string_view& str)
+        {
+            return detail::parse_network<ipv6_addr, 128>(str, _address, _prefix_length);
+        }
+
+    private:
+        ipv6_addr _address;
+        unsigned int _prefix_length = 0;
+    };
+
+    /**
+     * An immutable longest-prefix-match index that maps IP addresses to values associated with networks.
+     *
+     * Nested networks are flattened into a sorted array of disjoint address ranges when the index is built, such that
+     * each lookup is a branchless binary search in a contiguous array instead of a walk along the nodes of a trie.
+     *
+     * @tparam Network An `ipv4_network` or `ipv6_network` type.
+     */
+    template<typename Network>
+    struct prefix_index
+    {
+        using network_type = Network;
+        using address_type = typename Network::address_type;
+        using key_type = decltype(detail::address_key(std::declval<address_type>()));
+
+        /** Value returned for addresses that belong to none of the networks. */
+        constexpr static std::uint32_t npos = ~std::uint32_t(0);
+
+        prefix_index()
+            : _keys{ key_type() }
+            , _values{ npos }
+        {
+        }
+
+        /**
+         * Builds an index from networks and associated values.
+         *
+         * Networks may be given in any order. If the same network occurs more than once, the last value is kept.
+         */
+        explicit prefix_index(const std::vector<std::pair<Network, std::uint32_t>>& networks)
+        {
+            struct range
+            {
+                key_type first;
+                key_type last;
+                unsigned int prefix_length;
+                std::size_t order;
+                std::uint32_t value;
+            };
+
+            std::vector<range> ranges;
+            ranges.reserve(networks.size());
+            for (std::size_t k = 0; k < networks.size(); ++k) {
+                const Network& network = networks[k].first;
+                const key_type first = detail::address_key(network.address());
+                ranges.push_back({ first, detail::last_key(first, network.prefix_length()), network.prefix_length(), k, networks[k].second });
+            }
+
+            // sort such that enclosing networks come before the networks they contain
+            std::sort(ranges.begin(), ranges.end(), [](const range& a, const range& b) {
+                if (a.first != b.first) {
+                    return a.first < b.first;
+                }
+                if (a.prefix_length != b.prefix_length) {
+                    return a.prefix_length < b.prefix_length;
+                }
+                return a.order < b.order;
+            });
+
+            // sweep ranges from lowest to highest address, maintaining a stack of enclosing ranges
+            _keys.push_back(key_type());
+            _values.push_back(npos);
+            auto emit = [this](const key_type& key, std::uint32_t value) {
+                if (_keys.back() == key) {
+                    _values.back() = value;
+                    if (_values.size() > 1 && _values[_values.size() - 2] == value) {
+                        _keys.pop_back();
+                        _values.pop_back();
+                    }
+                } else if (_values.back() != value) {
+                    _keys.push_back(key);
+                    _values.push_back(value);
+                }
+            };
+
+            std::vector<const range*> stack;
+            auto pop = [&]() {
+                const key_type last = stack.back()->last;
+                stack.pop_back();
+                if (!detail::is_max_key(last)) {
+                    emit(detail::next_key(last), stack.empty() ? npos : stack.back()->value);
+                }
+            };
+            for (const range& r : ranges) {
+                while (!stack.empty() && stack.back()->last < r.first) {
+                    pop();
+                }
+                emit(r.first, r.value);
+                stack.push_back(&r);
+            }
+            while (!stack.empty()) {
+                pop();
+            }
+        }
+
+        /** Number of disjoint address ranges in the index. */
+        std::size_t size() const
+        {
+            return _keys.size();
+        }
+
+        /**
+         * Finds the value associated with the longest network prefix that matches the address.
+         *
+         * @returns The value associated with the most specific network, or `npos` if no network contains the address.
+         */
+        std::uint32_t lookup(const address_type& addr) const
+        {
+            const key_type key = detail::address_key(addr);
+            std::size_t base = 0;
+            std::size_t n = _keys.size();
+            while (n > 1) {
+                const std::size_t half = n / 2;
+                base = _keys[base + half] <= key ? base + half : base;
+                n -= half;
+            }
+            return _values[base];
+        }
+
+        /**
+         * Finds the values associated with the longest network prefix that matches each address.
+         *
+         * Searches for several addresses are interleaved such that their memory accesses overlap.
+         */
+        void lookup(const address_type* addrs, std::size_t count, std::uint32_t* values) const
+        {
+            constexpr std::size_t lanes = 8;
+            std::size_t i = 0;
+
+#if defined(SIMDPARSE_AVX2)
+            if constexpr (std::is_same_v<key_type, std::uint32_t>) {
+                // gather indices are signed 32-bit integers
+                if (_keys.size() <= 0x7fffffff && detail::use_avx2()) {
+                    i = lookup_simd(addrs, count, values);
+                }
+            }
+#endif
+
+            for (; i + lanes <= count; i += lanes) {
+                std::array<key_type, lanes> keys;
+                std::array<std::size_t, lanes> bases = {};
+                for (std::size_t k = 0; k < lanes; ++k) {
+                    keys[k] = detail::address_key(addrs[i + k]);
+                }
+                std::size_t n = _keys.size();
+                while (n > 1) {
+                    const std::size_t half = n / 2;
+                    for (std::size_t k = 0; k < lanes; ++k) {
+                        bases[k] = _keys[bases[k] + half] <= keys[k] ? bases[k] + half : bases[k];
+                    }
+                    n -= half;
+                }
+                for (std::size_t k = 0; k < lanes; ++k) {
+                    values[i + k] = _values[bases[k]];
+                }
+            }
+
+            for (; i < count; ++i) {
+                values[i] = lookup(addrs[i]);
+            }
+        }
+
+    private:
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Finds the values for IPv4 addresses in groups of eight, with a branchless binary search on gathered keys.
+         *
+         * @returns The number of addresses looked up, a multiple of eight.
+         */
+        SIMDPARSE_TARGET_AVX2 std::size_t lookup_simd(const address_type* addrs, std::size_t count, std::uint32_t* values) const
+        {
+            constexpr std::size_t lanes = 8;
+
+            // keys are compared as signed integers after flipping the sign bit
+            const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+            const int* keys = reinterpret_cast<const int*>(_keys.data());
+            std::size_t i = 0;
+            for (; i + lanes <= count; i += lanes) {
+                alignas(__m256i) std::array<std::uint32_t, lanes> block;
+                for (std::size_t k = 0; k < lanes; ++k) {
+                    block[k] = detail::address_key(addrs[i + k]);
+                }
+                const __m256i key = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(block.data())), sign);
+
+                __m256i base = _mm256_setzero_si256();
+                std::size_t n = _keys.size();
+                while (n > 1) {
+                    const std::size_t half = n / 2;
+                    const __m256i probe = _mm256_add_epi32(base, _mm256_set1_epi32(static_cast<int>(half)));
+                    const __m256i probe_key = _mm256_xor_si256(_mm256_i32gather_epi32(keys, probe, 4), sign);
+                    const __m256i greater = _mm256_cmpgt_epi32(probe_key, key);
+                    base = _mm256_blendv_epi8(probe, base, greater);
+                    n -= half;
+                }
+                const __m256i value = _mm256_i32gather_epi32(reinterpret_cast<const int*>(_values.data()), base, 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), value);
+            }
+            return i;
+        }
+#endif
+
+        /** First address of each range, in ascending order, starting with the lowest address. */
+        std::vector<key_type> _keys;
+        /** Value associated with each range. */
+        std::vector<std::uint32_t> _values;
+    };
+
+    using ipv4_prefix_index = prefix_index<ipv4_network>;
+    using ipv6_prefix_index = prefix_index<ipv6_network>;
+}
@@ -0,0 +1,203 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include "dispatch.hpp"
+
+#if defined(SIMDPARSE_AVX2)
+#include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace simdparse
+{
+    /**
+     * A string view whose underlying buffer has at least `padding` readable bytes past the end of the string.
+     *
+     * Parsers that accept a padded string view load their input straight from the string with unaligned loads,
+     * and discard characters past the end with a mask derived from the string length, instead of copying the
+     * string into a buffer first. The value of the padding bytes is irrelevant.
+     */
+    struct padded_string_view : std::string_view
+    {
+        /** Number of bytes past the end of the string that parsers may read. */
+        constexpr static std::size_t padding = 64;
+
+        constexpr padded_string_view()
+        {
+        }
+
+        /** Wraps a string that is followed by at least `padding` readable bytes. */
+        constexpr explicit padded_string_view(const char* data, std::size_t size)
+            : std::string_view(data, size)
+        {
+        }
+
+        /** Wraps a string that is followed by at least `padding` readable bytes. */
+        constexpr explicit padded_string_view(const std::string_view& str)
+            : std::string_view(str)
+        {
+        }
+    };
+
+    namespace detail
+    {
+#if defined(SIMDPARSE_SIMD)
+        /**
+         * Shuffle indices that move the first `n` bytes of a 16-byte register to its end, starting at offset `n`.
+         *
+         * Leading indices have their highest bit set, which stands for an empty position in a byte shuffle.
+         */
+        alignas(16) constexpr inline std::uint8_t right_align_indices[32] = {
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+        };
+
+        /**
+         * Shuffle indices that shift the bytes of a 16-byte register.
+         *
+         * A window of 16 bytes starting at offset `16 + k` moves byte `k` to position 0, and a window starting at
+         * offset `16 - k` moves byte 0 to position `k`, leaving vacated positions empty.
+         */
+        alignas(16) constexpr inline std::uint8_t shift_indices[48] = {
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+        };
+#endif
+
+#if defined(SIMDPARSE_AVX2)
+        /**
+         * Loads a string of at most 16 characters followed by padding, aligned to the end of the register.
+         *
+         * Leading positions are filled with the given character.
+         */
+        SIMDPARSE_TARGET_AVX2 inline __m128i load_right_aligned(const char* str, std::size_t size, char fill)
+        {
+            const __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+            const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right_align_indices + size));
+            return _mm_blendv_epi8(_mm_shuffle_epi8(characters, indices), _mm_set1_epi8(fill), indices);
+        }
+
+        /** A sliding window of 32 bytes into this array selects the `n` leading bytes of a register, starting at offset `32 - n`. */
+        alignas(32) constexpr inline std::uint8_t prefix_mask[64] = {
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+        };
+
+        /**
+         * Loads a string whose length is known at compile time into a 256-bit register, with zeros past the end of
+         * the string.
+         *
+         * Strings of 32 or more characters fill the register. Without padding, shorter strings are read with two
+         * overlapping 16-byte loads, the second shifted into place by a constant amount, which neither reads past the
+         * end of the string nor suffers the store-forwarding stall of copying the string into a buffer first.
+         *
+         * @tparam Size Length of the string, at least 16 characters.
+         * @tparam Padded True if the string is followed by padding.
+         */
+        template<std::size_t Size, bool Padded>
+        SIMDPARSE_TARGET_AVX2 inline __m256i load_fixed_size(const char* str)
+        {
+            static_assert(Size >= 16, "expected: a string of at least 16 characters");
+
+            if constexpr (Size >= 32) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+            } else if constexpr (Padded) {
+                const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+                const __m256i in_string = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prefix_mask + 32 - Size));
+                return _mm256_and_si256(characters, in_string);
+            } else {
+                const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+                const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + Size - 16));
+                return _mm256_inserti128_si256(_mm256_castsi128_si256(head), _mm_srli_si128(tail, 32 - Size), 1);
+            }
+        }
+
+        /**
+         * Loads a string whose length is known only at run time into a 256-bit register.
+         *
+         * Without padding, the string is read with two overlapping loads of 8 or 16 bytes, which are merged with a
+         * byte shuffle, such that no byte past the end of the string is accessed. Positions past the end of the
+         * string are unspecified.
+         *
+         * @param size Length of the string, 8 to 32 characters without padding, or at most 32 characters with padding.
+         * @tparam Padded True if the string is followed by padding.
+         */
+        template<bool Padded>
+        SIMDPARSE_TARGET_AVX2 inline __m256i load_partial(const char* str, std::size_t size)
+        {
+            if constexpr (Padded) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+            } else if (size >= 16) {
+                const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+                const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + size - 16));
+                const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift_indices + 48 - size));
+                return _mm256_inserti128_si256(_mm256_castsi128_si256(head), _mm_shuffle_epi8(tail, indices), 1);
+            } else {
+                const __m128i head = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(str));
+                const __m128i tail = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(str + size - 8));
+                const __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift_indices + 24 - size));
+                return _mm256_castsi128_si256(_mm_or_si128(head, _mm_shuffle_epi8(tail, indices)));
+            }
+        }
+#elif defined(SIMDPARSE_NEON)
+        /**
+         * Loads a string of at most 16 characters followed by padding, aligned to the end of the register.
+         *
+         * Leading positions are filled with the given character.
+         */
+        inline uint8x16_t load_right_aligned(const char* str, std::size_t size, char fill)
+        {
+            const uint8x16_t characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(str));
+            const uint8x16_t indices = vld1q_u8(right_align_indices + size);
+
+            // a lookup with an index out of range leaves the fill character unchanged
+            return vqtbx1q_u8(vdupq_n_u8(static_cast<std::uint8_t>(fill)), characters, indices);
+        }
+
+        /**
+         * Loads a string whose length is known only at run time into a pair of 128-bit registers.
+         *
+         * Without padding, the string is read with two overlapping loads of 8 or 16 bytes, which are merged with a
+         * table lookup, such that no byte past the end of the string is accessed. Positions past the end of the
+         * string are unspecified.
+         *
+         * @param size Length of the string, 8 to 32 characters without padding, or at most 32 characters with padding.
+         * @tparam Padded True if the string is followed by padding.
+         */
+        template<bool Padded>
+        inline uint8x16x2_t load_partial(const char* str, std::size_t size)
+        {
+            const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(str);
+            uint8x16x2_t characters;
+            if constexpr (Padded) {
+                characters.val[0] = vld1q_u8(data);
+                characters.val[1] = vld1q_u8(data + 16);
+            } else if (size >= 16) {
+                characters.val[0] = vld1q_u8(data);
+                characters.val[1] = vqtbl1q_u8(vld1q_u8(data + size - 16), vld1q_u8(shift_indices + 48 - size));
+            } else {
+                const uint8x16_t head = vcombine_u8(vld1_u8(data), vdup_n_u8(0));
+                const uint8x16_t tail = vcombine_u8(vld1_u8(data + size - 8), vdup_n_u8(0));
+                characters.val[0] = vorrq_u8(head, vqtbl1q_u8(tail, vld1q_u8(shift_indices + 24 - size)));
+                characters.val[1] = vdupq_n_u8(0);
+            }
+            return characters;
+        }
+#endif
+    }
+}
@@ -10,6 +10,8 @@
 
 #pragma once
 #include "format.hpp"
+#include "padded_string.hpp"
+#include "result.hpp"
 #include <string_view>
 #include <string>
 #include <stdexcept>
@@ -41,18 +43,330 @@ namespace simdparse
         return parse<T>(std::string_view(str.data(), str.size()));
     }
 
+    /**
+     * Parses a string followed by padding.
+     *
+     * Types that have a kernel for padded input read it in place; other types parse it as an ordinary string.
+     */
+    template<typename T>
+    T parse(const padded_string_view& str)
+    {
+        T obj;
+        if (obj.parse(str)) {
+            return obj;
+        } else {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %s; got: %.32s (len = %zu)", T::name.data(), str.data(), str.size());
+            throw parse_error(std::string(buf.data(), buf.data() + n));
+        }
+    }
+
+    /**
+     * Parses a string with a layout known at compile time.
+     *
+     * For example, `parse<datetime, datetime_format<'T', 6, tz_designator::zulu>>(str)`.
+     */
+    template<typename T, typename Format>
+    T parse(const std::string_view& str)
+    {
+        T obj;
+        if (obj.parse(str, Format())) {
+            return obj;
+        } else {
+            std::array<char, 256> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "expected: %s; got: %.32s (len = %zu)", T::name.data(), str.data(), str.size());
+            throw parse_error(std::string(buf.data(), buf.data() + n));
+        }
+    }
+
     template<typename T>
     bool parse(T& obj, const std::string_view& str)
     {
         return obj.parse(str);
     }
 
+    template<typename T>
+    bool parse(T& obj, const padded_string_view& str)
+    {
+        return obj.parse(str);
+    }
+
+    template<typename T, typename Format>
+    bool parse(T& obj, const std::string_view& str, Format format)
+    {
+        return obj.parse(str, format);
+    }
+
     template<typename T>
     bool parse(T& obj, const std::string& str)
     {
         return obj.parse(std::string_view(str.data(), str.size()));
     }
 
+    namespace detail
+    {
+        constexpr bool is_digit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool is_hex_digit(char c)
+        {
+            return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        /** Value of two decimal digits at the given offset. */
+        constexpr unsigned int two_digits(const std::string_view& str, std::size_t offset)
+        {
+            return 10 * static_cast<unsigned int>(str[offset] - '0') + static_cast<unsigned int>(str[offset + 1] - '0');
+        }
+
+        /**
+         * Offset of the first character that does not match a pattern, or the length of the shorter string if none.
+         *
+         * The pattern character `0` matches any decimal digit, `*` matches `T` or a space, and any other character
+         * matches itself. This is the scalar equivalent of the `out_of_bounds` mask of the SIMD kernels.
+         */
+        constexpr std::size_t find_mismatch(const std::string_view& str, const std::string_view& pattern)
+        {
+            const std::size_t count = str.size() < pattern.size() ? str.size() : pattern.size();
+            for (std::size_t k = 0; k < count; ++k) {
+                const char c = str[k];
+                const char p = pattern[k];
+                const bool match = p == '0' ? is_digit(c) : p == '*' ? (c == 'T' || c == ' ') : c == p;
+                if (!match) {
+                    return k;
+                }
+            }
+            return count;
+        }
+
+        /** Locates an error in a string that has the layout of a pattern in which pairs of `0` stand for two-digit fields. */
+        inline parse_result locate_pattern_error(const std::string_view& str, const std::string_view& pattern)
+        {
+            const std::size_t mismatch = find_mismatch(str, pattern);
+            if (mismatch < str.size() && mismatch < pattern.size()) {
+                return { parse_errc::invalid_character, mismatch };
+            }
+            if (str.size() < pattern.size()) {
+                return { parse_errc::invalid_length, str.size() };
+            }
+            return parse_result();
+        }
+
+        /** Checks the fields of a date `YYYY-MM-DD` at the start of a string. */
+        inline parse_result locate_date_range_error(const std::string_view& str)
+        {
+            if (two_digits(str, 5) > 12) {
+                return { parse_errc::out_of_range, 5 };
+            }
+            if (two_digits(str, 8) > 31) {
+                return { parse_errc::out_of_range, 8 };
+            }
+            return parse_result();
+        }
+
+        /** Checks the fields of a time `hh:mm:ss` at the given offset. */
+        inline parse_result locate_time_range_error(const std::string_view& str, std::size_t offset)
+        {
+            if (two_digits(str, offset) >= 24) {
+                return { parse_errc::out_of_range, offset };
+            }
+            if (two_digits(str, offset + 3) >= 60) {
+                return { parse_errc::out_of_range, offset + 3 };
+            }
+            if (two_digits(str, offset + 6) >= 60) {
+                return { parse_errc::out_of_range, offset + 6 };
+            }
+            return parse_result();
+        }
+
+        /**
+         * Locates the first error in a string that a parser has rejected.
+         *
+         * Types without a specific overload get `invalid_format` at position 0.
+         */
+        template<typename T>
+        parse_result locate_error(const T*, const std::string_view&)
+        {
+            return { parse_errc::invalid_format, 0 };
+        }
+
+        inline parse_result locate_error(const date*, const std::string_view& str)
+        {
+            if (str.size() > 10) {
+                return { parse_errc::invalid_length, 10 };
+            }
+            if (parse_result result = locate_pattern_error(str, "0000-00-00"); !result) {
+                return result;
+            }
+            return locate_date_range_error(str);
+        }
+
+        inline parse_result locate_error(const datetime*, const std::string_view& str)
+        {
+            // 1984-10-24 23:59:59.123456789+01:00
+            if (parse_result result = locate_pattern_error(str, "0000-00-00*00:00:00"); !result) {
+                return result;
+            }
+            if (parse_result result = locate_date_range_error(str); !result) {
+                return result;
+            }
+            if (parse_result result = locate_time_range_error(str, 11); !result) {
+                return result;
+            }
+
+            std::size_t pos = 19;
+            if (pos < str.size() && str[pos] == '.') {
+                const std::size_t start = ++pos;
+                while (pos < str.size() && is_digit(str[pos])) {
+                    ++pos;
+                }
+                if (pos == start) {
+                    return { pos < str.size() ? parse_errc::invalid_character : parse_errc::invalid_length, pos };
+                }
+                if (pos - start > 9) {
+                    return { parse_errc::invalid_length, start + 9 };
+                }
+            }
+
+            const std::string_view suffix = str.substr(pos);
+            if (suffix.empty()) {
+                return parse_result();
+            }
+            std::string_view pattern;
+            switch (suffix[0]) {
+            case 'Z':
+                pattern = "Z";
+                break;
+            case ' ':
+                pattern = " UTC";
+                break;
+            case '+':
+            case '-':
+                pattern = "+00:00";
+                break;
+            default:
+                return { parse_errc::invalid_character, pos };
+            }
+
+            const std::size_t mismatch = find_mismatch(suffix.substr(1), pattern.substr(1)) + 1;
+            if (mismatch < suffix.size()) {
+                return { parse_errc::invalid_character, pos + mismatch };
+            }
+            if (suffix.size() < pattern.size()) {
+                return { parse_errc::invalid_length, str.size() };
+            }
+            if (pattern.size() == 6 && two_digits(suffix, 4) >= 60) {
+                return { parse_errc::out_of_range, pos + 4 };
+            }
+            return parse_result();
+        }
+
+        inline parse_result locate_error(const microtime*, const std::string_view& str)
+        {
+            return locate_error(static_cast<const datetime*>(nullptr), str);
+        }
+
+        inline parse_result locate_error(const packed_datetime*, const std::string_view& str)
+        {
+            return locate_error(static_cast<const datetime*>(nullptr), str);
+        }
+
+        inline parse_result locate_error(const decimal_integer*, const std::string_view& str)
+        {
+            if (str.empty()) {
+                return { parse_errc::invalid_length, 0 };
+            }
+            for (std::size_t k = 0; k < str.size(); ++k) {
+                if (!is_digit(str[k])) {
+                    return { parse_errc::invalid_character, k };
+                }
+            }
+            return { parse_errc::out_of_range, 0 };
+        }
+
+        inline parse_result locate_error(const hexadecimal_integer*, const std::string_view& str)
+        {
+            const std::size_t prefix = str.size() > 2 && str[0] == '0' && str[1] == 'x' ? 2 : 0;
+            if (str.size() == prefix) {
+                return { parse_errc::invalid_length, prefix };
+            }
+            for (std::size_t k = prefix; k < str.size(); ++k) {
+                if (!is_hex_digit(str[k])) {
+                    return { parse_errc::invalid_character, k };
+                }
+            }
+            if (str.size() - prefix > 16) {
+                return { parse_errc::invalid_length, prefix + 16 };
+            }
+            return parse_result();
+        }
+
+        inline parse_result locate_error(const uuid*, const std::string_view& str)
+        {
+            // f81d4fae-7dec-11d0-a765-00a0c91e6bf6, optionally enclosed in curly braces, or without dashes
+            std::size_t offset = 0;
+            bool dashes = true;
+            if (str.size() == 38) {
+                if (str[0] != '{') {
+                    return { parse_errc::invalid_character, 0 };
+                }
+                if (str[37] != '}') {
+                    return { parse_errc::invalid_character, 37 };
+                }
+                offset = 1;
+            } else if (str.size() == 32) {
+                dashes = false;
+            } else if (str.size() != 36) {
+                return { parse_errc::invalid_length, str.size() < 38 ? str.size() : 38 };
+            }
+
+            const std::size_t end = str.size() - offset;
+            for (std::size_t k = offset; k < end; ++k) {
+                const std::size_t n = k - offset;
+                const bool is_dash = dashes && (n == 8 || n == 13 || n == 18 || n == 23);
+                if (is_dash ? str[k] != '-' : !is_hex_digit(str[k])) {
+                    return { parse_errc::invalid_character, k };
+                }
+            }
+            return parse_result();
+        }
+
+        template<typename T>
+        parse_result make_parse_result(const std::string_view& str)
+        {
+            const parse_result result = locate_error(static_cast<const T*>(nullptr), str);
+            return result ? parse_result{ parse_errc::invalid_format, 0 } : result;
+        }
+    }
+
+    /**
+     * Parses a string, and reports the reason and position of the first error on failure.
+     *
+     * The string is parsed exactly like with `parse(obj, str)`. Only when parsing fails is the string inspected again
+     * to locate the error, so successful calls cost no more than the overload that returns `bool`, and no exception is
+     * thrown either way.
+     */
+    template<typename T>
+    parse_result try_parse(T& obj, const std::string_view& str)
+    {
+        if (obj.parse(str)) {
+            return parse_result();
+        }
+        return detail::make_parse_result<T>(str);
+    }
+
+    /** Parses a string followed by padding, and reports the reason and position of the first error on failure. */
+    template<typename T>
+    parse_result try_parse(T& obj, const padded_string_view& str)
+    {
+        if (obj.parse(str)) {
+            return parse_result();
+        }
+        return detail::make_parse_result<T>(str);
+    }
+
     template<typename T>
     void check_parse(const std::string_view& str, const T& ref)
     {
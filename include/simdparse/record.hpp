@@ -0,0 +1,167 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "base64url.hpp"
+#include "scanner.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace simdparse
+{
+    /**
+     * Marks a column of a `record_parser` that may be empty.
+     *
+     * An empty (or missing) field in a nullable column counts as valid, and sets the bit of the column in `nulls()`.
+     */
+    template<typename T>
+    struct nullable
+    {
+        using value_type = T;
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        struct column_traits
+        {
+            using value_type = T;
+            constexpr static bool is_nullable = false;
+        };
+
+        template<typename T>
+        struct column_traits<nullable<T>>
+        {
+            using value_type = T;
+            constexpr static bool is_nullable = true;
+        };
+
+        /** Human-readable name of a column type, used in diagnostics. */
+        template<typename T>
+        constexpr std::string_view column_name()
+        {
+            if constexpr (std::is_same_v<T, std::basic_string<std::byte>>) {
+                return base64url::name;
+            } else {
+                return T::name;
+            }
+        }
+    }
+
+    /**
+     * Parses the fields of records of a fixed shape, with the sequence of columns unrolled at compile time.
+     *
+     * Unlike `field_scanner`, which tokenizes and parses in turn, fields are expected to have been split already
+     * (e.g. by a tokenizer of a different format). All columns are parsed in a single expression without a dependency
+     * between them, so the compiler may interleave the instructions of independent parser kernels. Success and null
+     * flags are combined with bitwise operations instead of branches.
+     *
+     * @tparam Columns Column types, e.g. `decimal_integer`, `datetime` or `uuid`, or `nullable<T>` for columns that
+     * may be empty. Columns of type `std::basic_string<std::byte>` hold base64url-encoded data.
+     */
+    template<typename... Columns>
+    struct record_parser
+    {
+        static_assert(sizeof...(Columns) > 0 && sizeof...(Columns) <= 64, "expected: between 1 and 64 columns");
+
+        constexpr static std::size_t column_count = sizeof...(Columns);
+        using record_type = std::tuple<typename detail::column_traits<Columns>::value_type...>;
+
+        /** Name of the type of each column, e.g. for reporting which column of a record has failed to parse. */
+        constexpr static std::array<std::string_view, column_count> column_names = {
+            detail::column_name<typename detail::column_traits<Columns>::value_type>()...
+        };
+
+        /**
+         * Parses the fields of a record.
+         *
+         * Missing fields are treated as empty, and fields in excess of the number of columns are ignored. Objects of
+         * columns that are null or cannot be parsed are left in an unspecified state.
+         *
+         * @param fields Fields of the record.
+         * @param count Number of fields.
+         * @param record A `record_type`, or a tuple of references to the objects of each column, e.g. the members of
+         * a structure bound with `std::tie`.
+         * @returns True if all columns have been parsed successfully, or are null.
+         */
+        template<typename Record>
+        bool parse(const std::string_view* fields, std::size_t count, Record&& record)
+        {
+            static_assert(std::tuple_size_v<std::remove_reference_t<Record>> == column_count, "expected: an object for each column");
+            parse_columns(fields, count, record, std::index_sequence_for<Columns...>());
+            return complete();
+        }
+
+        /** Parses the fields of a record. */
+        template<typename Record>
+        bool parse(const std::vector<std::string_view>& fields, Record&& record)
+        {
+            return parse(fields.data(), fields.size(), std::forward<Record>(record));
+        }
+
+        /** Columns of the last record that have been parsed successfully or are null, with bit `k` standing for column `k`. */
+        std::uint64_t valid() const
+        {
+            return _valid;
+        }
+
+        /** Nullable columns of the last record with an empty field. */
+        std::uint64_t nulls() const
+        {
+            return _nulls;
+        }
+
+        /** True if all columns of the last record have been parsed successfully, or are null. */
+        bool complete() const
+        {
+            constexpr std::uint64_t all_columns = column_count < 64 ? (std::uint64_t(1) << column_count) - 1 : ~std::uint64_t(0);
+            return _valid == all_columns;
+        }
+
+        /** Index of the first column of the last record that has failed to parse, or `column_count` if none. */
+        std::size_t first_error() const
+        {
+            return complete() ? column_count : detail::count_trailing_zeros(~_valid);
+        }
+
+    private:
+        template<typename Record, std::size_t... Is>
+        void parse_columns(const std::string_view* fields, std::size_t count, Record& record, std::index_sequence<Is...>)
+        {
+            std::uint64_t nulls = 0;
+            _valid = (parse_column<Is, Columns>(Is < count ? fields[Is] : std::string_view(), std::get<Is>(record), nulls) | ...);
+            _nulls = nulls;
+        }
+
+        /** Parses a single field, and returns the bit of the column if the field has been parsed or is null. */
+        template<std::size_t I, typename Column, typename T>
+        static std::uint64_t parse_column(const std::string_view& field, T& obj, std::uint64_t& nulls)
+        {
+            const bool parsed = detail::parse_field(obj, field);
+            if constexpr (detail::column_traits<Column>::is_nullable) {
+                const bool empty = field.empty();
+                nulls |= std::uint64_t(empty) << I;
+                return std::uint64_t(parsed | empty) << I;
+            } else {
+                return std::uint64_t(parsed) << I;
+            }
+        }
+
+        std::uint64_t _valid = 0;
+        std::uint64_t _nulls = 0;
+    };
+}
@@ -0,0 +1,67 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <string_view>
+#include <cstddef>
+
+namespace simdparse
+{
+    /** Reason why a parser has rejected a string. */
+    enum class parse_errc
+    {
+        success,            // no error
+        invalid_length,     // string is too short or too long, e.g. a date string of 9 characters
+        invalid_character,  // character not permitted at its position, e.g. a letter in place of a digit
+        out_of_range,       // well-formed field with a value out of range, e.g. month 13 or an integer overflow
+        invalid_format      // string rejected for a reason that is not diagnosed for the type
+    };
+
+    /** Outcome of parsing a string, with the position of the first character that has caused a failure. */
+    struct parse_result
+    {
+        parse_errc ec = parse_errc::success;
+
+        /** Offset of the offending character, or where the string ends prematurely for `invalid_length`. */
+        std::size_t position = 0;
+
+        constexpr explicit operator bool() const
+        {
+            return ec == parse_errc::success;
+        }
+
+        constexpr bool operator==(const parse_result& op) const
+        {
+            return ec == op.ec && position == op.position;
+        }
+
+        constexpr bool operator!=(const parse_result& op) const
+        {
+            return !(*this == op);
+        }
+
+        /** A short description of the error code. */
+        constexpr std::string_view message() const
+        {
+            switch (ec) {
+            case parse_errc::success:
+                return "success";
+            case parse_errc::invalid_length:
+                return "invalid length";
+            case parse_errc::invalid_character:
+                return "invalid character";
+            case parse_errc::out_of_range:
+                return "value out of range";
+            default:
+                return "invalid format";
+            }
+        }
+    };
+}
@@ -0,0 +1,471 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "base64url.hpp"
+#include "dispatch.hpp"
+#include "padded_string.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(SIMDPARSE_AVX2) || defined(SIMDPARSE_AVX512)
+#include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace simdparse
+{
+    namespace detail
+    {
+        /** Returns a mask with bit `k` set if byte `k` of a 64-byte block is a delimiter, a quote or a line feed. */
+        inline std::uint64_t structural_mask(const char* block, char delimiter, char quote)
+        {
+            std::uint64_t mask = 0;
+            for (std::size_t k = 0; k < 64; ++k) {
+                const char c = block[k];
+                if (c == delimiter || c == quote || c == '\n') {
+                    mask |= std::uint64_t(1) << k;
+                }
+            }
+            return mask;
+        }
+
+#if defined(SIMDPARSE_AVX2)
+        /** Returns a mask with bit `k` set if byte `k` of a 64-byte block is a delimiter, a quote or a line feed. */
+        SIMDPARSE_TARGET_AVX2 inline std::uint64_t structural_mask_simd(const char* block, char delimiter, char quote)
+        {
+            const __m256i delimiters = _mm256_set1_epi8(delimiter);
+            const __m256i quotes = _mm256_set1_epi8(quote);
+            const __m256i newlines = _mm256_set1_epi8('\n');
+
+            std::uint64_t mask = 0;
+            for (std::size_t k = 0; k < 2; ++k) {
+                const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * k));
+                const __m256i matches = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(characters, delimiters), _mm256_cmpeq_epi8(characters, quotes)),
+                    _mm256_cmpeq_epi8(characters, newlines)
+                );
+                mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(matches))) << (32 * k);
+            }
+            return mask;
+        }
+#elif defined(SIMDPARSE_NEON)
+        /** Returns a mask with bit `k` set if byte `k` of a 64-byte block is a delimiter, a quote or a line feed. */
+        inline std::uint64_t structural_mask_simd(const char* block, char delimiter, char quote)
+        {
+            const uint8x16_t delimiters = vdupq_n_u8(static_cast<std::uint8_t>(delimiter));
+            const uint8x16_t quotes = vdupq_n_u8(static_cast<std::uint8_t>(quote));
+            const uint8x16_t newlines = vdupq_n_u8('\n');
+
+            // weight each matching byte by its bit position within a group of eight bytes
+            static constexpr std::uint8_t bit_weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            const uint8x16_t weights = vld1q_u8(bit_weights);
+
+            uint8x16_t parts[4];
+            for (std::size_t k = 0; k < 4; ++k) {
+                const uint8x16_t characters = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block + 16 * k));
+                const uint8x16_t matches = vorrq_u8(
+                    vorrq_u8(vceqq_u8(characters, delimiters), vceqq_u8(characters, quotes)),
+                    vceqq_u8(characters, newlines)
+                );
+                parts[k] = vandq_u8(matches, weights);
+            }
+
+            // add neighboring bytes three times such that each byte sums up the weights of a group of eight bytes
+            const uint8x16_t sum = vpaddq_u8(vpaddq_u8(parts[0], parts[1]), vpaddq_u8(parts[2], parts[3]));
+            return vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(sum, sum)), 0);
+        }
+#endif
+
+#if defined(SIMDPARSE_AVX512)
+        /** Returns a mask with bit `k` set if byte `k` of a 64-byte block is a delimiter, a quote or a line feed. */
+        SIMDPARSE_TARGET_AVX512 inline std::uint64_t structural_mask_avx512(const char* block, char delimiter, char quote)
+        {
+            const __m512i characters = _mm512_loadu_si512(block);
+            return _mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8(delimiter))
+                | _mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8(quote))
+                | _mm512_cmpeq_epi8_mask(characters, _mm512_set1_epi8('\n'))
+                ;
+        }
+#endif
+
+        /** Returns a mask of delimiters, quotes and line feeds in a 64-byte block, with the fastest available kernel. */
+        inline std::uint64_t classify_structural(const char* block, char delimiter, char quote)
+        {
+#if defined(SIMDPARSE_AVX512)
+            if (use_avx512()) {
+                return structural_mask_avx512(block, delimiter, quote);
+            }
+#endif
+#if defined(SIMDPARSE_SIMD)
+            if (use_simd()) {
+                return structural_mask_simd(block, delimiter, quote);
+            }
+#endif
+            return structural_mask(block, delimiter, quote);
+        }
+
+        /**
+         * Parses a field into an object of a column type.
+         *
+         * Byte string columns are decoded as base64url; other types are parsed with their member function `parse`,
+         * which may have an overload for padded strings.
+         */
+        template<typename T, typename S>
+        bool parse_field(T& obj, const S& str)
+        {
+            if constexpr (std::is_same_v<T, std::basic_string<std::byte>>) {
+                return base64url::decode(str, obj);
+            } else {
+                return obj.parse(str);
+            }
+        }
+    }
+
+    /**
+     * Splits a buffer of delimiter-separated records (e.g. CSV or TSV) into fields, and parses each field into the
+     * type of its column in the same pass.
+     *
+     * Delimiters, quotes and line feeds are located 64 bytes at a time with vector comparisons, which yield a bit mask
+     * of structural characters. Field boundaries are found by walking the set bits of the mask, and each field is
+     * handed to the parser of its column while it is still in cache.
+     *
+     * Fields may be enclosed in quotes, in which case delimiters and line feeds inside the field are part of the data,
+     * and two consecutive quotes stand for a single quote. Records end with a line feed, optionally preceded by a
+     * carriage return. Empty lines are skipped.
+     *
+     * @tparam Ts Column types, e.g. `decimal_integer`, `datetime`, `uuid` or `ipv4_addr`. Columns of type
+     * `std::basic_string<std::byte>` hold base64url-encoded data.
+     */
+    template<typename... Ts>
+    struct field_scanner
+    {
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 64, "expected: between 1 and 64 columns");
+
+        constexpr static std::size_t column_count = sizeof...(Ts);
+        using record_type = std::tuple<Ts...>;
+
+        /** Scans records in a buffer. */
+        explicit field_scanner(const std::string_view& buffer, char delimiter = ',', char quote = '"')
+            : _buffer(buffer)
+            , _delimiter(delimiter)
+            , _quote(quote)
+        {
+            load_block(0);
+        }
+
+        /**
+         * Scans records in a buffer followed by padding.
+         *
+         * Blocks at the end of the buffer are loaded without a copy, and fields are parsed as padded strings.
+         */
+        explicit field_scanner(const padded_string_view& buffer, char delimiter = ',', char quote = '"')
+            : _buffer(buffer)
+            , _delimiter(delimiter)
+            , _quote(quote)
+            , _padded(true)
+        {
+            load_block(0);
+        }
+
+        /**
+         * Parses the next record into an object for each column.
+         *
+         * Columns whose field is missing or cannot be parsed are left in an unspecified state, and their bit is clear
+         * in `valid()`. Fields in excess of the number of columns are skipped.
+         *
+         * @returns False if there are no more records in the buffer.
+         */
+        bool next(record_type& record)
+        {
+            skip_empty_lines();
+            if (_pos >= _buffer.size()) {
+                return false;
+            }
+
+            _valid = 0;
+            _field_count = 0;
+            _end_of_record = false;
+            parse_columns(record, std::index_sequence_for<Ts...>());
+            skip_fields();
+            return true;
+        }
+
+        /**
+         * Moves past the next record without parsing its fields, e.g. a header line.
+         *
+         * @returns False if there are no more records in the buffer.
+         */
+        bool skip()
+        {
+            skip_empty_lines();
+            if (_pos >= _buffer.size()) {
+                return false;
+            }
+
+            _valid = 0;
+            _field_count = 0;
+            _end_of_record = false;
+            skip_fields();
+            return true;
+        }
+
+        /** Columns of the last record that have been parsed successfully, with bit `k` standing for column `k`. */
+        std::uint64_t valid() const
+        {
+            return _valid;
+        }
+
+        /** Number of fields in the last record, including fields in excess of the number of columns. */
+        std::size_t field_count() const
+        {
+            return _field_count;
+        }
+
+        /** True if the last record has exactly one field per column, and all fields have been parsed successfully. */
+        bool complete() const
+        {
+            constexpr std::uint64_t all_columns = column_count < 64 ? (std::uint64_t(1) << column_count) - 1 : ~std::uint64_t(0);
+            return _field_count == column_count && _valid == all_columns;
+        }
+
+        /** Offset of the next record in the buffer. */
+        std::size_t position() const
+        {
+            return _pos;
+        }
+
+    private:
+        template<std::size_t... Is>
+        void parse_columns(record_type& record, std::index_sequence<Is...>)
+        {
+            (parse_column<Is>(std::get<Is>(record)), ...);
+        }
+
+        template<std::size_t I, typename T>
+        void parse_column(T& obj)
+        {
+            if (_end_of_record) {
+                return;
+            }
+
+            std::string_view field;
+            const bool well_formed = next_field(field);
+            if (well_formed && parse_field(obj, field)) {
+                _valid |= std::uint64_t(1) << I;
+            }
+        }
+
+        template<typename T>
+        bool parse_field(T& obj, const std::string_view& field)
+        {
+            // fields in the buffer are followed by padding if the buffer is padded, or if enough characters follow
+            const std::size_t field_end = static_cast<std::size_t>(field.data() - _buffer.data()) + field.size();
+            if (_field_in_buffer && (_padded || field_end + padded_string_view::padding <= _buffer.size())) {
+                return detail::parse_field(obj, padded_string_view(field));
+            } else {
+                return detail::parse_field(obj, field);
+            }
+        }
+
+        void skip_fields()
+        {
+            std::string_view field;
+            while (!_end_of_record) {
+                next_field(field);
+            }
+        }
+
+        void skip_empty_lines()
+        {
+            const char* data = _buffer.data();
+            const std::size_t size = _buffer.size();
+            while (_pos < size && (data[_pos] == '\n' || (data[_pos] == '\r' && (_pos + 1 == size || data[_pos + 1] == '\n')))) {
+                ++_pos;
+            }
+        }
+
+        /**
+         * Extracts the field that starts at the current position, and moves past the delimiter or line feed that
+         * terminates it.
+         *
+         * Quotes are removed from quoted fields, and escaped quotes are replaced with a single quote.
+         *
+         * @returns False if a quoted field is not terminated by a quote followed by a delimiter or a line feed.
+         */
+        bool next_field(std::string_view& field)
+        {
+            const char* data = _buffer.data();
+            const std::size_t size = _buffer.size();
+            const std::size_t start = _pos;
+
+            ++_field_count;
+            _field_in_buffer = true;
+            bool well_formed = true;
+            std::size_t end;
+            if (start < size && data[start] == _quote) {
+                // find the closing quote, skipping escaped quotes
+                std::size_t close = start + 1;
+                bool escaped = false;
+                while (true) {
+                    close = next_quote(close);
+                    if (close + 1 < size && data[close + 1] == _quote) {
+                        escaped = true;
+                        close += 2;
+                    } else {
+                        break;
+                    }
+                }
+
+                if (close >= size) {
+                    // unterminated quoted field
+                    field = _buffer.substr(start);
+                    end = size;
+                    well_formed = false;
+                } else {
+                    field = std::string_view(data + start + 1, close - start - 1);
+                    if (escaped) {
+                        unescape(field);
+                        field = _scratch;
+                        _field_in_buffer = false;
+                    }
+
+                    end = close + 1;
+                    if (end < size && data[end] == '\r' && (end + 1 == size || data[end + 1] == '\n')) {
+                        ++end;
+                    }
+                    if (end < size && data[end] != _delimiter && data[end] != '\n') {
+                        // characters between the closing quote and the delimiter
+                        end = next_terminator(end);
+                        well_formed = false;
+                    }
+                }
+            } else {
+                end = next_terminator(start);
+                field = std::string_view(data + start, end - start);
+                if (!field.empty() && field.back() == '\r' && (end == size || data[end] == '\n')) {
+                    field.remove_suffix(1);
+                }
+            }
+
+            _end_of_record = end >= size || data[end] == '\n';
+            _pos = end < size ? end + 1 : size;
+            return well_formed;
+        }
+
+        /** Replaces pairs of quotes with a single quote in a quoted field. */
+        void unescape(const std::string_view& field)
+        {
+            _scratch.clear();
+            for (std::size_t k = 0; k < field.size(); ++k) {
+                _scratch.push_back(field[k]);
+                if (field[k] == _quote) {
+                    ++k;
+                }
+            }
+        }
+
+        /** Returns the position of the next delimiter or line feed at or after the given position. */
+        std::size_t next_terminator(std::size_t from)
+        {
+            const char* data = _buffer.data();
+            while (true) {
+                from = next_structural(from);
+                if (from >= _buffer.size() || data[from] == _delimiter || data[from] == '\n') {
+                    return from;
+                }
+                ++from;
+            }
+        }
+
+        /** Returns the position of the next quote at or after the given position. */
+        std::size_t next_quote(std::size_t from)
+        {
+            const char* data = _buffer.data();
+            while (true) {
+                from = next_structural(from);
+                if (from >= _buffer.size() || data[from] == _quote) {
+                    return from;
+                }
+                ++from;
+            }
+        }
+
+        /** Returns the position of the next structural character at or after the given position. */
+        std::size_t next_structural(std::size_t from)
+        {
+            const std::size_t size = _buffer.size();
+            while (from < size) {
+                if (from - _block >= 64) {
+                    load_block(from);
+                }
+                const std::uint64_t mask = _mask >> (from - _block);
+                if (mask != 0) {
+                    return from + detail::count_trailing_zeros(mask);
+                }
+                from = _block + 64;
+            }
+            return size;
+        }
+
+        /** Classifies the 64 characters that start at the given position. */
+        void load_block(std::size_t from)
+        {
+            const std::size_t remaining = _buffer.size() - from;
+            const char* block = _buffer.data() + from;
+
+            std::array<char, 64> buf;
+            if (remaining < 64 && !_padded) {
+                // copy the last (partial) block such that no bytes are read past the end of the buffer
+                buf.fill(0);
+                if (remaining > 0) {
+                    std::memcpy(buf.data(), block, remaining);
+                }
+                block = buf.data();
+            }
+
+            _mask = detail::classify_structural(block, _delimiter, _quote);
+            if (remaining < 64) {
+                _mask &= (std::uint64_t(1) << remaining) - 1;
+            }
+            _block = from;
+        }
+
+        std::string_view _buffer;
+        char _delimiter;
+        char _quote;
+        bool _padded = false;
+
+        /** Offset of the next field. */
+        std::size_t _pos = 0;
+
+        /** Offset of the 64-byte block classified in `_mask`. */
+        std::size_t _block = 0;
+
+        /** Structural characters in the current block, with bit `k` standing for offset `_block + k`. */
+        std::uint64_t _mask = 0;
+
+        std::uint64_t _valid = 0;
+        std::size_t _field_count = 0;
+        bool _end_of_record = false;
+        bool _field_in_buffer = true;
+
+        /** Unescaped contents of the last quoted field that has escaped quotes. */
+        std::string _scratch;
+    };
+}
@@ -0,0 +1,239 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SIMDPARSE_STATS)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <vector>
+#endif
+
+/**
+ * Hot-path instrumentation.
+ *
+ * If `SIMDPARSE_STATS` is defined, parsers count calls, failures, and the code paths they take in thread-local
+ * counters, which can be aggregated across threads with `collect_stats()`. Otherwise, the counting macros expand
+ * to nothing, and parsers compile to the same code as without instrumentation. The macro must be defined (or left
+ * undefined) consistently in all translation units of a program.
+ */
+#if defined(SIMDPARSE_STATS)
+#define SIMDPARSE_COUNT(name) ::simdparse::detail::add_stat(::simdparse::stat_counter::name, 1)
+#define SIMDPARSE_COUNT_N(name, n) ::simdparse::detail::add_stat(::simdparse::stat_counter::name, (n))
+#define SIMDPARSE_COUNT_RESULT(name, result) ::simdparse::detail::count_failure(::simdparse::stat_counter::name, (result))
+#else
+#define SIMDPARSE_COUNT(name) ((void)0)
+#define SIMDPARSE_COUNT_N(name, n) ((void)0)
+#define SIMDPARSE_COUNT_RESULT(name, result) (result)
+#endif
+
+namespace simdparse
+{
+    /** Events counted by instrumented parsers. */
+    enum class stat_counter : std::size_t
+    {
+        decimal_calls,
+        decimal_failures,
+        decimal_avx512,  // 1 to 20 digits with the AVX-512 kernel
+        decimal_simd,  // leading 16 digits with the AVX2 or NEON kernel
+        decimal_mmx,  // leading 8 digits with the MMX kernel
+        decimal_tail,  // digits past the leading digits parsed by a kernel with `from_chars`
+        decimal_scalar,  // the whole string with `from_chars`
+
+        fixed_decimal_calls,
+        fixed_decimal_failures,
+
+        floating_point_calls,
+        floating_point_failures,
+        floating_point_fallback,  // strings passed to the standard library
+
+        hexadecimal_calls,
+        hexadecimal_failures,
+        hexadecimal_simd,
+        hexadecimal_scalar,
+
+        hex_decode_calls,
+        hex_decode_failures,
+        hex_blocks32,  // 32-character blocks with the AVX2 or NEON kernel
+        hex_scalar,  // characters decoded with table lookups
+
+        date_calls,
+        date_failures,
+        date_simd,
+        date_scalar,
+
+        datetime_calls,
+        datetime_failures,
+        datetime_zulu,  // suffix `Z`
+        datetime_offset,  // suffix `+hh:mm` or `-hh:mm`
+        datetime_utc,  // suffix ` UTC`
+        datetime_naive,  // no time zone designator
+        datetime_fractional,
+        datetime_simd,
+        datetime_scalar,
+
+        epoch_calls,
+        epoch_failures,
+        epoch_simd,
+        epoch_scalar,
+
+        uuid_calls,
+        uuid_failures,
+        uuid_simd,
+        uuid_scalar,
+        uuid_pairs,  // pairs of 8-4-4-4-12 strings parsed together by the AVX-512 batch kernel
+
+        base64url_decode_calls,
+        base64url_decode_failures,
+        base64url_blocks64,  // 64-character blocks with the AVX-512 or NEON kernel
+        base64url_blocks32,  // 32-character blocks with the AVX2 kernel
+        base64url_scalar,  // characters decoded with table lookups
+
+        base64_decode_calls,
+        base64_decode_failures,
+        base64_blocks64,
+        base64_blocks32,
+        base64_scalar,
+
+        count  // number of counters
+    };
+
+#if defined(SIMDPARSE_STATS)
+    /** Name of a counter, e.g. `datetime_zulu`. */
+    constexpr std::string_view stat_name(stat_counter counter)
+    {
+        constexpr std::string_view names[] = {
+            "decimal_calls", "decimal_failures", "decimal_avx512", "decimal_simd", "decimal_mmx", "decimal_tail", "decimal_scalar",
+            "fixed_decimal_calls", "fixed_decimal_failures",
+            "floating_point_calls", "floating_point_failures", "floating_point_fallback",
+            "hexadecimal_calls", "hexadecimal_failures", "hexadecimal_simd", "hexadecimal_scalar",
+            "hex_decode_calls", "hex_decode_failures", "hex_blocks32", "hex_scalar",
+            "date_calls", "date_failures", "date_simd", "date_scalar",
+            "datetime_calls", "datetime_failures", "datetime_zulu", "datetime_offset", "datetime_utc", "datetime_naive",
+            "datetime_fractional", "datetime_simd", "datetime_scalar",
+            "epoch_calls", "epoch_failures", "epoch_simd", "epoch_scalar",
+            "uuid_calls", "uuid_failures", "uuid_simd", "uuid_scalar", "uuid_pairs",
+            "base64url_decode_calls", "base64url_decode_failures", "base64url_blocks64", "base64url_blocks32", "base64url_scalar",
+            "base64_decode_calls", "base64_decode_failures", "base64_blocks64", "base64_blocks32", "base64_scalar",
+        };
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<std::size_t>(stat_counter::count), "expected: a name for each counter");
+        return names[static_cast<std::size_t>(counter)];
+    }
+
+    /** Values of all counters at a point in time. */
+    struct stats_snapshot
+    {
+        std::uint64_t operator[](stat_counter counter) const
+        {
+            return values[static_cast<std::size_t>(counter)];
+        }
+
+        /** Difference of two snapshots, e.g. events in a scrape interval. */
+        stats_snapshot operator-(const stats_snapshot& op) const
+        {
+            stats_snapshot result;
+            for (std::size_t k = 0; k < values.size(); ++k) {
+                result.values[k] = values[k] - op.values[k];
+            }
+            return result;
+        }
+
+        std::array<std::uint64_t, static_cast<std::size_t>(stat_counter::count)> values = {};
+    };
+
+    namespace detail
+    {
+        /** Counters of a single thread, on cache lines of their own such that threads never share a line. */
+        struct alignas(64) thread_stats
+        {
+            /** Written by the owning thread only; atomic such that other threads can read them at any time. */
+            std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(stat_counter::count)> values = {};
+        };
+
+        /** Counters of all live threads, and the totals of threads that have exited. */
+        struct stats_registry
+        {
+            static stats_registry& instance()
+            {
+                static stats_registry registry;
+                return registry;
+            }
+
+            std::mutex mutex;
+            std::vector<thread_stats*> threads;
+            stats_snapshot retired;
+        };
+
+        /** Registers the counters of a thread on first use, and folds them into the totals when the thread exits. */
+        struct thread_stats_owner
+        {
+            thread_stats_owner()
+            {
+                stats_registry& registry = stats_registry::instance();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.threads.push_back(&stats);
+            }
+
+            ~thread_stats_owner()
+            {
+                stats_registry& registry = stats_registry::instance();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (std::size_t k = 0; k < stats.values.size(); ++k) {
+                    registry.retired.values[k] += stats.values[k].load(std::memory_order_relaxed);
+                }
+                registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), &stats));
+            }
+
+            thread_stats stats;
+        };
+
+        inline thread_stats& local_stats()
+        {
+            thread_local thread_stats_owner owner;
+            return owner.stats;
+        }
+
+        /** Increments a counter of the current thread, without a locked read-modify-write instruction. */
+        inline void add_stat(stat_counter counter, std::uint64_t n)
+        {
+            std::atomic<std::uint64_t>& value = local_stats().values[static_cast<std::size_t>(counter)];
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        /** Counts a failure if the result is false, and passes the result through. */
+        inline bool count_failure(stat_counter counter, bool result)
+        {
+            if (!result) {
+                add_stat(counter, 1);
+            }
+            return result;
+        }
+    }
+
+    /** Sums counters across all threads, including threads that have exited. */
+    inline stats_snapshot collect_stats()
+    {
+        detail::stats_registry& registry = detail::stats_registry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        stats_snapshot snapshot = registry.retired;
+        for (const detail::thread_stats* stats : registry.threads) {
+            for (std::size_t k = 0; k < snapshot.values.size(); ++k) {
+                snapshot.values[k] += stats->values[k].load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+#endif
+}
@@ -0,0 +1,265 @@
+/**
+ * simdparse: High-speed parser with vector instructions
+ * @see https://github.com/hunyadi/simdparse
+ *
+ * Copyright (c) 2024 Levente Hunyadi
+ *
+ * This work is licensed under the terms of the MIT license.
+ * For a copy, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+#include "scanner.hpp"
+#include <array>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdparse
+{
+    /**
+     * Parses delimiter-separated records (e.g. CSV or TSV) that arrive in fragments of arbitrary size, such as the
+     * payload of network packets, without assembling the entire message in memory.
+     *
+     * Each fragment is scanned for delimiters and line feeds 64 bytes at a time. Fields that lie entirely within a
+     * fragment are handed to the parser of their column in place. Only the field that straddles the boundary of two
+     * fragments is copied into a small buffer of the parser, and it is parsed when its terminator arrives in a later
+     * fragment. The state that persists between fragments is thus limited to the partial record and at most
+     * `max_carry_size` characters of the partial field.
+     *
+     * Records are passed to a callback as soon as their line feed has been seen, which makes the parser suitable for
+     * driving from an event loop or a coroutine that resumes whenever a fragment has been received. Records end with a
+     * line feed, optionally preceded by a carriage return. Empty lines are skipped. Unlike `field_scanner`, quoted
+     * fields are not recognized.
+     *
+     * @tparam Ts Column types, e.g. `decimal_integer`, `datetime`, `uuid` or `ipv4_addr`. Columns of type
+     * `std::basic_string<std::byte>` hold base64url-encoded data.
+     */
+    template<typename... Ts>
+    struct stream_parser
+    {
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 64, "expected: between 1 and 64 columns");
+
+        constexpr static std::size_t column_count = sizeof...(Ts);
+        using record_type = std::tuple<Ts...>;
+
+        /**
+         * Maximum length of a field that straddles the boundary of two fragments.
+         *
+         * Longer fields are accepted if they lie entirely within a fragment; otherwise they fail to parse.
+         */
+        constexpr static std::size_t max_carry_size = 64;
+
+        explicit stream_parser(char delimiter = ',')
+            : _delimiter(delimiter)
+        {}
+
+        /**
+         * Parses the next fragment of the stream.
+         *
+         * The function is called as `fn(record)` for each record whose line feed is in the fragment. Columns whose
+         * field is missing or cannot be parsed are left in an unspecified state; `valid()`, `field_count()` and
+         * `complete()` describe the record while the function is executing.
+         *
+         * The fragment need not outlive the call.
+         */
+        template<typename F>
+        void feed(const std::string_view& fragment, F&& fn)
+        {
+            _fragment = fragment;
+            load_block(0);
+
+            const std::size_t size = fragment.size();
+            std::size_t pos = 0;
+            while (pos < size) {
+                const std::size_t end = next_terminator(pos);
+                if (end >= size) {
+                    // field continues in the next fragment
+                    carry(fragment.substr(pos));
+                    break;
+                }
+
+                const bool end_of_record = fragment[end] == '\n';
+                if (_carry_size > 0 || _overflow) {
+                    carry(fragment.substr(pos, end - pos));
+                    end_carried_field(end_of_record, fn);
+                } else {
+                    std::size_t length = end - pos;
+                    if (end_of_record && length > 0 && fragment[end - 1] == '\r') {
+                        --length;
+                    }
+
+                    // fields in the fragment are followed by padding if enough characters follow
+                    if (end + padded_string_view::padding <= size) {
+                        end_field(padded_string_view(fragment.data() + pos, length), true, end_of_record, fn);
+                    } else {
+                        end_field(fragment.substr(pos, length), true, end_of_record, fn);
+                    }
+                }
+                pos = end + 1;
+            }
+
+            _fragment = std::string_view();
+        }
+
+        /**
+         * Signals the end of the stream, and passes the last record to the function if it is not terminated by a
+         * line feed.
+         */
+        template<typename F>
+        void finish(F&& fn)
+        {
+            if (_carry_size > 0 || _overflow || _field_count > 0) {
+                end_carried_field(true, fn);
+            }
+        }
+
+        /** Columns of the current record that have been parsed successfully, with bit `k` standing for column `k`. */
+        std::uint64_t valid() const
+        {
+            return _valid;
+        }
+
+        /** Number of fields in the current record, including fields in excess of the number of columns. */
+        std::size_t field_count() const
+        {
+            return _field_count;
+        }
+
+        /** True if the current record has exactly one field per column, and all fields have been parsed successfully. */
+        bool complete() const
+        {
+            constexpr std::uint64_t all_columns = column_count < 64 ? (std::uint64_t(1) << column_count) - 1 : ~std::uint64_t(0);
+            return _field_count == column_count && _valid == all_columns;
+        }
+
+    private:
+        /** Appends part of a field that straddles fragments to the carry-over buffer. */
+        void carry(const std::string_view& part)
+        {
+            if (_overflow || _carry_size + part.size() > max_carry_size) {
+                _overflow = true;
+                return;
+            }
+            std::memcpy(_carry.data() + _carry_size, part.data(), part.size());
+            _carry_size += part.size();
+        }
+
+        /** Parses the field assembled in the carry-over buffer, and clears the buffer. */
+        template<typename F>
+        void end_carried_field(bool end_of_record, F& fn)
+        {
+            std::size_t length = _carry_size;
+            if (end_of_record && length > 0 && _carry[length - 1] == '\r') {
+                --length;
+            }
+
+            const bool well_formed = !_overflow;
+            _carry_size = 0;
+            _overflow = false;
+            end_field(padded_string_view(_carry.data(), length), well_formed, end_of_record, fn);
+        }
+
+        template<typename S, typename F>
+        void end_field(const S& field, bool well_formed, bool end_of_record, F& fn)
+        {
+            if (end_of_record && _field_count == 0 && field.empty()) {
+                // empty line
+                return;
+            }
+
+            if (well_formed && _field_count < column_count) {
+                parse_column(_field_count, field, std::index_sequence_for<Ts...>());
+            }
+            ++_field_count;
+
+            if (end_of_record) {
+                fn(static_cast<const record_type&>(_record));
+                _valid = 0;
+                _field_count = 0;
+            }
+        }
+
+        /** Parses a field with the parser of the column selected at run time. */
+        template<typename S, std::size_t... Is>
+        void parse_column(std::size_t column, const S& field, std::index_sequence<Is...>)
+        {
+            ((column == Is ? parse_column<Is>(field) : void()), ...);
+        }
+
+        template<std::size_t I, typename S>
+        void parse_column(const S& field)
+        {
+            if (detail::parse_field(std::get<I>(_record), field)) {
+                _valid |= std::uint64_t(1) << I;
+            }
+        }
+
+        /** Returns the position of the next delimiter or line feed in the fragment at or after the given position. */
+        std::size_t next_terminator(std::size_t from)
+        {
+            const std::size_t size = _fragment.size();
+            while (from < size) {
+                if (from - _block >= 64) {
+                    load_block(from);
+                }
+                const std::uint64_t mask = _mask >> (from - _block);
+                if (mask != 0) {
+                    return from + detail::count_trailing_zeros(mask);
+                }
+                from = _block + 64;
+            }
+            return size;
+        }
+
+        /** Classifies the 64 characters of the fragment that start at the given position. */
+        void load_block(std::size_t from)
+        {
+            const std::size_t remaining = _fragment.size() - from;
+            const char* block = _fragment.data() + from;
+
+            std::array<char, 64> buf;
+            if (remaining < 64) {
+                // copy the last (partial) block such that no bytes are read past the end of the fragment
+                buf.fill(0);
+                if (remaining > 0) {
+                    std::memcpy(buf.data(), block, remaining);
+                }
+                block = buf.data();
+            }
+
+            // pass the delimiter in place of the quote character such that only delimiters and line feeds are matched
+            _mask = detail::classify_structural(block, _delimiter, _delimiter);
+            if (remaining < 64) {
+                _mask &= (std::uint64_t(1) << remaining) - 1;
+            }
+            _block = from;
+        }
+
+        char _delimiter;
+
+        /** Fragment being parsed by `feed`. */
+        std::string_view _fragment;
+
+        /** Offset of the 64-byte block classified in `_mask`. */
+        std::size_t _block = 0;
+
+        /** Delimiters and line feeds in the current block, with bit `k` standing for offset `_block + k`. */
+        std::uint64_t _mask = 0;
+
+        /** Record whose fields are being parsed. */
+        record_type _record;
+        std::uint64_t _valid = 0;
+        std::size_t _field_count = 0;
+
+        /** Leading part of a field that straddles fragments, followed by padding for the parsers. */
+        std::array<char, max_carry_size + padded_string_view::padding> _carry = {};
+        std::size_t _carry_size = 0;
+
+        /** True if the field that straddles fragments is longer than `max_carry_size`. */
+        bool _overflow = false;
+    };
+}
@@ -10,20 +10,27 @@
 
 #pragma once
 #include <array>
+#include <functional>
 #include <string_view>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include "dispatch.hpp"
+#include "stats.hpp"
 
-#if defined(__AVX2__)
+#if defined(SIMDPARSE_AVX2)
 #include <immintrin.h>
+#elif defined(SIMDPARSE_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace simdparse
 {
-#if defined(__AVX2__)
+#if defined(SIMDPARSE_AVX2)
     namespace detail
     {
-        inline bool parse_uuid(__m256i characters, __m128i& value)
+        SIMDPARSE_TARGET_AVX2 inline bool parse_uuid(__m256i characters, __m128i& value)
         {
             const __m256i digit_lower = _mm256_cmpgt_epi8(_mm256_set1_epi8('0'), characters);
             const __m256i digit_upper = _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('9'));
@@ -66,8 +73,51 @@ namespace simdparse
             return true;
         }
     }
+#elif defined(SIMDPARSE_NEON)
+    namespace detail
+    {
+        /** Converts 16 hexadecimal characters into 8 bytes, most significant byte first. */
+        inline bool parse_uuid_half(uint8x16_t characters, uint8x8_t& value)
+        {
+            // offset from `0` for digits, and offset from `a` for (lowercase) letters, wrapping around if below
+            const uint8x16_t digits = vsubq_u8(characters, vdupq_n_u8('0'));
+            const uint8x16_t alphas = vsubq_u8(vorrq_u8(characters, vdupq_n_u8(0b00100000)), vdupq_n_u8('a'));
+            const uint8x16_t is_digit = vcleq_u8(digits, vdupq_n_u8(9));
+            const uint8x16_t is_alpha = vcleq_u8(alphas, vdupq_n_u8(5));
+            if (vminvq_u8(vorrq_u8(is_digit, is_alpha)) == 0) {
+                return false;
+            }
+            const uint8x16_t nibbles = vbslq_u8(is_digit, digits, vaddq_u8(alphas, vdupq_n_u8(10)));
+
+            // combine pairs of nibbles into bytes, with the high nibble in the low byte of each 16-bit integer
+            const uint16x8_t pairs = vreinterpretq_u16_u8(nibbles);
+            value = vmovn_u16(vorrq_u16(vshlq_n_u16(pairs, 4), vshrq_n_u16(pairs, 8)));
+            return true;
+        }
+
+        /** Converts 32 hexadecimal characters into 16 bytes. */
+        inline bool parse_uuid(uint8x16_t lo, uint8x16_t hi, uint8x16_t& value)
+        {
+            uint8x8_t lo_value;
+            uint8x8_t hi_value;
+            if (!parse_uuid_half(lo, lo_value) || !parse_uuid_half(hi, hi_value)) {
+                return false;
+            }
+            value = vcombine_u8(lo_value, hi_value);
+            return true;
+        }
+    }
 #endif
 
+    /** Layout of a UUID as given by the most significant bits of octet 8 (RFC 9562). */
+    enum class uuid_variant
+    {
+        ncs,  // 0xxx, reserved for backward compatibility with the Apollo Network Computing System
+        rfc_9562,  // 10xx, the layout of RFC 4122 and RFC 9562, with a version in the high nibble of octet 6
+        microsoft,  // 110x, reserved for backward compatibility with Microsoft GUIDs
+        future  // 111x, reserved for future definition
+    };
+
     struct uuid
     {
         constexpr static std::string_view name = "UUID";
@@ -109,6 +159,75 @@ namespace simdparse
             return _id.size();
         }
 
+        /** Version of a UUID of the variant `rfc_9562`, e.g. 4 for random and 7 for Unix time-ordered UUIDs. */
+        constexpr unsigned int version() const
+        {
+            return _id[6] >> 4;
+        }
+
+        constexpr uuid_variant variant() const
+        {
+            if ((_id[8] & 0x80) == 0) {
+                return uuid_variant::ncs;
+            } else if ((_id[8] & 0x40) == 0) {
+                return uuid_variant::rfc_9562;
+            } else if ((_id[8] & 0x20) == 0) {
+                return uuid_variant::microsoft;
+            } else {
+                return uuid_variant::future;
+            }
+        }
+
+        /**
+         * Milliseconds since the Unix epoch embedded in a time-based UUID (version 1, 6 or 7), or 0 for other versions.
+         *
+         * The timestamp of a version 7 UUID occupies the most significant 48 bits, which is why comparing version 7
+         * UUIDs orders them by creation time. Versions 1 and 6 count 100-nanosecond intervals since 1582-10-15.
+         */
+        constexpr std::int64_t timestamp() const
+        {
+            if (variant() != uuid_variant::rfc_9562) {
+                return 0;
+            }
+
+            std::uint64_t ticks = 0;
+            switch (version()) {
+            case 7:
+                return static_cast<std::int64_t>(read_uint(0, 6));
+            case 1:
+                ticks = ((read_uint(6, 2) & 0x0fff) << 48) | (read_uint(4, 2) << 32) | read_uint(0, 4);
+                break;
+            case 6:
+                ticks = (read_uint(0, 4) << 28) | (read_uint(4, 2) << 12) | (read_uint(6, 2) & 0x0fff);
+                break;
+            default:
+                return 0;
+            }
+
+            // 100-nanosecond intervals between 1582-10-15 and the Unix epoch
+            constexpr std::int64_t gregorian_offset = 0x01b21dd213814000;
+            const std::int64_t since_epoch = static_cast<std::int64_t>(ticks) - gregorian_offset;
+            return since_epoch >= 0 ? since_epoch / 10'000 : -((-since_epoch + 9'999) / 10'000);
+        }
+
+        /** Hash value that mixes both 64-bit halves of the UUID, for use as a key in unordered containers. */
+        std::size_t hash() const
+        {
+            std::uint64_t hi;
+            std::uint64_t lo;
+            std::memcpy(&hi, _id.data(), 8);
+            std::memcpy(&lo, _id.data() + 8, 8);
+
+            // combine the halves, and finalize with the 64-bit mixer of MurmurHash3
+            std::uint64_t h = hi ^ (lo * 0x9e3779b97f4a7c15ull);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return static_cast<std::size_t>(h);
+        }
+
         bool operator==(const uuid& op) const
         {
             return _id == op._id;
@@ -152,24 +271,54 @@ namespace simdparse
         /**
          * Converts an UUIDv4 string or a hexadecimal string to a 128-bit unsigned int.
          *
-         * UUID string is expected in the 8-4-4-4-12 format, e.g. `f81d4fae-7dec-11d0-a765-00a0c91e6bf6`.
-         * The hexadecimal string is expected to have a length of 32 characters.
+         * UUID string is expected in the 8-4-4-4-12 format, e.g. `f81d4fae-7dec-11d0-a765-00a0c91e6bf6`, optionally
+         * enclosed in curly braces. The hexadecimal string is expected to have a length of 32 characters.
          */
         bool parse(const std::string_view& str)
         {
+            SIMDPARSE_COUNT(uuid_calls);
             if (str.size() == 38) {  // skip opening and closing curly braces
-                return parse_uuid_rfc_4122(str.data() + 1);
+                return SIMDPARSE_COUNT_RESULT(uuid_failures, str[0] == '{' && str[37] == '}' && parse_uuid_rfc_4122(str.data() + 1));
             } else if (str.size() == 36) {
-                return parse_uuid_rfc_4122(str.data());
+                return SIMDPARSE_COUNT_RESULT(uuid_failures, parse_uuid_rfc_4122(str.data()));
             } else if (str.size() == 32) {
-                return parse_uuid_compact(str.data());
+                return SIMDPARSE_COUNT_RESULT(uuid_failures, parse_uuid_compact(str.data()));
             }
+            SIMDPARSE_COUNT(uuid_failures);
             return false;
         }
 
-#if defined(__AVX2__)
+        /** Converts a hexadecimal string of 32 characters to a 128-bit unsigned int. */
         bool parse_uuid_compact(const char* str)
         {
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(uuid_simd);
+                return parse_uuid_compact_simd(str);
+            }
+#endif
+            SIMDPARSE_COUNT(uuid_scalar);
+            return scan_uuid_compact(str);
+        }
+
+        /** Converts an UUIDv4 string representation in the 8-4-4-4-12 format to a 128-bit unsigned int. */
+        bool parse_uuid_rfc_4122(const char* str)
+        {
+#if defined(SIMDPARSE_SIMD)
+            if (detail::use_simd()) {
+                SIMDPARSE_COUNT(uuid_simd);
+                return parse_uuid_rfc_4122_simd(str);
+            }
+#endif
+            SIMDPARSE_COUNT(uuid_scalar);
+            return scan_uuid_rfc_4122(str);
+        }
+
+    private:
+#if defined(SIMDPARSE_AVX2)
+        /** Converts a hexadecimal string of 32 characters to a 128-bit unsigned int with SIMD instructions. */
+        SIMDPARSE_TARGET_AVX2 bool parse_uuid_compact_simd(const char* str)
+        {
             const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
             __m128i value;
             if (!detail::parse_uuid(characters, value)) {
@@ -187,7 +336,7 @@ namespace simdparse
          *
          * @see https://github.com/crashoz/uuid_v4
          */
-        bool parse_uuid_rfc_4122(const char* str)
+        SIMDPARSE_TARGET_AVX2 bool parse_uuid_rfc_4122_simd(const char* str)
         {
             // original hexadecimal digit sequence (as in input string):
             // 01234567-89ab-cdef-FEDC-BA9876543210
@@ -196,6 +345,11 @@ namespace simdparse
             // lane 1: 01234567-89ab-cd -> 0123456789abcd__
             // lane 2: ef-FEDC-BA987654 -> FEDCBA987654____
             const __m256i original = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+            constexpr std::uint32_t dash_mask = (1u << 8) | (1u << 13) | (1u << 18) | (1u << 23);
+            const std::uint32_t dashes = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(original, _mm256_set1_epi8('-'))));
+            if ((dashes & dash_mask) != dash_mask) {
+                return false;
+            }
             const __m256i dash_shuffle = _mm256_set_epi32(0x80808080, 0x0f0e0d0c, 0x0b0a0908, 0x06050403, 0x80800f0e, 0x0c0b0a09, 0x07060504, 0x03020100);
             const __m256i x = _mm256_shuffle_epi8(original, dash_shuffle);
 
@@ -216,9 +370,50 @@ namespace simdparse
             _mm_storeu_si128(reinterpret_cast<__m128i*>(_id.data()), value);
             return true;
         }
-#else
+#elif defined(SIMDPARSE_NEON)
+        /** Converts a hexadecimal string of 32 characters to a 128-bit unsigned int with NEON instructions. */
+        bool parse_uuid_compact_simd(const char* str)
+        {
+            const std::uint8_t* chars = reinterpret_cast<const std::uint8_t*>(str);
+            uint8x16_t value;
+            if (!detail::parse_uuid(vld1q_u8(chars), vld1q_u8(chars + 16), value)) {
+                return false;
+            }
+            vst1q_u8(_id.data(), value);
+            return true;
+        }
+
+        /**
+         * Converts an UUIDv4 string representation to a 128-bit unsigned int with NEON instructions.
+         *
+         * UUID string is expected in the 8-4-4-4-12 format, e.g. `f81d4fae-7dec-11d0-a765-00a0c91e6bf6`.
+         */
+        bool parse_uuid_rfc_4122_simd(const char* str)
+        {
+            if (str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-') {
+                return false;
+            }
+
+            // remove dashes with a table lookup in three overlapping 16-byte registers at offsets 0, 16 and 20:
+            // 01234567-89ab-cdef-FEDC-BA9876543210 -> 0123456789abcdef FEDCBA9876543210
+            const std::uint8_t* chars = reinterpret_cast<const std::uint8_t*>(str);
+            const uint8x16x3_t original = { { vld1q_u8(chars), vld1q_u8(chars + 16), vld1q_u8(chars + 20) } };
+            static constexpr std::uint8_t lo_indices[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, 16, 17 };
+            static constexpr std::uint8_t hi_indices[16] = { 19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 44, 45, 46, 47 };
+            const uint8x16_t lo = vqtbl3q_u8(original, vld1q_u8(lo_indices));
+            const uint8x16_t hi = vqtbl3q_u8(original, vld1q_u8(hi_indices));
+
+            uint8x16_t value;
+            if (!detail::parse_uuid(lo, hi, value)) {
+                return false;
+            }
+            vst1q_u8(_id.data(), value);
+            return true;
+        }
+#endif
+
         /** Converts a hexadecimal string of 32 characters to a 128-bit unsigned int. */
-        bool parse_uuid_compact(const char* str)
+        bool scan_uuid_compact(const char* str)
         {
             int n = 0;
             sscanf(str,
@@ -240,7 +435,7 @@ namespace simdparse
          *
          * UUID string is expected in the 8-4-4-4-12 format, e.g. `f81d4fae-7dec-11d0-a765-00a0c91e6bf6`.
          */
-        bool parse_uuid_rfc_4122(const char* str)
+        bool scan_uuid_rfc_4122(const char* str)
         {
             int n = 0;
             std::sscanf(str,
@@ -256,9 +451,30 @@ namespace simdparse
                 &_id[10], &_id[11], &_id[12], &_id[13], &_id[14], &_id[15], &n);
             return n == 36;
         }
-#endif
 
     private:
+        /** Reads a big-endian unsigned integer of the given number of bytes. */
+        constexpr std::uint64_t read_uint(std::size_t offset, std::size_t count) const
+        {
+            std::uint64_t value = 0;
+            for (std::size_t k = 0; k < count; ++k) {
+                value = (value << 8) | _id[offset + k];
+            }
+            return value;
+        }
+
         std::array<std::uint8_t, 16> _id = { 0 };
     };
 }
+
+namespace std
+{
+    template<>
+    struct hash<simdparse::uuid>
+    {
+        std::size_t operator()(const simdparse::uuid& u) const noexcept
+        {
+            return u.hash();
+        }
+    };
+}
@@ -9,12 +9,26 @@
  */
 
 #include <simdparse/base64.hpp>
+#include <simdparse/batch.hpp>
+#include <simdparse/column.hpp>
 #include <simdparse/datetime.hpp>
 #include <simdparse/decimal.hpp>
+#include <simdparse/epoch.hpp>
+#include <simdparse/floating_point.hpp>
+#include <simdparse/format.hpp>
 #include <simdparse/hexadecimal.hpp>
+#include <simdparse/http_date.hpp>
+#include <simdparse/ingest.hpp>
 #include <simdparse/ipaddr.hpp>
+#include <simdparse/network.hpp>
 #include <simdparse/uuid.hpp>
 #include <simdparse/parse.hpp>
+#include <simdparse/record.hpp>
+#include <simdparse/scanner.hpp>
+#include <simdparse/stream.hpp>
+
+#include <algorithm>
+#include <unordered_set>
 
 template<std::size_t N>
 std::string_view to_string_view(const std::array<char, N>& a)
@@ -72,6 +86,54 @@ inline void check_equals(unsigned int val, unsigned int ref)
     }
 }
 
+/** Checks that a date-time string parses with a layout known at compile time, with and without padding. */
+template<typename Format>
+void check_datetime_format(const std::string& str, const simdparse::datetime& ref)
+{
+    using namespace simdparse;
+    const std::string buf = str + std::string(padded_string_view::padding, '9');
+    datetime obj;
+    if (parse<datetime, Format>(str) != ref || !obj.parse(padded_string_view(buf.data(), str.size()), Format()) || obj != ref) {
+        throw assertion_error("date-time format mismatch: " + str);
+    }
+}
+
+/** Checks that a date-time string is rejected when parsed with a layout known at compile time. */
+template<typename Format>
+void check_datetime_format_fail(const std::string& str)
+{
+    using namespace simdparse;
+    const std::string buf = str + std::string(padded_string_view::padding, '0');
+    datetime obj;
+    if (obj.parse(str, Format()) || obj.parse(padded_string_view(buf.data(), str.size()), Format())) {
+        throw assertion_error("unexpected: date-time format accepted: " + str);
+    }
+}
+
+/** Checks that a numeric timestamp parses into microseconds since the epoch, with and without padding. */
+template<typename Format = simdparse::epoch_format<simdparse::epoch_unit::automatic>>
+void check_epoch_time(const std::string& str, std::int64_t ref)
+{
+    using namespace simdparse;
+    const std::string buf = str + std::string(padded_string_view::padding, '9');
+    epoch_time obj;
+    if (!obj.parse(str, Format()) || obj.value() != ref || !obj.parse(padded_string_view(buf.data(), str.size()), Format()) || obj.value() != ref) {
+        throw assertion_error("epoch timestamp mismatch: " + str);
+    }
+}
+
+/** Checks that a numeric timestamp is rejected, with and without padding. */
+template<typename Format = simdparse::epoch_format<simdparse::epoch_unit::automatic>>
+void check_epoch_time_fail(const std::string& str)
+{
+    using namespace simdparse;
+    const std::string buf = str + std::string(padded_string_view::padding, '0');
+    epoch_time obj;
+    if (obj.parse(str, Format()) || obj.parse(padded_string_view(buf.data(), str.size()), Format())) {
+        throw assertion_error("unexpected: epoch timestamp accepted: " + str);
+    }
+}
+
 int main(int /*argc*/, char* /*argv*/[])
 {
     using simdparse::check_base64url;
@@ -101,6 +163,153 @@ int main(int /*argc*/, char* /*argv*/[])
         ),
         "Zm9vYmFyABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
     );
+    {
+        // encode and decode into caller-provided buffers
+        using simdparse::base64url;
+        using simdparse::base64;
+        static_assert(base64url::encoded_size(0) == 0 && base64url::encoded_size(1) == 2 && base64url::encoded_size(5) == 7 && base64url::encoded_size(6) == 8);
+        static_assert(base64url::decoded_size(0) == 0 && base64url::decoded_size(2) == 1 && base64url::decoded_size(7) == 5 && base64url::decoded_size(8) == 6);
+        static_assert(base64::encoded_size(1) == 4 && base64::encoded_size(5) == 8 && base64::decoded_size(8) == 6);
+
+        std::array<std::byte, 6> bytes;
+        std::array<char, 8> chars;
+        if (base64url::decode("Zm9vYmE", bytes.data(), bytes.size()) != 5 || std::memcmp(bytes.data(), "fooba", 5) != 0) {
+            throw std::runtime_error("base64url decode into buffer");
+        }
+        if (base64url::decode("Zm9vYmE", bytes.data(), 4) != base64url::npos || base64url::decode("Zm9v!mE", bytes.data(), bytes.size()) != base64url::npos) {
+            throw std::runtime_error("expected: base64url decode error");
+        }
+        if (base64url::encode(std::basic_string_view<std::byte>(bytes.data(), 5), chars.data(), chars.size()) != 7 || std::string_view(chars.data(), 7) != "Zm9vYmE") {
+            throw std::runtime_error("base64url encode into buffer");
+        }
+        if (base64url::encode(std::basic_string_view<std::byte>(bytes.data(), 5), chars.data(), 6) != base64url::npos) {
+            throw std::runtime_error("expected: base64url encode error");
+        }
+        if (base64::decode("Zm9vYmE=", bytes.data(), 5) != 5 || std::memcmp(bytes.data(), "fooba", 5) != 0 || base64::decode("Zm9vYmE=", bytes.data(), 4) != base64::npos) {
+            throw std::runtime_error("base64 decode into buffer");
+        }
+        if (base64::encode(std::basic_string_view<std::byte>(bytes.data(), 5), chars.data(), chars.size()) != 8 || std::string_view(chars.data(), 8) != "Zm9vYmE=") {
+            throw std::runtime_error("base64 encode into buffer");
+        }
+    }
+
+    {
+        // decode a string delivered in chunks of varying size
+        using simdparse::base64url;
+        std::basic_string<std::byte> bytes;
+        for (std::size_t k = 0; k < 10'000; ++k) {
+            bytes.push_back(static_cast<std::byte>(k * 13 + k / 7));
+        }
+        for (std::size_t extra : { 0, 1, 2 }) {
+            std::basic_string<std::byte> expected = bytes.substr(0, bytes.size() - extra);
+            std::string encoded = base64url::encode(expected);
+            for (std::size_t step : { 1, 3, 4, 5, 31, 1000, 4096, 100'000 }) {
+                base64url::decoder dec;
+                std::basic_string<std::byte> decoded;
+                auto sink = [&decoded](const std::byte* data, std::size_t len) {
+                    decoded.append(data, len);
+                };
+                for (std::size_t k = 0; k < encoded.size(); k += step) {
+                    if (!dec.update(std::string_view(encoded).substr(k, step + k % 3), sink)) {
+                        throw std::runtime_error("base64url streaming decode error");
+                    }
+                    k += k % 3;
+                }
+                if (!dec.finish(sink) || decoded != expected) {
+                    throw std::runtime_error("base64url streaming decode does not match");
+                }
+            }
+        }
+
+        base64url::decoder dec;
+        auto ignore = [](const std::byte*, std::size_t) {};
+        if (dec.update("Zm9vY", ignore) == false || dec.finish(ignore) != false) {
+            throw std::runtime_error("expected: base64url streaming decode error for incomplete input");
+        }
+        if (dec.update("Zm9v", ignore) == false || dec.update("Y!", ignore) == false || dec.update("mE", ignore) != false || dec.finish(ignore) != false) {
+            throw std::runtime_error("expected: base64url streaming decode error for invalid character");
+        }
+    }
+
+    using simdparse::check_base64;
+    check_base64("", "");
+    check_base64("f", "Zg==");
+    check_base64("fo", "Zm8=");
+    check_base64("foo", "Zm9v");
+    check_base64("foob", "Zm9vYg==");
+    check_base64("fooba", "Zm9vYmE=");
+    check_base64("foobar", "Zm9vYmFy");
+    check_base64(
+        std::string_view(
+            "foobar"
+            "\x00\x10\x83\x10\x51\x87\x20\x92\x8b\x30\xd3\x8f\x41\x14\x93\x51"
+            "\x55\x97\x61\x96\x9b\x71\xd7\x9f\x82\x18\xa3\x92\x59\xa7\xa2\x9a"
+            "\xab\xb2\xdb\xaf\xc3\x1c\xb3\xd3\x5d\xb7\xe3\x9e\xbb\xf3\xdf\xbf"
+            "f",
+            55
+        ),
+        "Zm9vYmFyABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/Zg=="
+    );
+    {
+        using simdparse::base64;
+        std::basic_string<std::byte> decoded;
+        for (std::string_view invalid : { "Zg", "Zg=", "Zg=a", "Z===", "====", "Zm9v=Yg=", "Zm9vYg-_", "Zm9v\nYg==" }) {
+            if (base64::decode(invalid, decoded)) {
+                throw std::runtime_error("expected: Base64 decode error");
+            }
+        }
+        if (!base64::decode("Zm9v\r\nYmFy  Zm9v\tYmFy\n\n", decoded, base64::skip_whitespace) || decoded.size() != 12) {
+            throw std::runtime_error("expected: Base64 decode with whitespace");
+        }
+
+        // decode lines of a MIME body
+        std::basic_string<std::byte> bytes;
+        for (std::size_t k = 0; k < 1000; ++k) {
+            bytes.push_back(static_cast<std::byte>(k * 7 + 3));
+        }
+        std::string encoded = base64::encode(bytes);
+        std::string mime;
+        for (std::size_t k = 0; k < encoded.size(); k += 76) {
+            mime += encoded.substr(k, 76);
+            mime += "\r\n";
+        }
+        if (!base64::decode(mime, decoded, base64::skip_whitespace) || decoded != bytes || !base64::decode(encoded, decoded) || decoded != bytes) {
+            throw std::runtime_error("Base64 MIME body does not round-trip");
+        }
+    }
+    {
+        // compare vectorized encoding of long inputs with scalar encoding of each triplet
+        using simdparse::base64url;
+        std::basic_string<std::byte> bytes;
+        std::uint32_t seed = 3;
+        for (std::size_t len = 0; len < 200; ++len) {
+            std::string encoded = base64url::encode(bytes);
+            for (std::size_t k = 0; k + 3 <= len; k += 3) {
+                if (encoded.compare(k / 3 * 4, 4, base64url::encode(bytes.substr(k, 3))) != 0) {
+                    throw std::runtime_error("vectorized and scalar Base64 encoding differ");
+                }
+            }
+            std::basic_string<std::byte> decoded;
+            if (!base64url::decode(encoded, decoded) || decoded != bytes) {
+                throw std::runtime_error("Base64 encoding does not round-trip");
+            }
+
+            // standard alphabet differs only in two characters and padding
+            std::string standard = simdparse::base64::encode(bytes);
+            if (!simdparse::base64::decode(standard, decoded) || decoded != bytes) {
+                throw std::runtime_error("Base64 encoding does not round-trip");
+            }
+            standard.erase(standard.find_last_not_of('=') + 1);
+            for (char& c : standard) {
+                c = c == '+' ? '-' : c == '/' ? '_' : c;
+            }
+            if (standard != encoded) {
+                throw std::runtime_error("Base64 encodings with standard and URL-safe alphabet differ");
+            }
+            seed = seed * 1103515245 + 12345;
+            bytes.push_back(static_cast<std::byte>(seed >> 16));
+        }
+    }
 
     using simdparse::check_parse;
     using simdparse::check_fail;
@@ -204,11 +413,71 @@ int main(int /*argc*/, char* /*argv*/[])
     // wrong separators
     check_fail<datetime>("1984_10_24 23:59:59Z");
     check_fail<datetime>("1984-10-24 23_59_59Z");
+    check_fail<datetime>("1984-10-24 23:59+59");
     check_fail<datetime>("1984-10-24 23:59:59_01:00");
 
     // oversized string
     check_fail<datetime>(",2023-03-30T00:36:16.556900+00:00,");
 
+    // HTTP dates and log timestamps
+    using simdparse::http_date;
+    using simdparse::clf_datetime;
+    static_assert(simdparse::weekday_to_ordinal('S', 'u', 'n') == 7 && simdparse::weekday_to_ordinal('m', 'o', 'n') == 1);
+    static_assert(simdparse::weekday_to_ordinal('J', 'a', 'n') == 0);
+    check_parse<http_date>("Sun, 06 Nov 1994 08:49:37 GMT", datetime(1994, 11, 6, 8, 49, 37));
+    check_parse<http_date>("Thu, 31 Dec 2099 23:59:59 GMT", datetime(2099, 12, 31, 23, 59, 59));
+    check_parse<http_date>("Mon, 01 Jan 2024 00:00:00 +0130", datetime(2024, 1, 1, 0, 0, 0, tzoffset(tzoffset::east, 1, 30)));
+    check_parse<http_date>("Tue, 15 Aug 2023 12:30:45 -0700", datetime(2023, 8, 15, 12, 30, 45, tzoffset(tzoffset::west, 7, 0)));
+    check_parse<clf_datetime>("10/Oct/2000:13:55:36 -0700", datetime(2000, 10, 10, 13, 55, 36, tzoffset(tzoffset::west, 7, 0)));
+    check_parse<clf_datetime>("[01/Feb/1999:00:00:00 +0000]", datetime(1999, 2, 1, 0, 0, 0));
+    check_parse<clf_datetime>("29/feb/2024:23:59:59 +1400", datetime(2024, 2, 29, 23, 59, 59, tzoffset(tzoffset::east, 14, 0)));
+    if (simdparse::parse<clf_datetime>(std::string_view("10/Oct/2000:13:55:36 -0700")).as_microtime() != simdparse::microtime(2000, 10, 10, 20, 55, 36)) {
+        throw assertion_error("CLF timestamp conversion mismatch");
+    }
+    check_fail<http_date>("Sun, 06 Nov 1994 08:49:37 UTC");
+    check_fail<http_date>("Sun, 06 Xyz 1994 08:49:37 GMT");
+    check_fail<http_date>("Sux, 06 Nov 1994 08:49:37 GMT");
+    check_fail<http_date>("Sun, 6 Nov 1994 08:49:37 GMT");
+    check_fail<http_date>("Sun, 00 Nov 1994 08:49:37 GMT");
+    check_fail<http_date>("Sun, 32 Nov 1994 08:49:37 GMT");
+    check_fail<http_date>("Sun, 06 Nov 1994 24:49:37 GMT");
+    check_fail<http_date>("Sun, 06 Nov 1994 08:60:37 GMT");
+    check_fail<http_date>("Sun, 06 Nov 1994 08:49:37 ,0100");
+    check_fail<http_date>("Sun, 06 Nov 1994 08:49:37 +0160");
+    check_fail<clf_datetime>("10/Oct/2000 13:55:36 -0700");
+    check_fail<clf_datetime>("10/Oct/2000:13:55:36 -0700]");
+    check_fail<clf_datetime>("10/[ct/2000:13:55:36 -0700");
+    check_fail<clf_datetime>("1O/Oct/2000:13:55:36 -0700");
+    check_fail<http_date>("Sun, 06 ``` 1994 08:49:37 GMT");  // name that hashes to zero, the value of padding lanes
+    check_fail<http_date>("```, 06 Nov 1994 08:49:37 GMT");
+    check_fail<clf_datetime>("10/```/2000:13:55:36 -0700");
+
+    // layouts known at compile time
+    {
+        using simdparse::datetime_format;
+        using simdparse::tz_designator;
+        check_datetime_format<datetime_format<'T', 6, tz_designator::zulu>>("1984-10-24T23:59:59.123456Z", datetime(1984, 10, 24, 23, 59, 59, 123456000));
+        check_datetime_format<datetime_format<' ', 0, tz_designator::none>>("1984-10-24 23:59:59", datetime(1984, 10, 24, 23, 59, 59));
+        check_datetime_format<datetime_format<' ', 3, tz_designator::utc>>("1984-10-24 23:59:59.123 UTC", datetime(1984, 10, 24, 23, 59, 59, 123000000));
+        check_datetime_format<datetime_format<'T', 0, tz_designator::offset>>("1984-10-24T23:59:59-11:30", datetime(1984, 10, 24, 23, 59, 59, tzoffset(tzoffset::west, 11, 30)));
+        check_datetime_format<datetime_format<'T', 6, tz_designator::offset>>("1984-10-24T23:59:59.000456+01:00", datetime(1984, 10, 24, 23, 59, 59, 456000, tz_east));
+        check_datetime_format<datetime_format<'T', 9, tz_designator::offset>>("9999-12-31T23:59:59.999999999+01:00", datetime(9999, 12, 31, 23, 59, 59, 999999999, tz_east));
+        check_datetime_format<datetime_format<'T', 9, tz_designator::zulu>>("1984-01-01T01:02:03.000456789Z", datetime(1984, 1, 1, 1, 2, 3, 456789));
+        check_datetime_format<datetime_format<'T', 9, tz_designator::utc>>("1984-01-01T01:02:03.000456789 UTC", datetime(1984, 1, 1, 1, 2, 3, 456789));
+
+        check_datetime_format_fail<datetime_format<'T', 6, tz_designator::zulu>>("1984-10-24 23:59:59.123456Z");  // wrong separator
+        check_datetime_format_fail<datetime_format<'T', 6, tz_designator::zulu>>("1984-10-24T23:59:59.123Z");  // wrong length
+        check_datetime_format_fail<datetime_format<'T', 6, tz_designator::zulu>>("1984-10-24T23:59:59.123456+");  // wrong suffix
+        check_datetime_format_fail<datetime_format<'T', 6, tz_designator::zulu>>("1984-10-24T23:59:59.12345xZ");
+        check_datetime_format_fail<datetime_format<'T', 0, tz_designator::offset>>("1984-10-24T23:59:59,01:00");
+        check_datetime_format_fail<datetime_format<'T', 0, tz_designator::offset>>("1984-10-24T23:59:59+01:60");
+        check_datetime_format_fail<datetime_format<'T', 9, tz_designator::offset>>("1984-10-24T23:59:59.123456789+0x:00");
+        check_datetime_format_fail<datetime_format<'T', 9, tz_designator::utc>>("1984-10-24T23:59:59.123456789 UTX");  // last character past 32 bytes
+        check_datetime_format_fail<datetime_format<' ', 9, tz_designator::utc>>("1984-10-24 23:59:59.123456789 UT");
+        check_datetime_format_fail<datetime_format<' ', 0, tz_designator::utc>>("1984-10-24 23:59:59 CET");
+        check_datetime_format_fail<datetime_format<' ', 0, tz_designator::none>>("1984-10-24 23:60:59");
+    }
+
     using simdparse::microtime;
     constexpr microtime mt1 = microtime(10'001'000);  // 10s 1000us
     constexpr microtime mt2 = microtime(20'002'000);  // 20s 2000us
@@ -250,7 +519,63 @@ int main(int /*argc*/, char* /*argv*/[])
     check_parse("9999-12-31 23:59:59", microtime(9999, 12, 31, 23, 59, 59));
     check_parse("9999-12-31 23:59:59.000999", microtime(9999, 12, 31, 23, 59, 59, 999));
 
+    // numeric timestamps since the epoch
+    {
+        using simdparse::epoch_time;
+        using simdparse::epoch_format;
+        using simdparse::epoch_unit;
+        check_epoch_time("1700000000", 1'700'000'000'000'000);
+        check_epoch_time("1700000000123", 1'700'000'000'123'000);
+        check_epoch_time("1700000000123456", 1'700'000'000'123'456);
+        check_epoch_time("1700000000123456789", 1'700'000'000'123'456);
+        check_epoch_time("1700000000.5", 1'700'000'000'500'000);
+        check_epoch_time("1700000000.123456789", 1'700'000'000'123'456);
+        check_epoch_time("1700000000123.456", 1'700'000'000'123'456);
+        check_epoch_time("0", 0);
+        check_epoch_time("86400", 86'400'000'000);
+        check_epoch_time("-1.5", -2'500'000);  // 1969-12-31 23:59:58.5
+        check_epoch_time("-0.000001", -1'999'999);
+        check_epoch_time("-1500", -1'500'000'000);
+        check_epoch_time("-1500000000000.5", -1'500'000'001'999'500);  // milliseconds
+        check_epoch_time("-86400", -86'400'000'000);
+        check_epoch_time<epoch_format<epoch_unit::seconds>>("1700000000123", 1'700'000'000'123'000'000);
+        check_epoch_time<epoch_format<epoch_unit::milliseconds>>("1700000000", 1'700'000'000'000);
+        check_epoch_time<epoch_format<epoch_unit::microseconds>>("9223372036854775807", 9'223'372'036'854'775'807);
+        check_epoch_time<epoch_format<epoch_unit::nanoseconds>>("1500.999", 1);
+
+        for (const auto& [str, ref] : std::vector<std::pair<std::string_view, std::string_view>>{
+            { "-1.5", "1969-12-31 23:59:58.500000Z" },
+            { "-0.000001", "1969-12-31 23:59:59.999999Z" },
+            { "-86400.25", "1969-12-30 23:59:59.750000Z" },
+            { "-1500", "1969-12-31 23:35:00.000000Z" }
+        }) {
+            const epoch_time t = simdparse::parse<epoch_time>(str);
+            if (to_string(t) != ref || simdparse::parse<microtime>(ref) != t) {
+                throw std::runtime_error("negative epoch timestamp mismatch: " + std::string(str));
+            }
+        }
+
+        check_epoch_time_fail("");
+        check_epoch_time_fail("-");
+        check_epoch_time_fail("+1700000000");
+        check_epoch_time_fail("1700000000.");
+        check_epoch_time_fail(".5");
+        check_epoch_time_fail("1700000000.1234567890");  // more than 9 fractional digits
+        check_epoch_time_fail("17000000001234567890");  // more than 19 integer digits
+        check_epoch_time_fail("1700000000.12.3");
+        check_epoch_time_fail("17000x0000");
+        check_epoch_time_fail("1700000000 ");
+        check_epoch_time_fail<epoch_format<epoch_unit::seconds>>("9223372036855");  // out of range
+
+        if (simdparse::parse<epoch_time, epoch_format<epoch_unit::milliseconds>>("1700000000123").as_datetime() != datetime(2023, 11, 14, 22, 13, 20, 123'000'000)) {
+            throw assertion_error("epoch timestamp conversion mismatch");
+        }
+    }
+
     // conversion to date
+    static_assert(microtime(1984, 10, 24, 23, 59, 59, 123000).as_date() == date(1984, 10, 24));
+    static_assert(microtime(1899, 12, 31, 0, 0, 0).as_date() == date(1899, 12, 31));
+    static_assert(microtime(-1'000'000).as_datetime() == datetime(1969, 12, 31, 23, 59, 59));
     check_equals(microtime(1984, 10, 24, 23, 59, 59, 123000).as_date().year, 1984);
     check_equals(microtime(1984, 10, 24, 23, 59, 59, 123000).as_date().month, 10u);
     check_equals(microtime(1984, 10, 24, 23, 59, 59, 123000).as_date().day, 24u);
@@ -267,10 +592,68 @@ int main(int /*argc*/, char* /*argv*/[])
     // extract fractional seconds
     check_equals(microtime(1984, 10, 24, 23, 59, 59, 123000).microseconds(), 123000);
 
+    // days since epoch without calling timegm
+    using simdparse::detail::days_from_civil;
+    static_assert(days_from_civil(1970, 1, 1) == 0);
+    static_assert(days_from_civil(1969, 12, 31) == -1);
+    static_assert(days_from_civil(2000, 3, 1) == 11'017);
+    static_assert(days_from_civil(1, 1, 1) == -719'162);
+    static_assert(microtime(1970, 1, 1, 0, 0, 1, 5).value() == 1'000'005);
+    static_assert(microtime(1984, 10, 24, 1, 0, 0, tzoffset(tzoffset::east, 1, 0)) == microtime(1984, 10, 24, 0, 0, 0));
+    for (int year : { 0, 1, 399, 400, 1582, 1899, 1900, 1969, 1970, 2000, 2024, 2100, 9999 }) {
+        std::tm ts{};
+        for (unsigned int month = 1; month <= 12; ++month) {
+            if (days_from_civil(year, month, 1) + 28 > days_from_civil(year, month % 12 + 1, 1) + (month == 12 ? 365 : 0)) {
+                throw std::runtime_error("days since epoch is not monotonic");
+            }
+        }
+        if (year >= 1970 && year < 2038) {
+            ts.tm_year = year - 1900;
+            ts.tm_mon = 2;
+            ts.tm_mday = 1;
+            if (days_from_civil(year, 3, 1) * 86'400 != static_cast<std::int64_t>(timegm(&ts))) {
+                throw std::runtime_error("days since epoch does not match timegm");
+            }
+        }
+    }
+
     using simdparse::ipv4_addr;
     constexpr ipv4_addr sample_ipv4(192, 0, 2, 1);
     check_parse("0.0.0.0", ipv4_addr());
     check_parse("192.0.2.1", sample_ipv4);
+    check_parse("255.255.255.255", ipv4_addr(255, 255, 255, 255));
+    check_parse("10.0.100.9", ipv4_addr(10, 0, 100, 9));
+    check_fail<ipv4_addr>("");
+    check_fail<ipv4_addr>("1.2.3");
+    check_fail<ipv4_addr>("1.2.3.4.");
+    check_fail<ipv4_addr>("1.2.3.4.5");
+    check_fail<ipv4_addr>("1..2.3");
+    check_fail<ipv4_addr>("256.0.0.1");
+    check_fail<ipv4_addr>("01.2.3.4");
+    check_fail<ipv4_addr>("1.2.3.1000");
+    check_fail<ipv4_addr>("1.2.3.-4");
+    check_fail<ipv4_addr>(" 1.2.3.4");
+    {
+        // compare with system parser
+        const char alphabet[] = "0123456789.....x";
+        std::uint32_t seed = 1;
+        for (std::size_t k = 0; k < 100'000; ++k) {
+            std::array<char, 16> str = {};
+            seed = seed * 1103515245 + 12345;
+            std::size_t len = 5 + (seed >> 16) % 12;
+            for (std::size_t j = 0; j < len; ++j) {
+                seed = seed * 1103515245 + 12345;
+                str[j] = alphabet[(seed >> 16) % 16];
+            }
+            std::array<std::uint8_t, 4> expected;
+            bool expected_valid = inet_pton(AF_INET, str.data(), expected.data()) > 0;
+            ipv4_addr addr;
+            bool valid = addr.parse(std::string_view(str.data(), len));
+            if (valid != expected_valid || (valid && std::memcmp(addr.data(), expected.data(), 4) != 0)) {
+                throw std::runtime_error("IPv4 address parsing does not match inet_pton");
+            }
+        }
+    }
 
     using simdparse::ipv6_addr;
     constexpr ipv6_addr sample_ipv6(0x2001, 0xdb8, 0x0, 0x1234, 0x0, 0x567, 0x8, 0x1);
@@ -281,6 +664,202 @@ int main(int /*argc*/, char* /*argv*/[])
         throw std::runtime_error("IPv6 operands are not equal");
     }
     check_parse("2001:db8:0:1234:0:567:8:1", sample_ipv6);
+    check_parse("2001:DB8::1234:0:567:8:1", sample_ipv6);
+    check_parse("::", ipv6_addr());
+    check_parse("::1", ipv6_addr(0, 0, 0, 0, 0, 0, 0, 1));
+    check_parse("1::", ipv6_addr(1, 0, 0, 0, 0, 0, 0, 0));
+    check_parse("::ffff:192.0.2.1", ipv6_addr(0, 0, 0, 0, 0, 0xffff, 0xc000, 0x0201));
+    check_parse("1:2:3:4:5:6:255.255.255.255", ipv6_addr(1, 2, 3, 4, 5, 6, 0xffff, 0xffff));
+    check_parse("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", ipv6_addr(0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff));
+    check_fail<ipv6_addr>("");
+    check_fail<ipv6_addr>(":");
+    check_fail<ipv6_addr>(":::");
+    check_fail<ipv6_addr>(":1::");
+    check_fail<ipv6_addr>("1::2::3");
+    check_fail<ipv6_addr>("1:2:3:4:5:6:7");
+    check_fail<ipv6_addr>("1:2:3:4:5:6:7:8:");
+    check_fail<ipv6_addr>("1:2:3:4::5:6:7:8");
+    check_fail<ipv6_addr>("12345::");
+    check_fail<ipv6_addr>("::g");
+    check_fail<ipv6_addr>("::1.2.3");
+    check_fail<ipv6_addr>("1.2.3.4");
+    check_fail<ipv6_addr>("1:2:3:4:5:6:7:1.2.3.4");
+    {
+        // compare with system parser
+        const char alphabet[] = "0123456789abcdefABCDEF::::::....g";
+        std::uint32_t seed = 1;
+        for (std::size_t k = 0; k < 200'000; ++k) {
+            std::array<char, 48> str = {};
+            seed = seed * 1103515245 + 12345;
+            std::size_t len = 1 + (seed >> 16) % 46;
+            for (std::size_t j = 0; j < len; ++j) {
+                seed = seed * 1103515245 + 12345;
+                str[j] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+            }
+            std::array<std::uint8_t, 16> expected;
+            bool expected_valid = inet_pton(AF_INET6, str.data(), expected.data()) > 0;
+            ipv6_addr addr;
+            bool valid = addr.parse(std::string_view(str.data(), len));
+            if (valid != expected_valid || (valid && std::memcmp(addr.data(), expected.data(), 16) != 0)) {
+                throw std::runtime_error("IPv6 address parsing does not match inet_pton");
+            }
+        }
+
+        // mutate characters of valid addresses
+        const std::string_view samples[] = { "::ffff:192.0.2.1", "1:2:3:4:5:6:10.0.0.1", "::1.2.3.4", "2001:db8::1", "1:2:3:4:5:6:7:8", "fe80::1:2" };
+        for (std::size_t k = 0; k < 100'000; ++k) {
+            seed = seed * 1103515245 + 12345;
+            const std::string_view& sample = samples[(seed >> 16) % std::size(samples)];
+            std::array<char, 48> str = {};
+            std::memcpy(str.data(), sample.data(), sample.size());
+            seed = seed * 1103515245 + 12345;
+            str[(seed >> 16) % sample.size()] = alphabet[(seed >> 8) % (sizeof(alphabet) - 1)];
+            std::array<std::uint8_t, 16> expected;
+            bool expected_valid = inet_pton(AF_INET6, str.data(), expected.data()) > 0;
+            ipv6_addr addr;
+            bool valid = addr.parse(std::string_view(str.data(), sample.size()));
+            if (valid != expected_valid || (valid && std::memcmp(addr.data(), expected.data(), 16) != 0)) {
+                throw std::runtime_error("IPv6 address parsing does not match inet_pton");
+            }
+        }
+
+        // parse all compressed and uncompressed forms of addresses with zero groups
+        for (unsigned k = 0; k < 256; ++k) {
+            ipv6_addr expected(k & 1 ? 0 : 0x1234, k & 2 ? 0 : 5, k & 4 ? 0 : 0xab, k & 8 ? 0 : 0xffff, k & 16 ? 0 : 0xcd, k & 32 ? 0 : 0xffff, k & 64 ? 0 : 7, k & 128 ? 0 : 0x89);
+            for (std::size_t gap_start = 0; gap_start <= 8; ++gap_start) {
+                for (std::size_t gap_len = 0; gap_start + gap_len <= 8; ++gap_len) {
+                    if (gap_len == 1) {
+                        continue;
+                    }
+                    std::string str;
+                    bool zero_gap = true;
+                    for (std::size_t j = gap_start; j < gap_start + gap_len; ++j) {
+                        zero_gap = zero_gap && expected.data()[2 * j] == 0 && expected.data()[2 * j + 1] == 0;
+                    }
+                    if (!zero_gap) {
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        if (gap_len > 1 && j == gap_start) {
+                            str += j == 0 ? "::" : ":";
+                            j += gap_len - 1;
+                            continue;
+                        }
+                        char group[8];
+                        std::snprintf(group, sizeof(group), "%x", (expected.data()[2 * j] << 8) | expected.data()[2 * j + 1]);
+                        str += group;
+                        if (j < 7) {
+                            str += ":";
+                        }
+                    }
+                    std::array<std::uint8_t, 16> system;
+                    if (inet_pton(AF_INET6, str.c_str(), system.data()) <= 0 || std::memcmp(system.data(), expected.data(), 16) != 0) {
+                        throw std::runtime_error("invalid IPv6 test string");
+                    }
+                    check_parse(str, expected);
+                }
+            }
+        }
+    }
+
+    using simdparse::ipv4_network;
+    using simdparse::ipv6_network;
+    check_parse("192.0.2.0/24", ipv4_network(ipv4_addr(192, 0, 2, 0), 24));
+    check_parse("0.0.0.0/0", ipv4_network(ipv4_addr(), 0));
+    check_parse("192.0.2.1/32", ipv4_network(sample_ipv4, 32));
+    check_parse("2001:db8::/32", ipv6_network(ipv6_addr(0x2001, 0xdb8, 0, 0, 0, 0, 0, 0), 32));
+    check_parse("::/0", ipv6_network(ipv6_addr(), 0));
+    check_parse("2001:db8:0:1234:0:567:8:1/128", ipv6_network(sample_ipv6, 128));
+    check_fail<ipv4_network>("192.0.2.0");
+    check_fail<ipv4_network>("192.0.2.0/");
+    check_fail<ipv4_network>("192.0.2.0/33");
+    check_fail<ipv4_network>("192.0.2.0/024");
+    check_fail<ipv4_network>("192.0.2.1/24");
+    check_fail<ipv4_network>("192.0.2/24");
+    check_fail<ipv6_network>("2001:db8::/129");
+    check_fail<ipv6_network>("2001:db8::1/64");
+    check_fail<ipv6_network>("2001:db8::/x");
+    if (!ipv4_network(ipv4_addr(192, 0, 2, 0), 24).contains(sample_ipv4) || ipv4_network(ipv4_addr(192, 0, 3, 0), 24).contains(sample_ipv4)) {
+        throw std::runtime_error("IPv4 network membership");
+    }
+    if (!ipv6_network(ipv6_addr(0x2001, 0xdb8, 0, 0, 0, 0, 0, 0), 32).contains(sample_ipv6) || ipv6_network(ipv6_addr(0x2001, 0xdb9, 0, 0, 0, 0, 0, 0), 32).contains(sample_ipv6)) {
+        throw std::runtime_error("IPv6 network membership");
+    }
+    {
+        // compare longest prefix match with a linear scan over randomly generated nested networks
+        std::uint32_t seed = 7;
+        auto next_random = [&seed]() {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 8) & 0xffff;
+        };
+
+        std::vector<std::pair<ipv4_network, std::uint32_t>> ipv4_networks;
+        std::vector<std::pair<ipv6_network, std::uint32_t>> ipv6_networks;
+        for (std::uint32_t k = 0; k < 2000; ++k) {
+            const unsigned int length = next_random() % 33;
+            const std::uint32_t bits = ((next_random() & 0x3) << 30 | next_random() << 14 | next_random()) & ~(length >= 32 ? 0 : ~std::uint32_t(0) >> length);
+            ipv4_networks.emplace_back(ipv4_network(ipv4_addr(bits >> 24, (bits >> 16) & 0xff, (bits >> 8) & 0xff, bits & 0xff), length), k);
+
+            const unsigned int length6 = next_random() % 129;
+            std::array<std::uint16_t, 8> groups = { 0x2001, static_cast<std::uint16_t>(next_random() & 0x3), static_cast<std::uint16_t>(next_random()), 0, 0, 0, 0, static_cast<std::uint16_t>(next_random()) };
+            for (std::size_t j = 0; j < 8; ++j) {
+                const unsigned int group_length = length6 > 16 * j ? length6 - 16 * j : 0;
+                groups[j] &= group_length >= 16 ? 0xffff : static_cast<std::uint16_t>(~(0xffff >> group_length));
+            }
+            ipv6_networks.emplace_back(ipv6_network(ipv6_addr(groups[0], groups[1], groups[2], groups[3], groups[4], groups[5], groups[6], groups[7]), length6), k);
+        }
+        ipv4_networks.emplace_back(simdparse::parse<ipv4_network>(std::string_view("10.0.0.0/8")), 5000);
+        ipv4_networks.emplace_back(simdparse::parse<ipv4_network>(std::string_view("10.0.0.0/8")), 5001);
+        ipv4_networks.emplace_back(simdparse::parse<ipv4_network>(std::string_view("255.255.255.255/32")), 5002);
+        const simdparse::ipv4_prefix_index ipv4_index(ipv4_networks);
+        const simdparse::ipv6_prefix_index ipv6_index(ipv6_networks);
+
+        std::vector<ipv4_addr> ipv4_addrs;
+        std::vector<ipv6_addr> ipv6_addrs;
+        for (const auto& entry : ipv4_networks) {
+            ipv4_addrs.push_back(entry.first.address());
+        }
+        for (std::size_t k = 0; k < 3000; ++k) {
+            const std::uint32_t bits = (next_random() & 0x3) << 30 | next_random() << 14 | next_random();
+            ipv4_addrs.push_back(ipv4_addr(bits >> 24, (bits >> 16) & 0xff, (bits >> 8) & 0xff, bits & 0xff));
+            ipv6_addrs.push_back(ipv6_addr(0x2001, next_random() & 0x3, next_random(), 0, 0, 0, 0, next_random()));
+        }
+        for (const auto& entry : ipv6_networks) {
+            ipv6_addrs.push_back(entry.first.address());
+        }
+
+        auto linear_scan = [](const auto& networks, const auto& addr) {
+            std::uint32_t value = simdparse::ipv4_prefix_index::npos;
+            int best = -1;
+            for (const auto& entry : networks) {
+                if (entry.first.contains(addr) && static_cast<int>(entry.first.prefix_length()) >= best) {
+                    best = static_cast<int>(entry.first.prefix_length());
+                    value = entry.second;
+                }
+            }
+            return value;
+        };
+
+        std::vector<std::uint32_t> values(ipv4_addrs.size());
+        ipv4_index.lookup(ipv4_addrs.data(), ipv4_addrs.size(), values.data());
+        for (std::size_t k = 0; k < ipv4_addrs.size(); ++k) {
+            const std::uint32_t expected = linear_scan(ipv4_networks, ipv4_addrs[k]);
+            if (ipv4_index.lookup(ipv4_addrs[k]) != expected || values[k] != expected) {
+                throw std::runtime_error("IPv4 longest prefix match does not match linear scan");
+            }
+        }
+        values.resize(ipv6_addrs.size());
+        ipv6_index.lookup(ipv6_addrs.data(), ipv6_addrs.size(), values.data());
+        for (std::size_t k = 0; k < ipv6_addrs.size(); ++k) {
+            const std::uint32_t expected = linear_scan(ipv6_networks, ipv6_addrs[k]);
+            if (ipv6_index.lookup(ipv6_addrs[k]) != expected || values[k] != expected) {
+                throw std::runtime_error("IPv6 longest prefix match does not match linear scan");
+            }
+        }
+        if (simdparse::ipv4_prefix_index().lookup(sample_ipv4) != simdparse::ipv4_prefix_index::npos) {
+            throw std::runtime_error("empty prefix index");
+        }
+    }
 
     using simdparse::uuid;
     constexpr uuid sample_uuid({ 0xf8, 0x1d, 0x4f, 0xae, 0x7d, 0xec, 0x11, 0xd0, 0xa7, 0x65, 0x00, 0xa0, 0xc9, 0x1e, 0x6b, 0xf6 });
@@ -297,6 +876,21 @@ int main(int /*argc*/, char* /*argv*/[])
     check_parse("f81d4fae-7dec-11d0-a765-00a0c91e6bf6", sample_uuid);
     check_parse("F81D4FAE-7DEC-11D0-A765-00A0C91E6BF6", sample_uuid);
     check_parse("{f81d4fae-7dec-11d0-a765-00a0c91e6bf6}", sample_uuid);
+    check_fail<uuid>("f81d4fae_7dec-11d0-a765-00a0c91e6bf6");
+    check_fail<uuid>("f81d4fae-7dec-11d0-a765x00a0c91e6bf6");
+    check_fail<uuid>("{f81d4fae-7dec.11d0-a765-00a0c91e6bf6}");
+    check_fail<uuid>("(f81d4fae-7dec-11d0-a765-00a0c91e6bf6)");
+    check_fail<uuid>("{f81d4fae-7dec-11d0-a765-00a0c91e6bf6 ");
+    {
+        uuid compact;
+        uuid rfc_4122;
+        if (!compact.parse_uuid_compact("f81d4fae7dec11d0a76500a0c91e6bf6") || compact != sample_uuid) {
+            throw std::runtime_error("parse_uuid_compact");
+        }
+        if (!rfc_4122.parse_uuid_rfc_4122("f81d4fae-7dec-11d0-a765-00a0c91e6bf6") || rfc_4122 != sample_uuid) {
+            throw std::runtime_error("parse_uuid_rfc_4122");
+        }
+    }
     constexpr std::array<char, 32> zero_uuid_str = { '0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0','0' };
     for (std::size_t k = 0; k < zero_uuid_str.size(); ++k) {
         std::array<char, 32> invalid_uuid_str = zero_uuid_str;
@@ -315,6 +909,36 @@ int main(int /*argc*/, char* /*argv*/[])
         invalid_uuid_str[k] = '{';  // character after 'z'
         check_fail<uuid>(to_string_view(invalid_uuid_str));
     }
+    {
+        // version, variant and embedded timestamp (examples of RFC 9562, all at 2022-02-22 19:22:22 UTC-05:00)
+        using simdparse::uuid_variant;
+        const uuid v1 = simdparse::parse<uuid>(std::string_view("C232AB00-9414-11EC-B3C8-9F6BDECED846"));
+        const uuid v4 = simdparse::parse<uuid>(std::string_view("919108f7-52d1-4320-9bac-f847db4148a8"));
+        const uuid v6 = simdparse::parse<uuid>(std::string_view("1EC9414C-232A-6B00-B3C8-9F6BDECED846"));
+        const uuid v7 = simdparse::parse<uuid>(std::string_view("017F22E2-79B0-7CC3-98C4-DC0C0C07398F"));
+        if (v1.version() != 1 || v4.version() != 4 || v6.version() != 6 || v7.version() != 7 || v7.variant() != uuid_variant::rfc_9562) {
+            throw std::runtime_error("UUID version or variant mismatch");
+        }
+        if (sample_uuid.variant() != uuid_variant::rfc_9562 || uuid().variant() != uuid_variant::ncs || uuid(0, 0xc000000000000000).variant() != uuid_variant::microsoft || uuid(0, 0xe000000000000000).variant() != uuid_variant::future) {
+            throw std::runtime_error("UUID variant mismatch");
+        }
+        constexpr std::int64_t example_time = 1'645'557'742'000;
+        if (v1.timestamp() != example_time || v6.timestamp() != example_time || v7.timestamp() != example_time || v4.timestamp() != 0) {
+            throw std::runtime_error("UUID timestamp mismatch");
+        }
+        if (!(simdparse::parse<uuid>(std::string_view("017F22E2-79B0-7000-8000-000000000000")) < v7) || !(v7 < simdparse::parse<uuid>(std::string_view("017F22E2-79B1-7000-8000-000000000000")))) {
+            throw std::runtime_error("UUIDv7 values are not ordered by time");
+        }
+
+        // hash-based containers
+        std::unordered_set<uuid> keys = { v1, v4, v6, v7, sample_uuid };
+        if (keys.size() != 5 || keys.count(simdparse::parse<uuid>(std::string_view("919108f752d143209bacf847db4148a8"))) != 1 || keys.count(uuid()) != 0) {
+            throw std::runtime_error("UUID hash lookup mismatch");
+        }
+        if (std::hash<uuid>()(v1) == std::hash<uuid>()(v6) || uuid(0, 1).hash() == uuid(1, 0).hash()) {
+            throw std::runtime_error("UUID hash collision");
+        }
+    }
 
     using simdparse::decimal_integer;
     constexpr decimal_integer i1 = decimal_integer(56);
@@ -342,6 +966,75 @@ int main(int /*argc*/, char* /*argv*/[])
     check_fail<decimal_integer>("0xab");
     check_fail<decimal_integer>("ff");
 
+    using simdparse::signed_decimal;
+    static_assert(signed_decimal(-5) < signed_decimal(3) && signed_decimal(3) == signed_decimal(3));
+    check_parse("0", signed_decimal(0));
+    check_parse("-0", signed_decimal(0));
+    check_parse("12345", signed_decimal(12345));
+    check_parse("-12345", signed_decimal(-12345));
+    check_parse("-1234567812345678", signed_decimal(-1234567812345678ll));
+    check_parse("9223372036854775807", signed_decimal(std::numeric_limits<long long>::max()));
+    check_parse("-9223372036854775808", signed_decimal(std::numeric_limits<long long>::min()));
+    check_fail<signed_decimal>("");
+    check_fail<signed_decimal>("-");
+    check_fail<signed_decimal>("+1");
+    check_fail<signed_decimal>("--1");
+    check_fail<signed_decimal>("9223372036854775808");
+    check_fail<signed_decimal>("-9223372036854775809");
+    check_fail<signed_decimal>("12a");
+
+    using simdparse::fixed_decimal;
+    check_parse("-12345.6789", fixed_decimal<6>(-12'345'678'900));
+    check_parse("12345.6789", fixed_decimal<6>(12'345'678'900));
+    check_parse("0", fixed_decimal<6>(0));
+    check_parse("-0.000001", fixed_decimal<6>(-1));
+    check_parse(".5", fixed_decimal<6>(500'000));
+    check_parse("7.", fixed_decimal<6>(7'000'000));
+    check_parse("1.2500000000", fixed_decimal<6>(1'250'000));
+    check_parse("9223372036854.775807", fixed_decimal<6>(std::numeric_limits<std::int64_t>::max()));
+    check_parse("-9223372036854.775808", fixed_decimal<6>(std::numeric_limits<std::int64_t>::min()));
+    check_parse("42", fixed_decimal<0>(42));
+    check_parse("0.123456789012345678", fixed_decimal<18>(123'456'789'012'345'678));
+    check_fail<fixed_decimal<6>>("");
+    check_fail<fixed_decimal<6>>(".");
+    check_fail<fixed_decimal<6>>("-");
+    check_fail<fixed_decimal<6>>("1.0000001");
+    check_fail<fixed_decimal<6>>("9223372036854.775808");
+    check_fail<fixed_decimal<6>>("10000000000000");
+    check_fail<fixed_decimal<6>>("1.5e3");
+    check_fail<fixed_decimal<6>>("12345678901234567890");
+    check_fail<fixed_decimal<0>>("1.5");
+    if (to_string(fixed_decimal<6>(-12'345'678'900)) != "-12345.678900" || to_string(fixed_decimal<6>(5)) != "0.000005" || to_string(fixed_decimal<0>(-42)) != "-42") {
+        throw std::runtime_error("fixed-point decimal formatting mismatch");
+    }
+
+    using simdparse::floating_point;
+    check_parse("0", floating_point(0.0));
+    check_parse("-0.0", floating_point(-0.0));
+    check_parse("1", floating_point(1.0));
+    check_parse("-12345.6789", floating_point(-12345.6789));
+    check_parse("0.1", floating_point(0.1));
+    check_parse(".5", floating_point(0.5));
+    check_parse("3.14159265358979", floating_point(3.14159265358979));
+    check_parse("1e10", floating_point(1e10));
+    check_parse("6.02214076E+23", floating_point(6.02214076e23));
+    check_parse("1.7976931348623157e308", floating_point(1.7976931348623157e308));
+    check_parse("4.9406564584124654e-324", floating_point(4.9406564584124654e-324));
+    check_parse("2.2250738585072014e-308", floating_point(2.2250738585072014e-308));
+    check_parse("9007199254740993", floating_point(9007199254740992.0));
+    check_parse("123456789012345678901234567890", floating_point(1.2345678901234568e29));
+    check_parse("0.00000000000000000000000000000000001", floating_point(1e-35));
+    check_parse("inf", floating_point(std::numeric_limits<double>::infinity()));
+    check_fail<floating_point>("");
+    check_fail<floating_point>("-");
+    check_fail<floating_point>(".");
+    check_fail<floating_point>("1e");
+    check_fail<floating_point>("1e+");
+    check_fail<floating_point>("1.5x");
+    check_fail<floating_point>("1e400");
+    check_fail<floating_point>("1e-400");
+    check_fail<floating_point>("+1");
+
     using simdparse::hexadecimal_integer;
     constexpr hexadecimal_integer h1 = hexadecimal_integer(56);
     constexpr hexadecimal_integer h2 = hexadecimal_integer(84);
@@ -374,6 +1067,68 @@ int main(int /*argc*/, char* /*argv*/[])
     check_parse("0xfedcba9876543210", hexadecimal_integer(0xfedcba9876543210ull));
     check_parse("0xFEDCBA9876543210", hexadecimal_integer(0xfedcba9876543210ull));
     check_fail<hexadecimal_integer>("fedcba9876543210a");
+    for (std::uint64_t value : { std::uint64_t(0), std::uint64_t(0xa), std::uint64_t(0x123456789abcdef), ~std::uint64_t(0) }) {
+        const std::string str = to_string(hexadecimal_integer(value));
+        if (simdparse::parse<hexadecimal_integer>(str) != hexadecimal_integer(value)) {
+            throw std::runtime_error("hexadecimal integer round-trip mismatch: " + str);
+        }
+    }
+    if (to_string(hexadecimal_integer(0xfedcba9876543210ull)) != "fedcba9876543210") {
+        throw std::runtime_error("hexadecimal integer formatting mismatch");
+    }
+
+    using simdparse::uint128;
+    static_assert(uint128(0, 5) < uint128(1, 0) && uint128(1, 2) == uint128(1, 2) && uint128(1, 2) > uint128(1, 1));
+    check_parse("0", uint128(0, 0));
+    check_parse("fedcba9876543210", uint128(0, 0xfedcba9876543210ull));
+    check_parse("1fedcba9876543210", uint128(1, 0xfedcba9876543210ull));
+    check_parse("4bf92f3577b34da6a3ce929d0e0e4736", uint128(0x4bf92f3577b34da6ull, 0xa3ce929d0e0e4736ull));
+    check_parse("0x4BF92F3577B34DA6A3CE929D0E0E4736", uint128(0x4bf92f3577b34da6ull, 0xa3ce929d0e0e4736ull));
+    check_fail<uint128>("");
+    check_fail<uint128>("4bf92f3577b34da6a3ce929d0e0e47360");
+    check_fail<uint128>("4bf92f3577b34da6-3ce929d0e0e4736");
+    check_fail<uint128>("0xg");
+    if (to_string(uint128(0x4bf92f3577b34da6ull, 0x0e0e4736)) != "4bf92f3577b34da6000000000e0e4736" || to_string(uint128(0, 0xabc)) != "abc") {
+        throw std::runtime_error("128-bit integer formatting mismatch");
+    }
+
+    {
+        // decode and encode hexadecimal strings of any length
+        using simdparse::hex;
+        static_assert(hex::encoded_size(32) == 64 && hex::decoded_size(64) == 32);
+        const std::string_view digest = "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855";
+        std::array<std::byte, 32> bytes;
+        if (hex::decode(digest, bytes.data(), bytes.size()) != 32 || bytes[0] != std::byte{ 0xe3 } || bytes[31] != std::byte{ 0x55 }) {
+            throw std::runtime_error("hex decode into buffer");
+        }
+        std::array<char, 64> chars;
+        if (hex::encode(std::basic_string_view<std::byte>(bytes.data(), bytes.size()), chars.data(), chars.size()) != 64 || std::string_view(chars.data(), 64) != "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855") {
+            throw std::runtime_error("hex encode into buffer");
+        }
+        if (hex::decode(digest, bytes.data(), 31) != hex::npos || hex::decode("abc", bytes.data(), bytes.size()) != hex::npos || hex::encode(std::basic_string_view<std::byte>(bytes.data(), 4), chars.data(), 7) != hex::npos) {
+            throw std::runtime_error("expected: hex buffer size error");
+        }
+
+        std::basic_string<std::byte> payload;
+        for (std::size_t k = 0; k < 1000; ++k) {
+            payload.push_back(static_cast<std::byte>(k * 13 + k / 7));
+        }
+        for (std::size_t len : { 0, 1, 15, 16, 17, 31, 32, 33, 1000 }) {
+            const std::basic_string<std::byte> expected = payload.substr(0, len);
+            const std::string encoded = hex::encode(expected);
+            std::basic_string<std::byte> decoded;
+            if (encoded.size() != 2 * len || !hex::decode(encoded, decoded) || decoded != expected) {
+                throw std::runtime_error("hex encode and decode do not match");
+            }
+            for (std::size_t k = 0; k < encoded.size(); k += 7) {
+                std::string invalid = encoded;
+                invalid[k] = 'g';
+                if (hex::decode(invalid, decoded)) {
+                    throw std::runtime_error("expected: hex decode error for invalid character");
+                }
+            }
+        }
+    }
 
     using simdparse::month_to_ordinal;
     static_assert(month_to_ordinal('J', 'a', 'n') == 1);
@@ -406,6 +1161,746 @@ int main(int /*argc*/, char* /*argv*/[])
     static_assert(month_to_ordinal('a', 'b', 'c') == 0);
     static_assert(month_to_ordinal('x', 'y', 'z') == 0);
 
+    using simdparse::bitmask;
+    using simdparse::parse_many;
+    {
+        // batch parsing with strings of different lengths, and failures in between
+        std::vector<std::string_view> inputs = {
+            "1984-10-24 23:59:59.123Z",
+            "1984-10-24 23:59:59",
+            "1984-10-24 23:59:99",
+            "1984-10-24 23:59:59.123456+01:00",
+            "1984-10-24T23:59:59.456Z",
+            ""
+        };
+        std::vector<datetime> outputs;
+        bitmask valid;
+        check_equals(static_cast<unsigned int>(parse_many(inputs, outputs, valid)), 4u);
+        check_equals(static_cast<unsigned int>(valid.count()), 4u);
+        if (!valid.test(0) || !valid.test(1) || valid.test(2) || !valid.test(3) || !valid.test(4) || valid.test(5)) {
+            throw std::runtime_error("batch parsing produced wrong validity mask");
+        }
+        if (outputs[0] != datetime(1984, 10, 24, 23, 59, 59, 123000000) || outputs[4] != datetime(1984, 10, 24, 23, 59, 59, 456000000)) {
+            throw std::runtime_error("batch parsing produced wrong date-time value");
+        }
+        if (outputs[2] != datetime()) {
+            throw std::runtime_error("batch parsing did not reset invalid value");
+        }
+    }
+    {
+        // batch parsing across multiple blocks
+        std::vector<std::string> strings;
+        for (unsigned long long k = 0; k < 150; ++k) {
+            strings.push_back(k % 7 == 3 ? std::string("x") + std::to_string(k) : std::to_string(k * k * k * k * k));
+        }
+        std::vector<std::string_view> inputs(strings.begin(), strings.end());
+        std::vector<decimal_integer> outputs;
+        bitmask valid;
+        parse_many(inputs, outputs, valid);
+        for (unsigned long long k = 0; k < 150; ++k) {
+            if (valid.test(k) != (k % 7 != 3)) {
+                throw std::runtime_error("batch parsing produced wrong validity mask");
+            }
+            if (valid.test(k) && outputs[k] != decimal_integer(k * k * k * k * k)) {
+                throw std::runtime_error("batch parsing produced wrong integer value");
+            }
+        }
+    }
+
+    {
+        // batch parsing of UUID strings in several layouts, paired by the AVX-512 kernel
+        std::vector<std::string> strings;
+        for (unsigned int k = 0; k < 100; ++k) {
+            char buf[40];
+            std::snprintf(buf, sizeof(buf), "%08x-%04x-%04x-%04x-%08x%04x", k * 2654435761u, k, 0x7000 | k, 0x8000 | (k * 7), k * 40503u, k);
+            std::string str(buf);
+            switch (k % 9) {
+            case 1: str = "{" + str + "}"; break;
+            case 2: str.erase(std::remove(str.begin(), str.end(), '-'), str.end()); break;
+            case 4: str[k % 36 == 8 ? 9 : k % 36] = 'g'; break;
+            case 5: str[13] = '_'; break;
+            case 7: str.pop_back(); break;
+            default: break;
+            }
+            strings.push_back(str);
+        }
+        std::vector<std::string_view> inputs(strings.begin(), strings.end());
+        std::vector<uuid> outputs;
+        bitmask valid;
+        const std::size_t success = simdparse::parse_uuids(inputs, outputs, valid);
+        std::vector<uuid> expected;
+        bitmask expected_valid;
+        if (success != parse_many(inputs, expected, expected_valid) || success != 67) {
+            throw std::runtime_error("UUID batch parsing produced wrong count");
+        }
+        for (std::size_t k = 0; k < inputs.size(); ++k) {
+            if (valid.test(k) != expected_valid.test(k) || outputs[k] != expected[k]) {
+                throw std::runtime_error("UUID batch parsing does not match parsing one by one");
+            }
+        }
+    }
+
+    using simdparse::parse_microtime_column;
+    {
+        // column of date-time strings with a `Z` suffix and microsecond precision
+        std::vector<std::string> strs;
+        for (int k = 0; k < 21; ++k) {
+            std::array<char, 64> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ",
+                (k == 3 ? 1 : 1900 + 7 * k), 1 + k % 12, 1 + (3 * k) % 28, k % 24, (11 * k) % 60, (13 * k) % 60, 12345 * k);
+            strs.push_back(std::string(buf.data(), n));
+        }
+        strs[5][20] = 'x';  // invalid fractional digit
+        strs[9].back() = '7';  // no time zone designator, with 7 fractional digits
+        strs[14][10] = '_';  // invalid separator
+        std::string column;
+        const std::size_t stride = strs[0].size() + 1;
+        for (const std::string& str : strs) {
+            column += str;
+            column += std::string(stride - str.size(), ',');
+        }
+
+        std::vector<std::int64_t> values(strs.size());
+        bitmask valid;
+        std::size_t count = parse_microtime_column(column.data(), stride - 1, stride, strs.size(), values.data(), valid);
+        check_equals(static_cast<unsigned int>(count), static_cast<unsigned int>(strs.size() - 2));
+        for (std::size_t k = 0; k < strs.size(); ++k) {
+            microtime ref;
+            bool success = ref.parse(std::string_view(column.data() + k * stride, stride - 1));
+            if (success != valid.test(k) || (success && ref.value() != values[k])) {
+                throw std::runtime_error("timestamp column does not match individually parsed timestamp");
+            }
+        }
+    }
+    for (std::string_view str : { "1984-10-24 23:59:59", "1984-10-24T23:59:59.1+02:30", "1969-12-31 23:59:59.999 UTC", "1984-10-24 23:59:59.123456789" }) {
+        std::string column;
+        for (int k = 0; k < 17; ++k) {
+            column += str;
+        }
+        std::vector<std::int64_t> values(17);
+        bitmask valid;
+        parse_microtime_column(column.data(), str.size(), str.size(), 17, values.data(), valid);
+        if (!valid.all() || values[16] != simdparse::parse<microtime>(str).value() || values[0] != values[16]) {
+            throw std::runtime_error("timestamp column does not match individually parsed timestamp");
+        }
+    }
+
+    using simdparse::as_date_column;
+    using simdparse::as_datetime_column;
+    {
+        std::vector<std::int64_t> timestamps = {
+            0, 1, -1, 86'399'999'999, 86'400'000'000, -86'400'000'000, 951'782'400'000'000, 951'868'799'999'999,
+            microtime(1, 1, 1, 0, 0, 0).value(), microtime(9999, 12, 31, 23, 59, 59, 999'999).value(),
+            microtime(1600, 2, 29, 12, 0, 0).value(), microtime(1900, 3, 1, 0, 0, 0).value(),
+            microtime(1984, 10, 24, 23, 59, 40, 123'000).value(), microtime::UNSET,
+            std::numeric_limits<std::int64_t>::max(), microtime(-4000, 1, 1, 0, 0, 0).value(), 1'700'000'000'123'456
+        };
+        for (std::int64_t k = 0; k < 200; ++k) {
+            timestamps.push_back(k * 7'777'777'777'777 - 500'000'000'000'000'000);
+        }
+        std::vector<date> dates(timestamps.size());
+        std::vector<datetime> datetimes(timestamps.size());
+        as_date_column(timestamps.data(), timestamps.size(), dates.data());
+        as_datetime_column(timestamps.data(), timestamps.size(), datetimes.data());
+        for (std::size_t k = 0; k < timestamps.size(); ++k) {
+            microtime ts(timestamps[k]);
+            if (dates[k] != ts.as_date() || datetimes[k] != ts.as_datetime()) {
+                throw std::runtime_error("timestamp column conversion does not match individual conversion");
+            }
+            if (timestamps[k] >= 0 && timestamps[k] != std::numeric_limits<std::int64_t>::max() && microtime(ts.as_datetime().year, ts.as_datetime().month, ts.as_datetime().day, ts.as_datetime().hour, ts.as_datetime().minute, ts.as_datetime().second, ts.microseconds()) != ts) {
+                throw std::runtime_error("timestamp does not round-trip through date-time");
+            }
+        }
+    }
+
+    {
+        // columnar storage of date-time values, with range filters
+        std::vector<std::string> strings;
+        for (int k = 0; k < 150; ++k) {
+            std::array<char, 64> buf;
+            int n = std::snprintf(buf.data(), buf.size(), "%04d-%02d-%02dT%02d:%02d:%02d.%06d%s",
+                1950 + k % 70, 1 + k % 12, 1 + k % 28, k % 24, (7 * k) % 60, (13 * k) % 60, 4321 * k, k % 3 == 0 ? "Z" : k % 3 == 1 ? "+05:30" : "-01:00");
+            strings.push_back(std::string(buf.data(), n));
+        }
+        strings[17] = "1984-1x-24 23:59:59Z";
+        std::vector<std::string_view> inputs(strings.begin(), strings.end());
+
+        simdparse::datetime_column column;
+        std::size_t count = column.append(inputs.data(), 100);
+        count += column.append(inputs.data() + 100, 50);
+        check_equals(static_cast<unsigned int>(count), 149u);
+        check_equals(static_cast<unsigned int>(column.size()), 150u);
+        for (std::size_t k = 0; k < inputs.size(); ++k) {
+            datetime dt;
+            const bool success = dt.parse(inputs[k]);
+            if (success != column.valid().test(k) || (success && (column[k] != dt || column.time(k) != simdparse::parse<microtime>(inputs[k]) || column.offset(k) != dt.offset))) {
+                throw std::runtime_error("date-time column does not match individually parsed date-time");
+            }
+        }
+
+        const microtime lower(1980, 1, 1, 0, 0, 0);
+        const microtime upper(2000, 1, 1, 0, 0, 0);
+        const bitmask inside = column.between(lower, upper);
+        const bitmask earlier = column.before(lower);
+        const bitmask later = column.after(upper);
+        for (std::size_t k = 0; k < column.size(); ++k) {
+            const microtime ts = column.time(k);
+            const bool valid = column.valid().test(k);
+            if (inside.test(k) != (valid && lower <= ts && ts <= upper) || earlier.test(k) != (valid && ts < lower) || later.test(k) != (valid && ts > upper)) {
+                throw std::runtime_error("date-time column range filter mismatch");
+            }
+        }
+        if (inside.count() == 0 || earlier.count() == 0 || later.count() == 0 || inside.count() + earlier.count() + later.count() != 149) {
+            throw std::runtime_error("date-time column range filter mismatch");
+        }
+    }
+    {
+        // columnar storage of UUIDs and IPv6 addresses, with equality and network filters
+        std::vector<std::string> uuid_strings;
+        std::vector<std::string> addr_strings;
+        for (unsigned int k = 0; k < 75; ++k) {
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%08x-%04x-4000-8000-%012x", k % 5, k % 3, k);
+            uuid_strings.push_back(k == 40 ? std::string("invalid") : std::string(buf));
+            std::snprintf(buf, sizeof(buf), "2001:db8:%x::%x", k % 4, k);
+            addr_strings.push_back(k == 41 ? std::string("2001:db8::g") : std::string(buf));
+        }
+        std::vector<std::string_view> uuid_inputs(uuid_strings.begin(), uuid_strings.end());
+        std::vector<std::string_view> addr_inputs(addr_strings.begin(), addr_strings.end());
+
+        simdparse::uuid_column uuids;
+        check_equals(static_cast<unsigned int>(uuids.append(uuid_inputs)), 74u);
+        const uuid key = uuids[12];
+        const bitmask uuid_matches = uuids.equal(key);
+        if (uuid_matches.count() != 1 || !uuid_matches.test(12) || uuids.equal(uuid()).count() != 0 || uuids[40] != uuid()) {
+            throw std::runtime_error("UUID column equality filter mismatch");
+        }
+
+        simdparse::ipv6_column addrs;
+        check_equals(static_cast<unsigned int>(addrs.append(addr_inputs)), 74u);
+        const bitmask in_network = addrs.in_network(simdparse::parse<simdparse::ipv6_network>(std::string_view("2001:db8:2::/48")));
+        const bitmask in_wide_network = addrs.in_network(simdparse::parse<simdparse::ipv6_network>(std::string_view("2001:db8::/46")));
+        for (unsigned int k = 0; k < 75; ++k) {
+            if (in_network.test(k) != (k != 41 && k % 4 == 2) || in_wide_network.test(k) != (k != 41)) {
+                throw std::runtime_error("IPv6 column network filter mismatch");
+            }
+        }
+        if (addrs.equal(addrs[7]).count() != 1 || !addrs.equal(addrs[7]).test(7)) {
+            throw std::runtime_error("IPv6 column equality filter mismatch");
+        }
+
+        // dispatched filter kernels select the same values as the fallback
+        auto same_bits = [](const bitmask& a, const bitmask& b) {
+            return a.size() == b.size() && std::equal(a.data(), a.data() + a.words(), b.data());
+        };
+        simdparse::cpu_features& features = simdparse::dispatch_features();
+        const simdparse::cpu_features detected = features;
+        features = simdparse::cpu_features();
+        const bool same = same_bits(uuids.equal(key), uuid_matches) && same_bits(addrs.in_network(simdparse::parse<simdparse::ipv6_network>(std::string_view("2001:db8:2::/48"))), in_network);
+        features = detected;
+        if (!same) {
+            throw std::runtime_error("column filter fallback mismatch");
+        }
+    }
+
+    using simdparse::packed_datetime;
+    {
+        // packed date-time values convert losslessly, and order like `datetime`
+        std::vector<std::string_view> inputs = {
+            "1984-10-24 23:59:59.123Z", "1984-10-24 23:59:59.123456789+01:00", "1984-10-24 23:59:59.123456789-01:00",
+            "1984-10-24 23:59:59", "1984-10-24T23:59:59.1 UTC", "0000-01-01 00:00:00.000000001", "9999-12-31 23:59:59.999999999Z",
+            "1984-10-24 23:59:59.12345678", "1984-10-24 23:59:58.999999999+14:00", "1984-10-24 23:59:59-12:00", "2000-02-29T12:30:00.5Z"
+        };
+        std::vector<datetime> values;
+        std::vector<packed_datetime> packed;
+        for (std::string_view str : inputs) {
+            datetime dt;
+            packed_datetime p;
+            if (!dt.parse(str) || !p.parse(str) || p != packed_datetime(dt) || p.as_datetime() != dt) {
+                throw std::runtime_error("packed date-time does not match parsed date-time");
+            }
+            values.push_back(dt);
+            packed.push_back(p);
+        }
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            for (std::size_t j = 0; j < values.size(); ++j) {
+                if ((values[i] < values[j]) != (packed[i] < packed[j]) || (values[i] == values[j]) != (packed[i] == packed[j])) {
+                    throw std::runtime_error("packed date-time ordering mismatch");
+                }
+            }
+        }
+        for (std::string_view str : { "1984-10-24 23:59:59.12x", "1984-10-24 23:59:59.123+01:0x", "1984-10-24_23:59:59.123Z", "1984-10-24 23:59:59.1234567890Z", "" }) {
+            check_fail<packed_datetime>(str);
+        }
+        static_assert(packed_datetime(datetime(1984, 10, 24, 23, 59, 59, 123'456'789, tzoffset(tzoffset::west, 5, 30))).as_datetime() == datetime(1984, 10, 24, 23, 59, 59, 123'456'789, tzoffset(tzoffset::west, 5, 30)));
+        static_assert(packed_datetime(datetime(1984, 10, 24, 23, 59, 59)) < packed_datetime(datetime(1984, 10, 24, 23, 59, 59, 1)));
+        static_assert(packed_datetime() == packed_datetime(datetime()));
+        std::unordered_set<packed_datetime> keys(packed.begin(), packed.end());
+        if (keys.size() != packed.size() || keys.count(packed_datetime(datetime())) != 0) {
+            throw std::runtime_error("packed date-time hash lookup mismatch");
+        }
+    }
+
+    using simdparse::parse_errc;
+    using simdparse::parse_result;
+    using simdparse::try_parse;
+    {
+        // reason and position of the first error
+        auto check_error = [](parse_result result, parse_errc ec, std::size_t position) {
+            if (result.ec != ec || result.position != position) {
+                throw std::runtime_error(std::string("wrong error location: ") + std::string(result.message()) + " at " + std::to_string(result.position) + "; expected: " + std::string(parse_result{ ec, position }.message()) + " at " + std::to_string(position));
+            }
+        };
+
+        datetime dt;
+        check_error(try_parse(dt, "1984-10-24 23:59:59.123+01:00"), parse_errc::success, 0);
+        check_error(try_parse(dt, "1984-1x-24 23:59:59Z"), parse_errc::invalid_character, 6);
+        check_error(try_parse(dt, "1984-10-24_23:59:59Z"), parse_errc::invalid_character, 10);
+        check_error(try_parse(dt, "1984-10-24 30:59:59Z"), parse_errc::out_of_range, 11);
+        check_error(try_parse(dt, "1984-10-24 23:59"), parse_errc::invalid_length, 16);
+        check_error(try_parse(dt, "1984-10-24 23:59:59.1234567890"), parse_errc::invalid_length, 29);
+        check_error(try_parse(dt, "1984-10-24 23:59:59.123+01:3x"), parse_errc::invalid_character, 28);
+        check_error(try_parse(dt, "1984-10-24 23:59:59.123+01:60"), parse_errc::out_of_range, 27);
+        check_error(try_parse(dt, "1984-10-24 23:59:59 UTX"), parse_errc::invalid_character, 22);
+        check_error(try_parse(dt, "1984-10-24 23:59:59Zx"), parse_errc::invalid_character, 20);
+        check_error(try_parse(dt, "1984-10-24 23:59:59#"), parse_errc::invalid_character, 19);
+
+        date d;
+        check_error(try_parse(d, "1984-10-2"), parse_errc::invalid_length, 9);
+        check_error(try_parse(d, "1984/10/24"), parse_errc::invalid_character, 4);
+        packed_datetime pdt;
+        check_error(try_parse(pdt, "1984-10-24 23:59:59.12x"), parse_errc::invalid_character, 22);
+        microtime ts;
+        check_error(try_parse(ts, "1984-10-24T23:5x:59Z"), parse_errc::invalid_character, 15);
+
+        decimal_integer n;
+        check_error(try_parse(n, "12345"), parse_errc::success, 0);
+        check_error(try_parse(n, ""), parse_errc::invalid_length, 0);
+        check_error(try_parse(n, "123x5"), parse_errc::invalid_character, 3);
+        check_error(try_parse(n, "99999999999999999999"), parse_errc::out_of_range, 0);
+        simdparse::hexadecimal_integer h;
+        check_error(try_parse(h, "0x12g4"), parse_errc::invalid_character, 4);
+        check_error(try_parse(h, "0x12345678901234567"), parse_errc::invalid_length, 18);
+
+        uuid u;
+        check_error(try_parse(u, "f81d4fae-7dec-11d0-a765-00a0c91e6bf6"), parse_errc::success, 0);
+        check_error(try_parse(u, "f81d4fae-7dec-11d0-a765-00a0c91e6bfx"), parse_errc::invalid_character, 35);
+        check_error(try_parse(u, "{f81d4fae-7dec-11d0_a765-00a0c91e6bf6}"), parse_errc::invalid_character, 19);
+        check_error(try_parse(u, "(f81d4fae-7dec-11d0-a765-00a0c91e6bf6}"), parse_errc::invalid_character, 0);
+        check_error(try_parse(u, "{f81d4fae-7dec-11d0-a765-00a0c91e6bf6)"), parse_errc::invalid_character, 37);
+        check_error(try_parse(u, "f81d4fae7dec11d0a76500a0c91e6bf"), parse_errc::invalid_length, 31);
+        ipv4_addr addr;
+        check_error(try_parse(addr, "192.0.2"), parse_errc::invalid_format, 0);
+
+        std::string encoded(1100, 'A');
+        encoded[1031] = '*';
+        check_error(simdparse::base64::validate(encoded), parse_errc::invalid_character, 1031);
+        check_error(simdparse::base64::validate("QUJD"), parse_errc::success, 0);
+        check_error(simdparse::base64::validate("QUI="), parse_errc::success, 0);
+        check_error(simdparse::base64::validate("QU=I"), parse_errc::invalid_character, 2);
+        check_error(simdparse::base64::validate("QUJDR"), parse_errc::invalid_length, 5);
+        check_error(simdparse::base64url::validate("QUJD_-x"), parse_errc::success, 0);
+        check_error(simdparse::base64url::validate("QUJD+"), parse_errc::invalid_character, 4);
+        check_error(simdparse::base64url::validate("QUJDR"), parse_errc::invalid_length, 5);
+    }
+
+    {
+        // records of a fixed shape, parsed into a tuple or into the members of a structure
+        using simdparse::nullable;
+        using parser_type = simdparse::record_parser<decimal_integer, nullable<datetime>, uuid, std::basic_string<std::byte>>;
+        static_assert(parser_type::column_names[0] == decimal_integer::name && parser_type::column_names[1] == datetime::name && parser_type::column_names[3] == simdparse::base64url::name);
+
+        parser_type parser;
+        parser_type::record_type record;
+        std::vector<std::string_view> fields = { "42", "1984-10-24 23:59:59Z", "f81d4fae-7dec-11d0-a765-00a0c91e6bf6", "QUJD" };
+        if (!parser.parse(fields, record) || parser.nulls() != 0 || parser.first_error() != parser_type::column_count) {
+            throw std::runtime_error("record parser failed on a valid record");
+        }
+        if (std::get<0>(record) != decimal_integer(42) || std::get<1>(record) != datetime(1984, 10, 24, 23, 59, 59) || std::get<2>(record) != sample_uuid || std::get<3>(record).size() != 3) {
+            throw std::runtime_error("record parser produced wrong values");
+        }
+
+        struct row
+        {
+            decimal_integer id;
+            datetime time;
+            uuid key;
+            std::basic_string<std::byte> payload;
+        };
+        row r;
+        fields[1] = "";
+        if (!parser.parse(fields, std::tie(r.id, r.time, r.key, r.payload)) || parser.nulls() != 0b0010 || r.id != decimal_integer(42) || r.key != sample_uuid) {
+            throw std::runtime_error("record parser failed on a record with a null field");
+        }
+
+        fields[0] = "";
+        fields[2] = "f81d4fae";
+        if (parser.parse(fields, record) || parser.valid() != 0b1010 || parser.first_error() != 0) {
+            throw std::runtime_error("record parser accepted an invalid record");
+        }
+        if (parser.parse(fields.data(), 2, record) || parser.valid() != 0b1010 || parser.nulls() != 0b0010) {
+            throw std::runtime_error("record parser mishandled missing fields");
+        }
+    }
+
+    using simdparse::to_chars;
+    using simdparse::to_string;
+    {
+        // years have at least four digits and a sign if negative, as with `%.4d`
+        if (to_string(simdparse::date(1984, 1, 2)) != "1984-01-02" || to_string(simdparse::date(-12, 3, 4)) != "-0012-03-04" || to_string(simdparse::date(12345, 6, 7)) != "12345-06-07") {
+            throw std::runtime_error("date formatting");
+        }
+        if (to_string(datetime(-12345, 1, 2, 3, 4, 5, 6)) != "-12345-01-02 03:04:05.000000006Z") {
+            throw std::runtime_error("date-time formatting with five-digit year");
+        }
+        if (to_string(datetime(1984, 1, 2, 3, 4, 5, 123'456'789)) != "1984-01-02 03:04:05.123456789Z") {
+            throw std::runtime_error("date-time formatting");
+        }
+        if (to_string(datetime(2024, 12, 31, 23, 59, 59, 7, tzoffset(tzoffset::west, 5, 30))) != "2024-12-31 23:59:59.000000007-05:30") {
+            throw std::runtime_error("date-time formatting with time zone offset");
+        }
+        // an unset timestamp formats as an empty string
+        if (to_string(microtime(1984, 10, 24, 23, 59, 40, 123'000)) != "1984-10-24 23:59:40.123000Z" || !to_string(microtime()).empty()) {
+            throw std::runtime_error("timestamp formatting");
+        }
+        if (to_string(uuid(0xf81d4fae7dec11d0ull, 0xa76500a0c91e6bf6ull)) != "f81d4fae-7dec-11d0-a765-00a0c91e6bf6") {
+            throw std::runtime_error("UUID formatting");
+        }
+        if (to_string(ipv4_addr(192, 0, 2, 1)) != "192.0.2.1" || to_string(ipv4_addr(10, 100, 0, 255)) != "10.100.0.255") {
+            throw std::runtime_error("IPv4 address formatting");
+        }
+
+        std::array<char, 64> buf;
+        for (std::uint64_t value : { 0ull, 1ull, 0xabcull, 0x8000'0000'0000'0000ull, 0xffff'ffff'ffff'ffffull, 0x0123'4567'89ab'cdefull }) {
+            std::array<char, 32> expected;
+            std::to_chars_result expected_result = std::to_chars(expected.data(), expected.data() + expected.size(), value, 16);
+            std::to_chars_result result = to_chars(buf.data(), buf.data() + buf.size(), simdparse::hexadecimal_integer(value));
+            if (result.ec != std::errc{} || std::string_view(buf.data(), result.ptr - buf.data()) != std::string_view(expected.data(), expected_result.ptr - expected.data())) {
+                throw std::runtime_error("hexadecimal formatting");
+            }
+        }
+        if (to_chars(buf.data(), buf.data() + 35, uuid()).ec != std::errc::value_too_large) {
+            throw std::runtime_error("formatting into a buffer that is too small");
+        }
+
+        // dispatched formatters write the same characters as the fallback
+        auto format_all = []() {
+            return to_string(datetime(1984, 10, 24, 23, 59, 59, 123'456'789)) + ' ' + to_string(simdparse::date(-12, 3, 4)) + ' '
+                + to_string(simdparse::hexadecimal_integer(0x0123'4567'89ab'cdefull)) + ' ' + to_string(uuid(0xf81d4fae7dec11d0ull, 0xa76500a0c91e6bf6ull));
+        };
+        simdparse::cpu_features& features = simdparse::dispatch_features();
+        const simdparse::cpu_features detected = features;
+        const std::string selected = format_all();
+        features = simdparse::cpu_features();
+        const std::string fallback = format_all();
+        features = detected;
+        if (selected != fallback) {
+            throw std::runtime_error("dispatched formatters disagree with fallback");
+        }
+
+        const std::array<ipv4_addr, 3> addrs = { ipv4_addr(1, 2, 3, 4), ipv4_addr(), ipv4_addr(255, 255, 255, 255) };
+        std::to_chars_result result = to_chars(buf.data(), buf.data() + buf.size(), addrs.data(), addrs.size(), ',');
+        if (result.ec != std::errc{} || std::string_view(buf.data(), result.ptr - buf.data()) != "1.2.3.4,0.0.0.0,255.255.255.255") {
+            throw std::runtime_error("sequence formatting");
+        }
+
+        // compare with system formatter
+        std::vector<ipv6_addr> ipv6_addrs = {
+            sample_ipv6, ipv6_addr(), ipv6_addr(0, 0, 0, 0, 0, 0, 0, 1), ipv6_addr(0, 0, 0, 0, 0, 0xffff, 0xc000, 0x0201),
+            ipv6_addr(0, 0, 0, 0, 0, 0, 0xc000, 0x0201), ipv6_addr(0x2001, 0xdb8, 0, 0, 1, 0, 0, 1), ipv6_addr(0x2001, 0, 0, 1, 0, 0, 0, 0),
+            ipv6_addr(1, 0, 1, 0, 1, 0, 1, 0), ipv6_addr(0xfe80, 0, 0, 0, 0, 0, 0, 0), ipv6_addr(0, 0, 0, 0, 0, 0, 1, 0)
+        };
+        for (unsigned k = 0; k < 256; ++k) {
+            ipv6_addrs.push_back(ipv6_addr(k & 1 ? 0 : 0x1234, k & 2 ? 0 : 5, k & 4 ? 0 : 0xab, k & 8 ? 0 : 0xffff, k & 16 ? 0 : 0xcd, k & 32 ? 0 : 0xffff, k & 64 ? 0 : 7, k & 128 ? 0 : 0x89));
+        }
+        for (const ipv6_addr& addr : ipv6_addrs) {
+            char addr_str[INET6_ADDRSTRLEN];
+            inet_ntop(AF_INET6, addr.data(), addr_str, sizeof(addr_str));
+            if (to_string(addr) != addr_str) {
+                throw std::runtime_error("IPv6 address formatting does not match inet_ntop");
+            }
+        }
+    }
+
+    {
+        // kernels selected at run time agree with the fallback path
+        using namespace simdparse;
+        auto parse_all = []() {
+            std::string out;
+            auto append = [&out](auto obj, const std::string_view& str) {
+                // padding with valid digits exposes kernels that read past the end of the string
+                const std::string buf = std::string(str) + std::string(padded_string_view::padding, '9');
+                auto padded_obj = obj;
+                const bool padded_result = padded_obj.parse(padded_string_view(buf.data(), str.size()));
+                const bool result = obj.parse(str);
+                if (padded_result != result || (result && padded_obj != obj)) {
+                    throw std::runtime_error("padded input parsed differently");
+                }
+                out += result ? to_string(obj) : std::string("!");
+                out += '\n';
+            };
+            for (std::string_view str : {
+                "", "0", "1984", "12345678", "1234567890123456789", "12a4", "-1", "12345678901234567890", "18446744073709551615",
+                "18446744073709551616", "99999999999999999999", "100000000000000000000", "000000000000000000000001", "1234567890123456789x" }) {
+                append(decimal_integer(), str);
+            }
+            for (std::string_view str : { "0", "0xff", "DEADbeef", "0123456789abcdef", "12g4", "0x" }) {
+                append(hexadecimal_integer(), str);
+            }
+            for (std::string_view str : { "1984-10-24", "2000-02-29", "1984-1a-24", "1984-10-2" }) {
+                append(date(), str);
+            }
+            for (std::string_view str : { "1984-10-24T23:59:59Z", "1984-10-24 23:59:59.123456+01:30", "1984-10-24T23:59:59.123456789Z", "1984-10-24T23:59:5xZ", "1984-10-24T23:59:59.12a456Z", "1984-10-24 23:59:59.1", "1984-10-24 23:59:59.123456789" }) {
+                append(datetime(), str);
+            }
+            for (std::string_view str : { "f81d4fae-7dec-11d0-a765-00a0c91e6bf6", "{F81D4FAE-7DEC-11D0-A765-00A0C91E6BF6}", "f81d4fae7dec11d0a76500a0c91e6bf6", "f81d4fae-7dec-11d0-a765-00a0c91e6bfx" }) {
+                append(uuid(), str);
+            }
+            const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+            for (std::string str : { "Zm9vYmFy" + alphabet, "Zm9vYmFy" + alphabet + alphabet + alphabet, "Zm9vYmFy" + alphabet + "+/" + alphabet, alphabet + "\xc1" + alphabet + alphabet.substr(0, 63) }) {
+                std::basic_string<std::byte> bytes;
+                std::string chars;
+                if (base64url::decode(str, bytes)) {
+                    base64url::encode(bytes, chars);
+                    out += chars;
+                }
+                out += '\n';
+                std::replace(str.begin(), str.end(), '-', '+');
+                std::replace(str.begin(), str.end(), '_', '/');
+                if (base64::decode(str.substr(0, str.size() / 4 * 4), bytes)) {
+                    out += base64::encode(bytes);
+                }
+                out += '\n';
+            }
+            const std::string csv =
+                "id,time,uuid,addr,data\n"
+                "1,1984-10-24 23:59:59Z,f81d4fae-7dec-11d0-a765-00a0c91e6bf6,192.168.0.1,Zm9vYmFy\r\n"
+                "\n"
+                "\"22\",\"1984-10-24T23:59:59.123456+01:00\",{F81D4FAE-7DEC-11D0-A765-00A0C91E6BF6},10.0.0.1,\"" + alphabet + alphabet + "\"\n"
+                "\"3,0\",\"a\"\"b\",f81d4fae7dec11d0a76500a0c91e6bf6,300.0.0.1,\n"
+                "4,1984-10-24 23:59:59Z\n"
+                "5,1984-10-24 23:59:59Z,f81d4fae7dec11d0a76500a0c91e6bf6,0.0.0.0,,extra,\"extra\"\n"
+                "\"6\"x,\"unterminated";
+            field_scanner<decimal_integer, datetime, uuid, ipv4_addr, std::basic_string<std::byte>> scanner(csv);
+            field_scanner<decimal_integer, datetime, uuid, ipv4_addr, std::basic_string<std::byte>>::record_type record;
+            scanner.skip();
+            while (scanner.next(record)) {
+                const std::uint64_t valid = scanner.valid();
+                out += std::to_string(valid) + ' ' + std::to_string(scanner.field_count()) + ' ';
+                out += (valid & 1) ? to_string(std::get<0>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 2) ? to_string(std::get<1>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 4) ? to_string(std::get<2>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 8) ? to_string(std::get<3>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 16) ? std::to_string(std::get<4>(record).size()) : std::string("!");
+                out += '\n';
+            }
+            return out;
+        };
+
+        cpu_features& features = dispatch_features();
+        const cpu_features detected = features;
+        const std::string selected = parse_all();
+        features.avx512bw = false;
+        const std::string without_avx512 = parse_all();
+        features = cpu_features();
+        const std::string fallback = parse_all();
+        features = detected;
+        if (selected != fallback || without_avx512 != fallback) {
+            throw std::runtime_error("dispatched kernels disagree with fallback");
+        }
+        if (decimal_integer().parse("18446744073709551616") || decimal_integer().parse("99999999999999999999")) {
+            throw std::runtime_error("expected: decimal integer out of range");
+        }
+    }
+
+    {
+        // fields are parsed in the same pass as delimiters are located
+        using namespace simdparse;
+        const std::string csv = "1,\"1984-10-24 23:59:59Z\",10.0.0.1\r\n\n\"2,0\",x\n3,1984-10-24 23:59:59.5Z,10.0.0.1,extra";
+        const std::string buf = csv + std::string(padded_string_view::padding, ',');
+        for (bool padded : { false, true }) {
+            field_scanner<decimal_integer, datetime, ipv4_addr> scanner = padded
+                ? field_scanner<decimal_integer, datetime, ipv4_addr>(padded_string_view(buf.data(), csv.size()))
+                : field_scanner<decimal_integer, datetime, ipv4_addr>(csv);
+            field_scanner<decimal_integer, datetime, ipv4_addr>::record_type record;
+            if (!scanner.next(record) || !scanner.complete() || std::get<0>(record).value != 1 || std::get<1>(record) != datetime(1984, 10, 24, 23, 59, 59, 0) || to_string(std::get<2>(record)) != "10.0.0.1") {
+                throw std::runtime_error("expected: complete record");
+            }
+            if (!scanner.next(record) || scanner.valid() != 0 || scanner.field_count() != 2) {
+                throw std::runtime_error("expected: record with invalid fields");
+            }
+            if (!scanner.next(record) || scanner.valid() != 7 || scanner.field_count() != 4 || scanner.complete() || std::get<1>(record).nanosecond != 500'000'000) {
+                throw std::runtime_error("expected: record with extra fields");
+            }
+            if (scanner.next(record) || scanner.position() != csv.size()) {
+                throw std::runtime_error("expected: end of buffer");
+            }
+        }
+    }
+
+    {
+        // fields that straddle fragments are parsed as if the stream had been received at once
+        using namespace simdparse;
+        using parser_type = stream_parser<decimal_integer, datetime, uuid, std::basic_string<std::byte>>;
+        const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        const std::string csv =
+            "1,1984-10-24 23:59:59.123456Z,f81d4fae-7dec-11d0-a765-00a0c91e6bf6,Zm9vYmFy\r\n"
+            "\n"
+            "2,1984-10-24T23:59:59+01:00,{F81D4FAE-7DEC-11D0-A765-00A0C91E6BF6},\n"
+            "x,1984-10-24,f81d4fae7dec11d0a76500a0c91e6bf6\n"
+            "4,1984-10-24 23:59:59Z,f81d4fae7dec11d0a76500a0c91e6bf6,Zm9v,extra\n"
+            "5,1984-10-24 23:59:59Z,f81d4fae7dec11d0a76500a0c91e6bf6,Zm9vYmFy";
+
+        auto parse_fragments = [&](const std::vector<std::string_view>& fragments) {
+            parser_type parser;
+            std::string out;
+            auto append = [&](const parser_type::record_type& record) {
+                const std::uint64_t valid = parser.valid();
+                out += std::to_string(valid) + ' ' + std::to_string(parser.field_count()) + ' ';
+                out += (valid & 1) ? to_string(std::get<0>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 2) ? to_string(std::get<1>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 4) ? to_string(std::get<2>(record)) : std::string("!");
+                out += ' ';
+                out += (valid & 8) ? std::to_string(std::get<3>(record).size()) : std::string("!");
+                out += '\n';
+            };
+            for (const std::string_view& fragment : fragments) {
+                // each fragment is copied to a buffer that is overwritten before the next fragment arrives
+                std::string packet(fragment);
+                parser.feed(packet, append);
+                packet.assign(packet.size(), '?');
+            }
+            parser.finish(append);
+            return out;
+        };
+
+        const std::string whole = parse_fragments({ csv });
+        if (whole != std::string(
+            "15 4 1 1984-10-24 23:59:59.123456000Z f81d4fae-7dec-11d0-a765-00a0c91e6bf6 6\n"
+            "15 4 2 1984-10-24 23:59:59.000000000+01:00 f81d4fae-7dec-11d0-a765-00a0c91e6bf6 0\n"
+            "4 3 ! ! f81d4fae-7dec-11d0-a765-00a0c91e6bf6 !\n"
+            "15 5 4 1984-10-24 23:59:59.000000000Z f81d4fae-7dec-11d0-a765-00a0c91e6bf6 3\n"
+            "15 4 5 1984-10-24 23:59:59.000000000Z f81d4fae-7dec-11d0-a765-00a0c91e6bf6 6\n"
+        )) {
+            throw std::runtime_error("expected: records parsed from a single fragment");
+        }
+        for (std::size_t k = 0; k <= csv.size(); ++k) {
+            if (parse_fragments({ std::string_view(csv).substr(0, k), std::string_view(csv).substr(k) }) != whole) {
+                throw std::runtime_error("expected: same records when split at offset " + std::to_string(k));
+            }
+        }
+        std::vector<std::string_view> bytes;
+        for (std::size_t k = 0; k < csv.size(); ++k) {
+            bytes.push_back(std::string_view(csv).substr(k, 1));
+        }
+        if (parse_fragments(bytes) != whole) {
+            throw std::runtime_error("expected: same records when fed one byte at a time");
+        }
+
+        // fields longer than the carry-over buffer are parsed only if they lie within a single fragment
+        const std::string long_record = "6,1984-10-24 23:59:59Z,f81d4fae7dec11d0a76500a0c91e6bf6," + alphabet + alphabet + "\n";
+        if (parse_fragments({ long_record }).substr(0, 3) != "15 ") {
+            throw std::runtime_error("expected: long field within a fragment");
+        }
+        const std::size_t split = long_record.size() - 10;
+        if (parse_fragments({ std::string_view(long_record).substr(0, split), std::string_view(long_record).substr(split) }).substr(0, 2) != "7 ") {
+            throw std::runtime_error("expected: long field that straddles fragments to fail");
+        }
+    }
+
+#if defined(SIMDPARSE_STATS)
+    {
+        // counters are aggregated across threads, including threads that have exited
+        using namespace simdparse;
+        const stats_snapshot before = collect_stats();
+        std::thread worker([]() {
+            datetime dt;
+            if (!dt.parse("1984-10-24 23:59:59.123Z") || !dt.parse("1984-10-24 23:59:59+01:00") || dt.parse("1984-10-24 23:59:5x")) {
+                throw std::runtime_error("unexpected datetime parse result");
+            }
+        });
+        worker.join();
+        decimal_integer n;
+        if (!n.parse("123") || n.parse("")) {
+            throw std::runtime_error("unexpected decimal parse result");
+        }
+        epoch_time t;
+        if (!t.parse(std::string_view("1700000000.5")) || t.parse(std::string_view("1700000000x"))) {
+            throw std::runtime_error("unexpected epoch timestamp parse result");
+        }
+        fixed_decimal<2> price;
+        floating_point ratio;
+        if (!price.parse("19.99") || price.parse("19.999") || !ratio.parse("0.25") || !ratio.parse("nan") || ratio.parse("0.25x")) {
+            throw std::runtime_error("unexpected fixed-point or floating-point parse result");
+        }
+        std::basic_string<std::byte> digest;
+        if (!hex::decode(std::string_view("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), digest) || hex::decode(std::string_view("e3b0c442x"), digest)) {
+            throw std::runtime_error("unexpected hex decode result");
+        }
+        const stats_snapshot delta = collect_stats() - before;
+        if (delta[stat_counter::datetime_calls] != 3 || delta[stat_counter::datetime_failures] != 1 || delta[stat_counter::datetime_zulu] != 1 || delta[stat_counter::datetime_offset] != 1 || delta[stat_counter::datetime_naive] != 1 || delta[stat_counter::datetime_fractional] != 1) {
+            throw std::runtime_error("datetime counter mismatch");
+        }
+        if (delta[stat_counter::decimal_calls] != 2 || delta[stat_counter::decimal_failures] != 1 || stat_name(stat_counter::datetime_zulu) != "datetime_zulu") {
+            throw std::runtime_error("decimal counter mismatch");
+        }
+        if (delta[stat_counter::epoch_calls] != 2 || delta[stat_counter::epoch_failures] != 1 || delta[stat_counter::epoch_simd] + delta[stat_counter::epoch_scalar] != 2) {
+            throw std::runtime_error("epoch counter mismatch");
+        }
+        if (delta[stat_counter::fixed_decimal_calls] != 2 || delta[stat_counter::fixed_decimal_failures] != 1 || delta[stat_counter::floating_point_calls] != 3 || delta[stat_counter::floating_point_failures] != 1 || delta[stat_counter::floating_point_fallback] != 1) {
+            throw std::runtime_error("fixed-point and floating-point counter mismatch");
+        }
+        if (delta[stat_counter::hex_decode_calls] != 2 || delta[stat_counter::hex_decode_failures] != 1 || delta[stat_counter::hex_blocks32] + delta[stat_counter::hex_scalar] / 32 != 2) {
+            throw std::runtime_error("hex counter mismatch");
+        }
+    }
+#endif
+
+    {
+        // records of a memory-mapped file are parsed by several threads, and merged in file order
+        using namespace simdparse;
+        const char* path = "simdparse-ingest-test.csv";
+        std::string csv = "id,time\n";
+        for (unsigned int k = 0; k < 20'000; ++k) {
+            csv += std::to_string(k) + (k % 1000 == 999 ? ",invalid\n" : ",1984-10-24 23:59:59.123456Z\n");
+        }
+        if (FILE* file = std::fopen(path, "wb")) {
+            std::fwrite(csv.data(), 1, csv.size(), file);
+            std::fclose(file);
+        } else {
+            throw std::runtime_error("cannot create file");
+        }
+
+        record_columns<decimal_integer, datetime> columns;
+        {
+            const mapped_file file(path);
+            if (file.view() != csv) {
+                throw std::runtime_error("mapped file content mismatch");
+            }
+            if (split_lines(file.view(), 8).back().back() != '\n') {
+                throw std::runtime_error("expected: newline-aligned chunks");
+            }
+            columns = parse_parallel<decimal_integer, datetime>(file.view(), 4, true);
+        }
+        std::remove(path);
+
+        if (columns.size() != 20'000) {
+            throw std::runtime_error("expected: one entry per record");
+        }
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            const bool valid_time = k % 1000 != 999;
+            if (std::get<0>(columns.columns)[k].value != k || columns.valid[k] != (valid_time ? 3u : 1u)) {
+                throw std::runtime_error("parallel parse result mismatch");
+            }
+        }
+    }
+
     // test code examples
     if (!example1() || !example2()) {
         return 1;